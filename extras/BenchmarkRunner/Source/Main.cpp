@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class ConsoleLogger : public Logger
+{
+    void logMessage (const String& message) override
+    {
+        std::cout << message << std::endl;
+
+       #if JUCE_WINDOWS
+        Logger::outputDebugString (message);
+       #endif
+    }
+};
+
+//==============================================================================
+static std::unique_ptr<FileOutputStream> openOutputFile (const ArgumentList& args, StringRef option)
+{
+    if (! args.containsOption (option))
+        return {};
+
+    const auto file = args.getFileForOption (option);
+    auto out = std::make_unique<FileOutputStream> (file);
+
+    if (out->failedToOpen())
+        ConsoleApplication::fail ("Couldn't open " + file.getFullPathName());
+
+    return out;
+}
+
+static void writeResults (FileOutputStream* out, std::function<void (OutputStream&)> writer)
+{
+    if (out == nullptr)
+        return;
+
+    out->setPosition (0);
+    out->truncate();
+    writer (*out);
+    out->flush();
+
+    if (out->getStatus().failed())
+        ConsoleApplication::fail ("Couldn't write " + out->getFile().getFullPathName()
+                                    + ": " + out->getStatus().getErrorMessage());
+}
+
+//==============================================================================
+int main (int argc, char **argv)
+{
+    ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category=category] [--samples=numSamples]"
+                                " [--warmup=seconds] [--min-sample-time=seconds] [--json=file] [--csv=file]" << std::endl;
+        return 0;
+    }
+
+    if (args.containsOption ("--list-categories"))
+    {
+        for (auto& category : Benchmark::getAllCategories())
+            std::cout << category << std::endl;
+
+        return  0;
+    }
+
+    // some benchmarks use singletons and other objects that need the message
+    // manager, and have to be deleted before the app exits
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    return ConsoleApplication::invokeCatchingFailures ([&args]
+    {
+        // open the output files before spending a long time running the benchmarks
+        const auto jsonOutput = openOutputFile (args, "--json");
+        const auto csvOutput  = openOutputFile (args, "--csv");
+
+        const auto category = args.containsOption ("--category") ? args.getValueForOption ("--category") : String();
+
+        if (category.isNotEmpty() && ! Benchmark::getAllCategories().contains (category))
+            ConsoleApplication::fail ("Unknown category: " + category + " (use --list-categories to see the available ones)");
+
+        ConsoleLogger logger;
+        Logger::setCurrentLogger (&logger);
+
+        BenchmarkRunner runner;
+
+        if (args.containsOption ("--samples"))
+            runner.setNumSamples (jmax (1, args.getValueForOption ("--samples").getIntValue()));
+
+        if (args.containsOption ("--warmup"))
+            runner.setWarmupTime (jmax (0.0, args.getValueForOption ("--warmup").getDoubleValue()));
+
+        if (args.containsOption ("--min-sample-time"))
+            runner.setMinimumSampleTime (jmax (0.0, args.getValueForOption ("--min-sample-time").getDoubleValue()));
+
+        if (category.isNotEmpty())
+            runner.runBenchmarksInCategory (category);
+        else
+            runner.runAllBenchmarks();
+
+        Logger::setCurrentLogger (nullptr);
+
+        writeResults (jsonOutput.get(), [&] (OutputStream& out) { runner.writeResultsAsJSON (out); });
+        writeResults (csvOutput.get(),  [&] (OutputStream& out) { runner.writeResultsAsCSV (out); });
+
+        return 0;
+    });
+}
@@ -23,6 +23,474 @@
 namespace juce
 {
 
+namespace AudioDataConversionHelpers
+{
+    // These do the same as the generic AudioData::Pointer conversions, one sample at a
+    // time, and are used for the samples that don't fill a whole vector
+    template <typename SampleFormat, typename Endianness>
+    static void convertToFloat (const void* source, float* dest, int numSamples) noexcept
+    {
+        AudioData::Pointer<SampleFormat, Endianness, AudioData::NonInterleaved, AudioData::Const> s (source);
+
+        for (int i = 0; i < numSamples; ++i, ++s)
+            dest[i] = s.getAsFloat();
+    }
+
+    template <typename SampleFormat, typename Endianness>
+    static void convertFromFloat (const float* source, void* dest, int numSamples) noexcept
+    {
+        AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const> s (source);
+        AudioData::Pointer<SampleFormat, Endianness, AudioData::NonInterleaved, AudioData::NonConst> d (dest);
+
+        for (int i = 0; i < numSamples; ++i, ++s, ++d)
+        {
+            if (d.isFloatingPoint())
+                d.setAsFloat (s.getAsFloat());
+            else
+                d.setAsInt32 (s.getAsInt32());
+        }
+    }
+
+   #if JUCE_USE_SSE_INTRINSICS
+    static forcedinline __m128i byteSwap16 (__m128i v) noexcept
+    {
+        return _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+    }
+
+    static forcedinline __m128i byteSwap32 (__m128i v) noexcept
+    {
+        v = byteSwap16 (v);
+        return _mm_or_si128 (_mm_slli_epi32 (v, 16), _mm_srli_epi32 (v, 16));
+    }
+
+    // Matches Float32::getAsInt32(), which clips and scales in double precision
+    static forcedinline __m128i clipAndScaleToInt32 (__m128 v) noexcept
+    {
+        const auto one = _mm_set1_pd (1.0), minusOne = _mm_set1_pd (-1.0), scale = _mm_set1_pd ((double) 0x7fffffff);
+
+        auto lo = _mm_mul_pd (_mm_min_pd (_mm_max_pd (_mm_cvtps_pd (v), minusOne), one), scale);
+        auto hi = _mm_mul_pd (_mm_min_pd (_mm_max_pd (_mm_cvtps_pd (_mm_movehl_ps (v, v)), minusOne), one), scale);
+
+        return _mm_unpacklo_epi64 (_mm_cvtpd_epi32 (lo), _mm_cvtpd_epi32 (hi));
+    }
+
+    template <bool bigEndian>
+    static int int16ToFloat (const void* source, float* dest, int numSamples) noexcept
+    {
+        const auto scale = _mm_set1_ps (1.0f / 0x8000);
+        auto* src = static_cast<const int16*> (source);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            auto v = _mm_loadu_si128 ((const __m128i*) (src + i));
+
+            if (bigEndian)
+                v = byteSwap16 (v);
+
+            _mm_storeu_ps (dest + i,     _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpacklo_epi16 (v, v), 16)), scale));
+            _mm_storeu_ps (dest + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpackhi_epi16 (v, v), 16)), scale));
+        }
+
+        return i;
+    }
+
+    template <bool bigEndian>
+    static int int24ToFloat (const void* source, float* dest, int numSamples) noexcept
+    {
+        const auto scale = _mm_set1_ps (1.0f / 0x800000);
+        auto* src = static_cast<const char*> (source);
+        int i = 0;
+
+        // Each sample is read as a 32-bit word, so this stops before the last one to avoid
+        // reading past the end of the data
+        for (; i + 5 <= numSamples; i += 4)
+        {
+            auto* s = src + 3 * i;
+            auto v = _mm_set_epi32 ((int) readUnaligned<uint32> (s + 9), (int) readUnaligned<uint32> (s + 6),
+                                    (int) readUnaligned<uint32> (s + 3), (int) readUnaligned<uint32> (s));
+
+            // move each sample's three bytes to the top of its word, then sign-extend it
+            v = bigEndian ? byteSwap32 (v) : _mm_slli_epi32 (v, 8);
+
+            _mm_storeu_ps (dest + i, _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (v, 8)), scale));
+        }
+
+        return i;
+    }
+
+    template <bool bigEndian>
+    static int int32ToFloat (const void* source, float* dest, int numSamples) noexcept
+    {
+        const auto scale = _mm_set1_ps (1.0f / 2147483648.0f);
+        auto* src = static_cast<const int32*> (source);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            auto v = _mm_loadu_si128 ((const __m128i*) (src + i));
+
+            if (bigEndian)
+                v = byteSwap32 (v);
+
+            _mm_storeu_ps (dest + i, _mm_mul_ps (_mm_cvtepi32_ps (v), scale));
+        }
+
+        return i;
+    }
+
+    static int swapFloats (const void* source, void* dest, int numSamples) noexcept
+    {
+        auto* src = static_cast<const uint32*> (source);
+        auto* dst = static_cast<uint32*> (dest);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            _mm_storeu_si128 ((__m128i*) (dst + i), byteSwap32 (_mm_loadu_si128 ((const __m128i*) (src + i))));
+
+        return i;
+    }
+
+    template <bool bigEndian>
+    static int floatToInt16 (const float* source, void* dest, int numSamples) noexcept
+    {
+        auto* dst = static_cast<int16*> (dest);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            auto lo = _mm_srai_epi32 (clipAndScaleToInt32 (_mm_loadu_ps (source + i)), 16);
+            auto hi = _mm_srai_epi32 (clipAndScaleToInt32 (_mm_loadu_ps (source + i + 4)), 16);
+            auto v = _mm_packs_epi32 (lo, hi);
+
+            if (bigEndian)
+                v = byteSwap16 (v);
+
+            _mm_storeu_si128 ((__m128i*) (dst + i), v);
+        }
+
+        return i;
+    }
+
+    template <bool bigEndian>
+    static int floatToInt24 (const float* source, void* dest, int numSamples) noexcept
+    {
+        auto* dst = static_cast<char*> (dest);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            alignas (16) int32 values[4];
+            _mm_store_si128 ((__m128i*) values, _mm_srai_epi32 (clipAndScaleToInt32 (_mm_loadu_ps (source + i)), 8));
+
+            for (int j = 0; j < 4; ++j)
+            {
+                if (bigEndian)
+                    ByteOrder::bigEndian24BitToChars (values[j], dst + 3 * (i + j));
+                else
+                    ByteOrder::littleEndian24BitToChars (values[j], dst + 3 * (i + j));
+            }
+        }
+
+        return i;
+    }
+
+    template <bool bigEndian>
+    static int floatToInt32 (const float* source, void* dest, int numSamples) noexcept
+    {
+        auto* dst = static_cast<int32*> (dest);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            auto v = clipAndScaleToInt32 (_mm_loadu_ps (source + i));
+
+            if (bigEndian)
+                v = byteSwap32 (v);
+
+            _mm_storeu_si128 ((__m128i*) (dst + i), v);
+        }
+
+        return i;
+    }
+   #else
+    // Without a vectorised kernel, everything is done by the scalar code
+    template <bool> static int int16ToFloat  (const void*, float*, int) noexcept   { return 0; }
+    template <bool> static int int24ToFloat  (const void*, float*, int) noexcept   { return 0; }
+    template <bool> static int int32ToFloat  (const void*, float*, int) noexcept   { return 0; }
+    template <bool> static int floatToInt16  (const float*, void*, int) noexcept   { return 0; }
+    template <bool> static int floatToInt24  (const float*, void*, int) noexcept   { return 0; }
+    template <bool> static int floatToInt32  (const float*, void*, int) noexcept   { return 0; }
+    static int swapFloats (const void*, void*, int) noexcept                       { return 0; }
+   #endif
+
+    //==============================================================================
+    enum { maxChannelsForKernels = 64, conversionBlockSize = 1024 };
+
+    // Channels with a null source are filled with zeros
+    static void interleaveFloats (const float* const* source, int numChannels, float* dest, int numSamples) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        if (numChannels == 2 && source[0] != nullptr && source[1] != nullptr)
+        {
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                auto left  = _mm_loadu_ps (source[0] + i);
+                auto right = _mm_loadu_ps (source[1] + i);
+                _mm_storeu_ps (dest + 2 * i,     _mm_unpacklo_ps (left, right));
+                _mm_storeu_ps (dest + 2 * i + 4, _mm_unpackhi_ps (left, right));
+            }
+
+            for (; i < numSamples; ++i)
+            {
+                dest[2 * i]     = source[0][i];
+                dest[2 * i + 1] = source[1][i];
+            }
+
+            return;
+        }
+       #endif
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (auto* src = source[ch])
+                for (int i = 0; i < numSamples; ++i)
+                    dest[i * numChannels + ch] = src[i];
+            else
+                for (int i = 0; i < numSamples; ++i)
+                    dest[i * numChannels + ch] = 0;
+        }
+    }
+
+    // Channels with a null destination are skipped
+    static void deinterleaveFloats (const float* source, int numChannels, float* const* dest, int numSamples) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        if (numChannels == 2 && dest[0] != nullptr && dest[1] != nullptr)
+        {
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                auto a = _mm_loadu_ps (source + 2 * i);
+                auto b = _mm_loadu_ps (source + 2 * i + 4);
+                _mm_storeu_ps (dest[0] + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)));
+                _mm_storeu_ps (dest[1] + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1)));
+            }
+
+            for (; i < numSamples; ++i)
+            {
+                dest[0][i] = source[2 * i];
+                dest[1][i] = source[2 * i + 1];
+            }
+
+            return;
+        }
+       #endif
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            if (auto* dst = dest[ch])
+                for (int i = 0; i < numSamples; ++i)
+                    dst[i] = source[i * numChannels + ch];
+    }
+
+    template <typename SampleFormat, typename Endianness, typename Kernel>
+    static void convertToFloat (Kernel kernel, const void* source, float* dest, int numSamples) noexcept
+    {
+        auto numDone = kernel (source, dest, numSamples);
+        convertToFloat<SampleFormat, Endianness> (addBytesToPointer (source, numDone * SampleFormat::bytesPerSample),
+                                                  dest + numDone, numSamples - numDone);
+    }
+
+    template <typename SampleFormat, typename Endianness, typename Kernel>
+    static void convertFromFloat (Kernel kernel, const float* source, void* dest, int numSamples) noexcept
+    {
+        auto numDone = kernel (source, dest, numSamples);
+        convertFromFloat<SampleFormat, Endianness> (source + numDone,
+                                                    addBytesToPointer (dest, numDone * SampleFormat::bytesPerSample),
+                                                    numSamples - numDone);
+    }
+}
+
+void AudioData::convertToNativeFloat (FastFormat sourceFormat, const void* source, float* dest, int numSamples) noexcept
+{
+    using namespace AudioDataConversionHelpers;
+
+    switch (sourceFormat)
+    {
+        case FastFormat::int16LE:   convertToFloat<Int16, LittleEndian> (int16ToFloat<false>, source, dest, numSamples); break;
+        case FastFormat::int16BE:   convertToFloat<Int16, BigEndian>    (int16ToFloat<true>,  source, dest, numSamples); break;
+        case FastFormat::int24LE:   convertToFloat<Int24, LittleEndian> (int24ToFloat<false>, source, dest, numSamples); break;
+        case FastFormat::int24BE:   convertToFloat<Int24, BigEndian>    (int24ToFloat<true>,  source, dest, numSamples); break;
+        case FastFormat::int32LE:   convertToFloat<Int32, LittleEndian> (int32ToFloat<false>, source, dest, numSamples); break;
+        case FastFormat::int32BE:   convertToFloat<Int32, BigEndian>    (int32ToFloat<true>,  source, dest, numSamples); break;
+
+       #if JUCE_BIG_ENDIAN
+        case FastFormat::float32LE: convertToFloat<Float32, LittleEndian> (swapFloats, source, dest, numSamples); break;
+        case FastFormat::float32BE: memmove (dest, source, sizeof (float) * (size_t) numSamples); break;
+       #else
+        case FastFormat::float32LE: memmove (dest, source, sizeof (float) * (size_t) numSamples); break;
+        case FastFormat::float32BE: convertToFloat<Float32, BigEndian> (swapFloats, source, dest, numSamples); break;
+       #endif
+
+        case FastFormat::none:
+        default:                    jassertfalse; break;
+    }
+}
+
+void AudioData::convertFromNativeFloat (FastFormat destFormat, const float* source, void* dest, int numSamples) noexcept
+{
+    using namespace AudioDataConversionHelpers;
+
+    switch (destFormat)
+    {
+        case FastFormat::int16LE:   convertFromFloat<Int16, LittleEndian> (floatToInt16<false>, source, dest, numSamples); break;
+        case FastFormat::int16BE:   convertFromFloat<Int16, BigEndian>    (floatToInt16<true>,  source, dest, numSamples); break;
+        case FastFormat::int24LE:   convertFromFloat<Int24, LittleEndian> (floatToInt24<false>, source, dest, numSamples); break;
+        case FastFormat::int24BE:   convertFromFloat<Int24, BigEndian>    (floatToInt24<true>,  source, dest, numSamples); break;
+        case FastFormat::int32LE:   convertFromFloat<Int32, LittleEndian> (floatToInt32<false>, source, dest, numSamples); break;
+        case FastFormat::int32BE:   convertFromFloat<Int32, BigEndian>    (floatToInt32<true>,  source, dest, numSamples); break;
+
+       #if JUCE_BIG_ENDIAN
+        case FastFormat::float32LE: convertFromFloat<Float32, LittleEndian> (swapFloats, source, dest, numSamples); break;
+        case FastFormat::float32BE: memmove (dest, source, sizeof (float) * (size_t) numSamples); break;
+       #else
+        case FastFormat::float32LE: memmove (dest, source, sizeof (float) * (size_t) numSamples); break;
+        case FastFormat::float32BE: convertFromFloat<Float32, BigEndian> (swapFloats, source, dest, numSamples); break;
+       #endif
+
+        case FastFormat::none:
+        default:                    jassertfalse; break;
+    }
+}
+
+int AudioData::getBytesPerSample (FastFormat format) noexcept
+{
+    switch (format)
+    {
+        case FastFormat::int16LE:
+        case FastFormat::int16BE:    return 2;
+        case FastFormat::int24LE:
+        case FastFormat::int24BE:    return 3;
+        case FastFormat::int32LE:
+        case FastFormat::int32BE:
+        case FastFormat::float32LE:
+        case FastFormat::float32BE:  return 4;
+        case FastFormat::none:
+        default:                     break;
+    }
+
+    jassertfalse;
+    return 0;
+}
+
+// Interleaving and deinterleaving is done in blocks, converting between the packed samples
+// and a buffer of floats, and then shuffling the floats to or from the other side
+bool AudioData::interleaveWithKernels (FastFormat sourceFormat, const void* const* source, int numSourceChannels,
+                                       FastFormat destFormat, void* dest, int numDestChannels, int numSamples) noexcept
+{
+    using namespace AudioDataConversionHelpers;
+
+    if (numDestChannels <= 0 || numDestChannels > maxChannelsForKernels)
+        return false;
+
+    // (the generic code treats null source channels differently, so leave those to it)
+    for (int ch = 0; ch < jmin (numSourceChannels, numDestChannels); ++ch)
+        if (source[ch] == nullptr)
+            return false;
+
+    const auto sourceBytes = getBytesPerSample (sourceFormat);
+    const auto destBytes = getBytesPerSample (destFormat);
+    const auto blockSize = (int) conversionBlockSize / numDestChannels;
+
+    float buffer[conversionBlockSize];
+    const float* channels[maxChannelsForKernels];
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        auto num = jmin (blockSize, numSamples - start);
+        auto* destBlock = addBytesToPointer (dest, start * numDestChannels * destBytes);
+
+        if (sourceFormat == nativeFloatFormat)
+        {
+            for (int ch = 0; ch < numDestChannels; ++ch)
+                channels[ch] = ch < numSourceChannels ? static_cast<const float*> (source[ch]) + start : nullptr;
+
+            interleaveFloats (channels, numDestChannels, buffer, num);
+            convertFromNativeFloat (destFormat, buffer, destBlock, num * numDestChannels);
+        }
+        else
+        {
+            for (int ch = 0; ch < numDestChannels; ++ch)
+            {
+                channels[ch] = nullptr;
+
+                if (ch < numSourceChannels)
+                {
+                    convertToNativeFloat (sourceFormat, addBytesToPointer (source[ch], start * sourceBytes), buffer + ch * num, num);
+                    channels[ch] = buffer + ch * num;
+                }
+            }
+
+            interleaveFloats (channels, numDestChannels, static_cast<float*> (destBlock), num);
+        }
+    }
+
+    return true;
+}
+
+bool AudioData::deinterleaveWithKernels (FastFormat sourceFormat, const void* source, int numSourceChannels,
+                                         FastFormat destFormat, void* const* dest, int numDestChannels, int numSamples) noexcept
+{
+    using namespace AudioDataConversionHelpers;
+
+    if (numSourceChannels <= 0 || numSourceChannels > maxChannelsForKernels)
+        return false;
+
+    const auto sourceBytes = getBytesPerSample (sourceFormat);
+    const auto destBytes = getBytesPerSample (destFormat);
+    const auto blockSize = (int) conversionBlockSize / numSourceChannels;
+
+    float buffer[conversionBlockSize], planar[conversionBlockSize];
+    float* channels[maxChannelsForKernels];
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        auto num = jmin (blockSize, numSamples - start);
+        auto* sourceBlock = addBytesToPointer (source, start * numSourceChannels * sourceBytes);
+
+        if (destFormat == nativeFloatFormat)
+        {
+            convertToNativeFloat (sourceFormat, sourceBlock, buffer, num * numSourceChannels);
+
+            for (int ch = 0; ch < numSourceChannels; ++ch)
+                channels[ch] = ch < numDestChannels && dest[ch] != nullptr ? static_cast<float*> (dest[ch]) + start : nullptr;
+
+            deinterleaveFloats (buffer, numSourceChannels, channels, num);
+        }
+        else
+        {
+            for (int ch = 0; ch < numSourceChannels; ++ch)
+                channels[ch] = ch < numDestChannels && dest[ch] != nullptr ? planar + ch * num : nullptr;
+
+            deinterleaveFloats (static_cast<const float*> (sourceBlock), numSourceChannels, channels, num);
+
+            for (int ch = 0; ch < numSourceChannels; ++ch)
+                if (channels[ch] != nullptr)
+                    convertFromNativeFloat (destFormat, channels[ch], addBytesToPointer (dest[ch], start * destBytes), num);
+        }
+
+        for (int ch = numSourceChannels; ch < numDestChannels; ++ch)
+            if (dest[ch] != nullptr)
+                zeromem (addBytesToPointer (dest[ch], start * destBytes), (size_t) (num * destBytes));
+    }
+
+    return true;
+}
+
+//==============================================================================
 JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
 JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
 
@@ -555,6 +1023,112 @@ public:
         }
     };
 
+    // Checks that the optimised conversions to and from native floats give exactly the same
+    // results as converting one sample at a time
+    template <class FormatType, class Endianness>
+    struct KernelTest
+    {
+        using FloatPointer  = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+        using PackedPointer = AudioData::Pointer<FormatType, Endianness, AudioData::NonInterleaved, AudioData::NonConst>;
+        using PackedElement = std::remove_pointer_t<decltype (FormatType::data)>;
+
+        static void test (UnitTest& unitTest, Random& r)
+        {
+            const int numChannels = 3, numSamples = 1031;
+            const auto numBytes = (size_t) (numSamples * PackedPointer::getBytesPerSample());
+
+            HeapBlock<float> floats (numChannels * numSamples), result ((numChannels + 1) * numSamples);
+            HeapBlock<char> packed (numChannels * numBytes), expected (numChannels * numBytes);
+
+            for (int i = 0; i < numChannels * numSamples; ++i)
+                floats[i] = r.nextFloat() * 2.2f - 1.1f;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                FloatPointer s (floats + ch * numSamples);
+                PackedPointer d (expected + (size_t) ch * numBytes);
+
+                for (int i = 0; i < numSamples; ++i, ++s, ++d)
+                {
+                    if (d.isFloatingPoint())
+                        d.setAsFloat (s.getAsFloat());
+                    else
+                        d.setAsInt32 (s.getAsInt32());
+                }
+            }
+
+            PackedPointer (packed).convertSamples (FloatPointer (floats), numSamples);
+            unitTest.expect (memcmp (packed, expected, numBytes) == 0);
+
+            FloatPointer (result).convertSamples (PackedPointer (packed), numSamples);
+            unitTest.expect (matchesPacked (result, packed, numSamples));
+
+            // narrowing conversions can also be done in-place
+            memcpy (result, floats, sizeof (float) * (size_t) numSamples);
+            PackedPointer (result).convertSamples (FloatPointer (result), numSamples);
+            unitTest.expect (memcmp (result, expected, numBytes) == 0);
+
+            using PackedFormat = AudioData::Format<FormatType, Endianness>;
+            using FloatFormat  = AudioData::Format<AudioData::Float32, AudioData::NativeEndian>;
+
+            // interleaving and deinterleaving, with one more channel at the destination
+            // than the source, which should be cleared
+            const float* floatChannels[] = { floats, floats + numSamples, floats + 2 * numSamples };
+            HeapBlock<char> interleaved ((numChannels + 1) * numBytes);
+
+            AudioData::interleaveSamples (AudioData::NonInterleavedSource<FloatFormat> { floatChannels, numChannels },
+                                          AudioData::InterleavedDest<PackedFormat>     { reinterpret_cast<PackedElement*> (interleaved.get()), numChannels + 1 },
+                                          numSamples);
+
+            PackedElement* packedChannels[numChannels + 1];
+
+            for (int ch = 0; ch <= numChannels; ++ch)
+                packedChannels[ch] = reinterpret_cast<PackedElement*> (packed + (size_t) ch * numBytes);
+
+            AudioData::deinterleaveSamples (AudioData::InterleavedSource<PackedFormat>  { reinterpret_cast<const PackedElement*> (interleaved.get()), numChannels + 1 },
+                                            AudioData::NonInterleavedDest<PackedFormat> { packedChannels, numChannels },
+                                            numSamples);
+
+            unitTest.expect (memcmp (packed, expected, numChannels * numBytes) == 0);
+
+            const PackedElement* constPackedChannels[] = { packedChannels[0], packedChannels[1], packedChannels[2] };
+            AudioData::interleaveSamples (AudioData::NonInterleavedSource<PackedFormat> { constPackedChannels, numChannels },
+                                          AudioData::InterleavedDest<FloatFormat>       { result.get(), numChannels + 1 },
+                                          numSamples);
+
+            floats.realloc ((numChannels + 1) * numSamples);
+            float* floatDestChannels[numChannels + 1];
+
+            for (int ch = 0; ch <= numChannels; ++ch)
+                floatDestChannels[ch] = floats + ch * numSamples;
+
+            AudioData::deinterleaveSamples (AudioData::InterleavedSource<FloatFormat>  { result.get(), numChannels + 1 },
+                                            AudioData::NonInterleavedDest<FloatFormat> { floatDestChannels, numChannels + 1 },
+                                            numSamples);
+
+            bool matches = true;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                matches = matches && matchesPacked (floats + ch * numSamples, expected + (size_t) ch * numBytes, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                matches = matches && floats[numChannels * numSamples + i] == 0.0f;
+
+            unitTest.expect (matches);
+        }
+
+        static bool matchesPacked (const float* values, const void* packedData, int numSamples)
+        {
+            AudioData::Pointer<FormatType, Endianness, AudioData::NonInterleaved, AudioData::Const> s (packedData);
+
+            for (int i = 0; i < numSamples; ++i, ++s)
+                if (values[i] != s.getAsFloat())
+                    return false;
+
+            return true;
+        }
+    };
+
     template <class FormatType>
     struct Test1
     {
@@ -579,6 +1153,16 @@ public:
         beginTest ("Round-trip conversion: Float32");
         Test1 <AudioData::Float32>::test (*this, r);
 
+        beginTest ("Optimised conversions match sample-by-sample conversions");
+        KernelTest<AudioData::Int16,   AudioData::LittleEndian>::test (*this, r);
+        KernelTest<AudioData::Int16,   AudioData::BigEndian>   ::test (*this, r);
+        KernelTest<AudioData::Int24,   AudioData::LittleEndian>::test (*this, r);
+        KernelTest<AudioData::Int24,   AudioData::BigEndian>   ::test (*this, r);
+        KernelTest<AudioData::Int32,   AudioData::LittleEndian>::test (*this, r);
+        KernelTest<AudioData::Int32,   AudioData::BigEndian>   ::test (*this, r);
+        KernelTest<AudioData::Float32, AudioData::BigEndian>   ::test (*this, r);
+        KernelTest<AudioData::Float32, AudioData::LittleEndian>::test (*this, r);
+
         using Format = AudioData::Format<AudioData::Float32, AudioData::NativeEndian>;
 
         beginTest ("Interleaving");
@@ -322,6 +322,33 @@ public:
     };
   #endif
 
+private:
+    //==============================================================================
+    // The formats which have optimised kernels for converting to and from native-endian floats
+    enum class FastFormat { none, int16LE, int16BE, int24LE, int24BE, int32LE, int32BE, float32LE, float32BE };
+
+   #if JUCE_BIG_ENDIAN
+    static constexpr FastFormat nativeFloatFormat = FastFormat::float32BE;
+   #else
+    static constexpr FastFormat nativeFloatFormat = FastFormat::float32LE;
+   #endif
+
+    template <typename SampleFormat, typename Endianness>
+    static constexpr FastFormat getFastFormat() noexcept
+    {
+        return std::is_same<SampleFormat, Int16>::value   ? (Endianness::isBigEndian ? FastFormat::int16BE   : FastFormat::int16LE)
+             : std::is_same<SampleFormat, Int24>::value   ? (Endianness::isBigEndian ? FastFormat::int24BE   : FastFormat::int24LE)
+             : std::is_same<SampleFormat, Int32>::value   ? (Endianness::isBigEndian ? FastFormat::int32BE   : FastFormat::int32LE)
+             : std::is_same<SampleFormat, Float32>::value ? (Endianness::isBigEndian ? FastFormat::float32BE : FastFormat::float32LE)
+             : FastFormat::none;
+    }
+
+    template <typename PointerType>
+    struct FastFormatOf;
+
+    enum class ConversionKernel { none, toNativeFloat, fromNativeFloat };
+
+public:
     //==============================================================================
     /**
         A pointer to a block of audio data with a particular encoding.
@@ -461,6 +488,9 @@ public:
             // trying to write to a const pointer! For a writeable one, use AudioData::NonConst instead!
             static_assert (Constness::isConst == 0, "Attempt to write to a const pointer");
 
+            if (convertSamplesQuickly (source, numSamples, ConversionKernelTag<OtherPointerType, Pointer>()))
+                return;
+
             Pointer dest (*this);
 
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
@@ -571,6 +601,38 @@ public:
 
         inline void advance() noexcept                          { this->advanceData (data); }
 
+        template <class OtherPointerType>
+        bool convertSamplesQuickly (const OtherPointerType&, int, std::integral_constant<ConversionKernel, ConversionKernel::none>) const noexcept
+        {
+            return false;
+        }
+
+        template <class OtherPointerType, ConversionKernel kernel>
+        bool convertSamplesQuickly (const OtherPointerType& source, int numSamples, std::integral_constant<ConversionKernel, kernel>) const noexcept
+        {
+            auto sourceBytes = OtherPointerType::getBytesPerSample();
+            auto destBytes = getBytesPerSample();
+
+            // The kernels only handle contiguous samples..
+            if (source.getNumBytesBetweenSamples() != sourceBytes || getNumBytesBetweenSamples() != destBytes)
+                return false;
+
+            auto* src = static_cast<const char*> (source.getRawData());
+            auto* dst = static_cast<const char*> (getRawData());
+
+            // ..and can only work in-place if the samples are getting narrower
+            if (src < dst + numSamples * destBytes && dst < src + numSamples * sourceBytes
+                 && (src != dst || destBytes > sourceBytes))
+                return false;
+
+            if (kernel == ConversionKernel::toNativeFloat)
+                convertToNativeFloat (FastFormatOf<OtherPointerType>::value, src, reinterpret_cast<float*> (data.data), numSamples);
+            else
+                convertFromNativeFloat (FastFormatOf<Pointer>::value, reinterpret_cast<const float*> (src), data.data, numSamples);
+
+            return true;
+        }
+
         Pointer operator++ (int); // private to force you to use the more efficient pre-increment!
         Pointer operator-- (int);
     };
@@ -654,6 +716,64 @@ public:
     };
 
 private:
+    template <typename SampleFormat, typename Endianness, typename InterleavingType, typename Constness>
+    struct FastFormatOf<Pointer<SampleFormat, Endianness, InterleavingType, Constness>>
+    {
+        static constexpr FastFormat value = getFastFormat<SampleFormat, Endianness>();
+    };
+
+    template <typename SourcePointerType, typename DestPointerType>
+    static constexpr ConversionKernel getConversionKernel() noexcept
+    {
+        return FastFormatOf<SourcePointerType>::value == FastFormatOf<DestPointerType>::value  ? ConversionKernel::none
+             : FastFormatOf<DestPointerType>::value == nativeFloatFormat
+                 && FastFormatOf<SourcePointerType>::value != FastFormat::none                 ? ConversionKernel::toNativeFloat
+             : FastFormatOf<SourcePointerType>::value == nativeFloatFormat
+                 && FastFormatOf<DestPointerType>::value != FastFormat::none                   ? ConversionKernel::fromNativeFloat
+             : ConversionKernel::none;
+    }
+
+    template <typename SourcePointerType, typename DestPointerType>
+    using ConversionKernelTag = std::integral_constant<ConversionKernel, getConversionKernel<SourcePointerType, DestPointerType>()>;
+
+    static void convertToNativeFloat (FastFormat sourceFormat, const void* source, float* dest, int numSamples) noexcept;
+    static void convertFromNativeFloat (FastFormat destFormat, const float* source, void* dest, int numSamples) noexcept;
+    static int getBytesPerSample (FastFormat) noexcept;
+
+    static bool interleaveWithKernels (FastFormat sourceFormat, const void* const* source, int numSourceChannels,
+                                       FastFormat destFormat, void* dest, int numDestChannels, int numSamples) noexcept;
+    static bool deinterleaveWithKernels (FastFormat sourceFormat, const void* source, int numSourceChannels,
+                                         FastFormat destFormat, void* const* dest, int numDestChannels, int numSamples) noexcept;
+
+    template <typename SourceType, typename DestType, typename SourceData, typename DestData>
+    static bool interleaveSamplesQuickly (SourceData, int, DestData, int, int, std::integral_constant<ConversionKernel, ConversionKernel::none>) noexcept
+    {
+        return false;
+    }
+
+    template <typename SourceType, typename DestType, typename SourceData, typename DestData, ConversionKernel kernel>
+    static bool interleaveSamplesQuickly (SourceData source, int numSourceChannels, DestData dest, int numDestChannels,
+                                          int numSamples, std::integral_constant<ConversionKernel, kernel>) noexcept
+    {
+        return interleaveWithKernels (FastFormatOf<SourceType>::value, reinterpret_cast<const void* const*> (source), numSourceChannels,
+                                      FastFormatOf<DestType>::value, dest, numDestChannels, numSamples);
+    }
+
+    template <typename SourceType, typename DestType, typename SourceData, typename DestData>
+    static bool deinterleaveSamplesQuickly (SourceData, int, DestData, int, int, std::integral_constant<ConversionKernel, ConversionKernel::none>) noexcept
+    {
+        return false;
+    }
+
+    template <typename SourceType, typename DestType, typename SourceData, typename DestData, ConversionKernel kernel>
+    static bool deinterleaveSamplesQuickly (SourceData source, int numSourceChannels, DestData dest, int numDestChannels,
+                                            int numSamples, std::integral_constant<ConversionKernel, kernel>) noexcept
+    {
+        return deinterleaveWithKernels (FastFormatOf<SourceType>::value, source, numSourceChannels,
+                                        FastFormatOf<DestType>::value, reinterpret_cast<void* const*> (dest), numDestChannels, numSamples);
+    }
+
+    //==============================================================================
     template <bool IsInterleaved, bool IsConst, typename...>
     struct ChannelDataSubtypes;
 
@@ -724,6 +844,10 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if (interleaveSamplesQuickly<SourceType, DestType> (source.data, source.channels, dest.data, dest.channels,
+                                                            numSamples, ConversionKernelTag<SourceType, DestType>()))
+            return;
+
         for (int i = 0; i < dest.channels; ++i)
         {
             const DestType destType (addBytesToPointer (dest.data, i * DestType::getBytesPerSample()), dest.channels);
@@ -768,6 +892,10 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if (deinterleaveSamplesQuickly<SourceType, DestType> (source.data, source.channels, dest.data, dest.channels,
+                                                              numSamples, ConversionKernelTag<SourceType, DestType>()))
+            return;
+
         for (int i = 0; i < dest.channels; ++i)
         {
             if (auto* targetChan = dest.data[i])
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AudioDataConvertersBenchmark  : public Benchmark
+{
+public:
+    AudioDataConvertersBenchmark()
+        : Benchmark ("AudioData conversion", UnitTestCategories::audio)
+    {}
+
+    void runBenchmark() override
+    {
+        benchmarkFormat<AudioData::Int16,   AudioData::LittleEndian> ("Int16 LE");
+        benchmarkFormat<AudioData::Int16,   AudioData::BigEndian>    ("Int16 BE");
+        benchmarkFormat<AudioData::Int24,   AudioData::LittleEndian> ("Int24 LE");
+        benchmarkFormat<AudioData::Int24,   AudioData::BigEndian>    ("Int24 BE");
+        benchmarkFormat<AudioData::Int32,   AudioData::LittleEndian> ("Int32 LE");
+        benchmarkFormat<AudioData::Int32,   AudioData::BigEndian>    ("Int32 BE");
+
+       #if JUCE_BIG_ENDIAN
+        benchmarkFormat<AudioData::Float32, AudioData::LittleEndian> ("Float32 LE");
+       #else
+        benchmarkFormat<AudioData::Float32, AudioData::BigEndian>    ("Float32 BE");
+       #endif
+    }
+
+private:
+    enum { numChannels = 2, numSamples = 8192 };
+
+    template <class FormatType, class Endianness>
+    void benchmarkFormat (const String& formatName)
+    {
+        using FloatPointer      = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+        using PackedPointer     = AudioData::Pointer<FormatType, Endianness, AudioData::NonInterleaved, AudioData::NonConst>;
+        using InterleavedPacked = AudioData::Pointer<FormatType, Endianness, AudioData::Interleaved, AudioData::NonConst>;
+        using PackedFormat      = AudioData::Format<FormatType, Endianness>;
+        using FloatFormat       = AudioData::Format<AudioData::Float32, AudioData::NativeEndian>;
+        using PackedElement     = std::remove_pointer_t<decltype (FormatType::data)>;
+
+        AudioBuffer<float> floats (numChannels, numSamples);
+        HeapBlock<char> packed ((size_t) (numChannels * numSamples * PackedPointer::getBytesPerSample()));
+        auto* packedData = reinterpret_cast<PackedElement*> (packed.get());
+        Random random (numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                floats.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        auto getPackedChannel = [&] (int ch) { return packed + ch * numSamples * PackedPointer::getBytesPerSample(); };
+        const auto numItems = numChannels * numSamples;
+
+        measure (formatName + " from float", [&]
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                PackedPointer (getPackedChannel (ch)).convertSamples (FloatPointer (floats.getWritePointer (ch)), numSamples);
+
+            doNotOptimise (packed);
+        }, numItems);
+
+        measure (formatName + " from float, sample-by-sample", [&]
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                FloatPointer s (floats.getWritePointer (ch));
+                PackedPointer d (getPackedChannel (ch));
+
+                for (int i = 0; i < numSamples; ++i, ++s, ++d)
+                    convertSample (s, d);
+            }
+
+            doNotOptimise (packed);
+        }, numItems);
+
+        measure (formatName + " to float", [&]
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                FloatPointer (floats.getWritePointer (ch)).convertSamples (PackedPointer (getPackedChannel (ch)), numSamples);
+
+            doNotOptimise (floats);
+        }, numItems);
+
+        measure (formatName + " to float, sample-by-sample", [&]
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                PackedPointer s (getPackedChannel (ch));
+                FloatPointer d (floats.getWritePointer (ch));
+
+                for (int i = 0; i < numSamples; ++i, ++s, ++d)
+                    convertSample (s, d);
+            }
+
+            doNotOptimise (floats);
+        }, numItems);
+
+        measure (formatName + " from float, interleaving", [&]
+        {
+            AudioData::interleaveSamples (AudioData::NonInterleavedSource<FloatFormat> { floats.getArrayOfReadPointers(), numChannels },
+                                          AudioData::InterleavedDest<PackedFormat>     { packedData, numChannels },
+                                          numSamples);
+            doNotOptimise (packed);
+        }, numItems);
+
+        measure (formatName + " from float, interleaving sample-by-sample", [&]
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                FloatPointer s (floats.getWritePointer (ch));
+                InterleavedPacked d (packed + ch * PackedPointer::getBytesPerSample(), numChannels);
+
+                for (int i = 0; i < numSamples; ++i, ++s, ++d)
+                    convertSample (s, d);
+            }
+
+            doNotOptimise (packed);
+        }, numItems);
+
+        measure (formatName + " to float, deinterleaving", [&]
+        {
+            AudioData::deinterleaveSamples (AudioData::InterleavedSource<PackedFormat>  { packedData, numChannels },
+                                            AudioData::NonInterleavedDest<FloatFormat> { floats.getArrayOfWritePointers(), numChannels },
+                                            numSamples);
+            doNotOptimise (floats);
+        }, numItems);
+
+        measure (formatName + " to float, deinterleaving sample-by-sample", [&]
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                InterleavedPacked s (packed + ch * PackedPointer::getBytesPerSample(), numChannels);
+                FloatPointer d (floats.getWritePointer (ch));
+
+                for (int i = 0; i < numSamples; ++i, ++s, ++d)
+                    convertSample (s, d);
+            }
+
+            doNotOptimise (floats);
+        }, numItems);
+    }
+
+    template <class SourcePointer, class DestPointer>
+    static void convertSample (const SourcePointer& source, DestPointer& dest) noexcept
+    {
+        if (dest.isFloatingPoint())
+            dest.setAsFloat (source.getAsFloat());
+        else
+            dest.setAsInt32 (source.getAsInt32());
+    }
+};
+
+static AudioDataConvertersBenchmark audioDataConvertersBenchmark;
+
+} // namespace juce
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FloatVectorOperationsBenchmark  : public Benchmark
+{
+public:
+    FloatVectorOperationsBenchmark()
+        : Benchmark ("FloatVectorOperations", UnitTestCategories::audio)
+    {}
+
+    void runBenchmark() override
+    {
+        for (auto numValues : { 64, 1024 })
+        {
+            HeapBlock<float> src ((size_t) numValues), dst ((size_t) numValues);
+            HeapBlock<int> ints ((size_t) numValues);
+            Random random (numValues);
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                src[i] = random.nextFloat() * 2.0f - 1.0f;
+                dst[i] = random.nextFloat() * 2.0f - 1.0f;
+                ints[i] = random.nextInt();
+            }
+
+            const auto suffix = " (" + String (numValues) + " values)";
+
+            measure ("copy" + suffix, [&]
+            {
+                FloatVectorOperations::copy (dst, src, numValues);
+                doNotOptimise (dst);
+            }, numValues);
+
+            measure ("add" + suffix, [&]
+            {
+                FloatVectorOperations::add (dst, src, numValues);
+                doNotOptimise (dst);
+            }, numValues);
+
+            measure ("multiply by scalar" + suffix, [&]
+            {
+                FloatVectorOperations::multiply (dst, src, 0.5f, numValues);
+                doNotOptimise (dst);
+            }, numValues);
+
+            measure ("addWithMultiply" + suffix, [&]
+            {
+                FloatVectorOperations::addWithMultiply (dst, src, 0.25f, numValues);
+                doNotOptimise (dst);
+            }, numValues);
+
+            measure ("clip" + suffix, [&]
+            {
+                FloatVectorOperations::clip (dst, src, -0.5f, 0.5f, numValues);
+                doNotOptimise (dst);
+            }, numValues);
+
+            measure ("findMinAndMax" + suffix, [&]
+            {
+                doNotOptimise (FloatVectorOperations::findMinAndMax (src.get(), numValues));
+            }, numValues);
+
+            measure ("convertFixedToFloat" + suffix, [&]
+            {
+                FloatVectorOperations::convertFixedToFloat (dst, ints, 1.0f / (float) 0x7fffffff, numValues);
+                doNotOptimise (dst);
+            }, numValues);
+        }
+    }
+};
+
+static FloatVectorOperationsBenchmark floatVectorOperationsBenchmark;
+
+} // namespace juce
@@ -61,9 +61,13 @@
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
+#include "midi/juce_MidiFileReader.cpp"
+#include "midi/juce_MidiFileWriter.cpp"
+#include "midi/juce_CompactMidiSequence.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
 #include "midi/juce_MidiMessageSequence.cpp"
@@ -95,5 +99,11 @@
 
 #if JUCE_UNIT_TESTS
  #include "utilities/juce_ADSR_test.cpp"
+ #include "utilities/juce_SmoothedValueBank_test.cpp"
  #include "midi/ump/juce_UMPTests.cpp"
 #endif
+
+#if JUCE_BENCHMARKS
+ #include "buffers/juce_FloatVectorOperations_benchmark.cpp"
+ #include "buffers/juce_AudioDataConverters_benchmark.cpp"
+#endif
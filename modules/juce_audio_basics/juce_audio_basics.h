@@ -91,13 +91,18 @@
 #include "utilities/juce_IIRFilter.h"
 #include "utilities/juce_GenericInterpolator.h"
 #include "utilities/juce_Interpolators.h"
+#include "utilities/juce_PolyphaseResampler.h"
 #include "utilities/juce_SmoothedValue.h"
+#include "utilities/juce_SmoothedValueBank.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
 #include "midi/juce_MidiFile.h"
+#include "midi/juce_MidiFileReader.h"
+#include "midi/juce_CompactMidiSequence.h"
+#include "midi/juce_MidiFileWriter.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "midi/juce_MidiRPN.h"
 #include "mpe/juce_MPEValue.h"
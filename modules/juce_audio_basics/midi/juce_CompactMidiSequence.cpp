@@ -0,0 +1,553 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+void CompactMidiSequence::clear() noexcept
+{
+    events.clear();
+    storage.clear();
+    pairsMatched = false;
+}
+
+void CompactMidiSequence::ensureStorageAllocated (int numEvents, size_t numBytesOfMessageData)
+{
+    events.reserve ((size_t) numEvents);
+    storage.reserve (numBytesOfMessageData);
+}
+
+MidiMessage CompactMidiSequence::getMessage (int index) const
+{
+    return MidiMessage (getRawData (index), getRawDataSize (index), getEventTime (index));
+}
+
+double CompactMidiSequence::getStartTime() const noexcept
+{
+    return events.empty() ? 0.0 : events.front().time;
+}
+
+double CompactMidiSequence::getEndTime() const noexcept
+{
+    return events.empty() ? 0.0 : events.back().time;
+}
+
+int CompactMidiSequence::getNextIndexAtTime (double timeStamp) const noexcept
+{
+    auto position = std::lower_bound (events.begin(), events.end(), timeStamp,
+                                      [] (const Event& e, double t) { return e.time < t; });
+
+    return (int) std::distance (events.begin(), position);
+}
+
+double CompactMidiSequence::getTimeOfMatchingKeyUp (int index) const noexcept
+{
+    auto matchedIndex = getIndexOfMatchingKeyUp (index);
+    return matchedIndex >= 0 ? getEventTime (matchedIndex) : 0.0;
+}
+
+//==============================================================================
+void CompactMidiSequence::addEvent (const MidiMessage& message, double timeAdjustment)
+{
+    addEvent (message.getRawData(), message.getRawDataSize(), message.getTimeStamp() + timeAdjustment);
+}
+
+void CompactMidiSequence::addEvent (const uint8* rawData, int numBytes, double time)
+{
+    jassert (numBytes > 0);
+    auto index = insertEvent ({ time, storeData (rawData, numBytes), numBytes, -1 });
+
+    if (pairsMatched)
+        updatePairsAfterInsertion (index);
+}
+
+void CompactMidiSequence::addEvents (MidiFileReader::TrackReader track)
+{
+    for (MidiFileReader::Event e; track.next (e);)
+    {
+        auto size = e.getRawDataSize();
+        auto offset = storage.size();
+
+        jassert (offset + (size_t) size <= std::numeric_limits<uint32>::max());
+
+        storage.resize (offset + (size_t) size);
+        e.copyRawData (storage.data() + offset);
+
+        insertEvent ({ (double) e.tick, (uint32) offset, size, -1 });
+    }
+
+    putNoteOffsBeforeNoteOns();
+
+    if (pairsMatched)
+        updateMatchedPairs();
+}
+
+void CompactMidiSequence::addSequence (const CompactMidiSequence& other, double timeAdjustment)
+{
+    auto dataStart = storage.size();
+    auto numOldEvents = events.size();
+
+    jassert (dataStart + other.storage.size() <= std::numeric_limits<uint32>::max());
+
+    storage.insert (storage.end(), other.storage.begin(), other.storage.end());
+    events.reserve (numOldEvents + other.events.size());
+
+    for (auto& e : other.events)
+        events.push_back ({ e.time + timeAdjustment, e.offset + (uint32) dataStart, e.size, -1 });
+
+    std::inplace_merge (events.begin(), events.begin() + (ptrdiff_t) numOldEvents, events.end(),
+                        [] (const Event& a, const Event& b) { return a.time < b.time; });
+
+    if (pairsMatched)
+        updateMatchedPairs();
+}
+
+void CompactMidiSequence::deleteEvents (int startIndex, int numEventsToDelete)
+{
+    jassert (startIndex >= 0 && numEventsToDelete >= 0 && startIndex + numEventsToDelete <= getNumEvents());
+
+    startIndex = jlimit (0, getNumEvents(), startIndex);
+    auto endIndex = jlimit (startIndex, getNumEvents(), startIndex + numEventsToDelete);
+
+    if (startIndex == endIndex)
+        return;
+
+    events.erase (events.begin() + startIndex, events.begin() + endIndex);
+
+    for (auto& e : events)
+    {
+        if (e.matchedIndex >= endIndex)
+            e.matchedIndex -= endIndex - startIndex;
+        else if (e.matchedIndex >= startIndex)
+            e.matchedIndex = -1;
+    }
+
+    pairsMatched = false;
+}
+
+void CompactMidiSequence::deleteEventsInTimeRange (double startTime, double endTime)
+{
+    auto startIndex = getNextIndexAtTime (startTime);
+    deleteEvents (startIndex, jmax (0, getNextIndexAtTime (endTime) - startIndex));
+}
+
+void CompactMidiSequence::addTimeToMessages (double delta) noexcept
+{
+    for (auto& e : events)
+        e.time += delta;
+}
+
+void CompactMidiSequence::compactStorage()
+{
+    size_t numBytesUsed = 0;
+
+    for (auto& e : events)
+        numBytesUsed += (size_t) e.size;
+
+    std::vector<uint8> newStorage;
+    newStorage.reserve (numBytesUsed);
+
+    for (auto& e : events)
+    {
+        auto* data = storage.data() + e.offset;
+        e.offset = (uint32) newStorage.size();
+        newStorage.insert (newStorage.end(), data, data + e.size);
+    }
+
+    storage.swap (newStorage);
+}
+
+uint32 CompactMidiSequence::storeData (const uint8* rawData, int numBytes)
+{
+    auto offset = storage.size();
+
+    // there's a limit of 4GB of message data in a sequence
+    jassert (offset + (size_t) numBytes <= std::numeric_limits<uint32>::max());
+
+    storage.insert (storage.end(), rawData, rawData + numBytes);
+    return (uint32) offset;
+}
+
+size_t CompactMidiSequence::insertEvent (const Event& e)
+{
+    if (events.empty() || events.back().time <= e.time)
+    {
+        events.push_back (e);
+        return events.size() - 1;
+    }
+
+    auto position = std::upper_bound (events.begin(), events.end(), e.time,
+                                      [] (double t, const Event& other) { return t < other.time; });
+
+    auto index = (size_t) std::distance (events.begin(), position);
+    insertEventAt (index, e);
+    return index;
+}
+
+void CompactMidiSequence::insertEventAt (size_t index, const Event& e)
+{
+    events.insert (events.begin() + (ptrdiff_t) index, e);
+
+    if (pairsMatched && index + 1 < events.size())
+        for (auto& other : events)
+            if (other.matchedIndex >= (int) index)
+                ++other.matchedIndex;
+}
+
+void CompactMidiSequence::insertNoteOffBefore (size_t index)
+{
+    auto* noteOn = storage.data() + events[index].offset;
+    const uint8 noteOff[] = { (uint8) (0x80 | (noteOn[0] & 0x0f)), noteOn[1], 0 };
+    auto time = events[index].time;
+
+    insertEventAt (index, { time, storeData (noteOff, 3), 3, -1 });
+}
+
+int CompactMidiSequence::findNeighbouringNoteEvent (size_t index, int noteIndex, int direction) const noexcept
+{
+    for (auto i = (int) index + direction; isPositiveAndBelow (i, getNumEvents()); i += direction)
+    {
+        auto& e = events[(size_t) i];
+
+        if ((isNoteOn (e) || isNoteOff (e)) && getNoteIndex (e) == noteIndex)
+            return i;
+    }
+
+    return -1;
+}
+
+void CompactMidiSequence::updatePairsAfterInsertion (size_t index)
+{
+    // While the pairs are matched, the events for each note always go: any number of
+    // stray note-offs, then note-ons that are each followed by their note-off (or
+    // by nothing, for the last one), so a new event only affects its neighbours
+    if (! (isNoteOn (events[index]) || isNoteOff (events[index])))
+        return;
+
+    auto noteIndex = getNoteIndex (events[index]);
+    auto previous = findNeighbouringNoteEvent (index, noteIndex, -1);
+    auto previousIsNoteOn = previous >= 0 && isNoteOn (events[(size_t) previous]);
+
+    if (isNoteOff (events[index]))
+    {
+        if (previousIsNoteOn)
+            events[(size_t) previous].matchedIndex = (int) index;
+
+        return;
+    }
+
+    if (previousIsNoteOn)
+    {
+        insertNoteOffBefore (index);
+        events[(size_t) previous].matchedIndex = (int) index;
+        ++index;
+    }
+
+    auto next = findNeighbouringNoteEvent (index, noteIndex, 1);
+
+    if (next >= 0 && isNoteOn (events[(size_t) next]))
+        insertNoteOffBefore ((size_t) next);
+
+    events[index].matchedIndex = next;
+}
+
+void CompactMidiSequence::putNoteOffsBeforeNoteOns() noexcept
+{
+    // This only has to move events within runs that have the same timestamp, so
+    // it's linear unless a note-off follows a lot of note-ons at the same time
+    for (size_t i = 1; i < events.size(); ++i)
+    {
+        for (auto j = i; j > 0; --j)
+        {
+            auto& previous = events[j - 1];
+            auto& current = events[j];
+
+            if (previous.time != current.time || ! isNoteOn (previous) || ! isNoteOff (current))
+                break;
+
+            std::swap (previous, current);
+        }
+    }
+}
+
+//==============================================================================
+bool CompactMidiSequence::isNoteOn (const Event& e) const noexcept
+{
+    auto* data = storage.data() + e.offset;
+    return (data[0] & 0xf0) == 0x90 && e.size == 3 && data[2] != 0;
+}
+
+bool CompactMidiSequence::isNoteOff (const Event& e) const noexcept
+{
+    auto* data = storage.data() + e.offset;
+    return (data[0] & 0xf0) == 0x80 || ((data[0] & 0xf0) == 0x90 && e.size == 3 && data[2] == 0);
+}
+
+int CompactMidiSequence::getNoteIndex (const Event& e) const noexcept
+{
+    auto* data = storage.data() + e.offset;
+    return ((data[0] & 0x0f) << 7) | (e.size > 1 ? (data[1] & 0x7f) : 0);
+}
+
+void CompactMidiSequence::updateMatchedPairs()
+{
+    constexpr int numNotes = 16 * 128;
+    int pendingNoteOns[numNotes];
+
+    // First, find the note-ons that retrigger a note that hasn't been released..
+    std::fill (std::begin (pendingNoteOns), std::end (pendingNoteOns), -1);
+    noteOnsToRelease.clear();
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        auto& e = events[i];
+
+        if (isNoteOn (e))
+        {
+            auto& pending = pendingNoteOns[getNoteIndex (e)];
+
+            if (pending >= 0)
+                noteOnsToRelease.push_back ((int) i);
+
+            pending = (int) i;
+        }
+        else if (isNoteOff (e))
+        {
+            pendingNoteOns[getNoteIndex (e)] = -1;
+        }
+    }
+
+    // ..and insert a note-off before each of them, working backwards so that
+    // each event only has to be moved once..
+    if (! noteOnsToRelease.empty())
+    {
+        auto numToInsert = noteOnsToRelease.size();
+        auto oldSize = events.size();
+        events.resize (oldSize + numToInsert);
+
+        auto write = events.size();
+
+        for (auto read = oldSize; read-- > 0;)
+        {
+            events[--write] = events[read];
+
+            if (numToInsert > 0 && noteOnsToRelease[numToInsert - 1] == (int) read)
+            {
+                --numToInsert;
+
+                auto* noteOn = storage.data() + events[write].offset;
+                const uint8 noteOff[] = { (uint8) (0x80 | (noteOn[0] & 0x0f)), noteOn[1], 0 };
+                auto time = events[write].time;
+
+                events[--write] = { time, storeData (noteOff, 3), 3, -1 };
+            }
+        }
+    }
+
+    // ..after which every note-on is matched by the next note-off of the same note
+    std::fill (std::begin (pendingNoteOns), std::end (pendingNoteOns), -1);
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        auto& e = events[i];
+        e.matchedIndex = -1;
+
+        if (isNoteOn (e))
+        {
+            pendingNoteOns[getNoteIndex (e)] = (int) i;
+        }
+        else if (isNoteOff (e))
+        {
+            auto& pending = pendingNoteOns[getNoteIndex (e)];
+
+            if (pending >= 0)
+                events[(size_t) pending].matchedIndex = (int) i;
+
+            pending = -1;
+        }
+    }
+
+    pairsMatched = true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct CompactMidiSequenceTests  : public UnitTest
+{
+    CompactMidiSequenceTests()
+        : UnitTest ("CompactMidiSequence", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Events are kept in time order");
+        {
+            CompactMidiSequence s;
+            s.addEvent (MidiMessage::noteOn (1, 60, 0.5f).withTimeStamp (2.0));
+            s.addEvent (MidiMessage::noteOn (1, 61, 0.5f).withTimeStamp (1.0));
+            s.addEvent (MidiMessage::noteOn (1, 62, 0.5f).withTimeStamp (2.0));
+            s.addEvent (MidiMessage::noteOn (1, 63, 0.5f).withTimeStamp (0.0), 3.0);
+
+            expectEquals (s.getNumEvents(), 4);
+            expectEquals (s.getStartTime(), 1.0);
+            expectEquals (s.getEndTime(), 3.0);
+
+            int expectedNotes[] = { 61, 60, 62, 63 };
+
+            for (int i = 0; i < 4; ++i)
+                expectEquals (s.getMessage (i).getNoteNumber(), expectedNotes[i]);
+        }
+
+        beginTest ("Matched pairs are the same as MidiMessageSequence's");
+        {
+            auto random = getRandom();
+
+            MidiMessageSequence expected;
+            CompactMidiSequence s;
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto channel = 1 + random.nextInt (3);
+                auto note = 60 + random.nextInt (8);
+                auto time = (double) random.nextInt (1000);
+
+                // (a mixture of retriggered notes, note-ons with zero velocity, and stray note-offs)
+                auto m = random.nextBool() ? MidiMessage::noteOn (channel, note, (uint8) random.nextInt (128))
+                                           : MidiMessage::noteOff (channel, note);
+                m.setTimeStamp (time);
+
+                expected.addEvent (m);
+                s.addEvent (m);
+            }
+
+            expected.updateMatchedPairs();
+            s.updateMatchedPairs();
+
+            expectEquals (s.getNumEvents(), expected.getNumEvents());
+
+            for (int i = 0; i < s.getNumEvents(); ++i)
+            {
+                auto& m = expected.getEventPointer (i)->message;
+                auto message = s.getMessage (i);
+
+                expectEquals (message.getTimeStamp(), m.getTimeStamp());
+                expectEquals (message.getDescription(), m.getDescription());
+                expectEquals (s.getIndexOfMatchingKeyUp (i), expected.getIndexOfMatchingKeyUp (i));
+            }
+        }
+
+        beginTest ("Adding events keeps the pairs matched");
+        {
+            auto random = getRandom();
+
+            CompactMidiSequence incremental;
+            incremental.updateMatchedPairs();
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto note = 60 + random.nextInt (4);
+                auto m = random.nextBool() ? MidiMessage::noteOn (1, note, (uint8) (1 + random.nextInt (127)))
+                                           : MidiMessage::noteOff (1, note);
+
+                incremental.addEvent (m.withTimeStamp ((double) random.nextInt (500)));
+            }
+
+            CompactMidiSequence full;
+
+            for (int i = 0; i < incremental.getNumEvents(); ++i)
+                full.addEvent (incremental.getMessage (i));
+
+            full.updateMatchedPairs();
+
+            // (everything that updateMatchedPairs() would have added should already be there)
+            expectEquals (full.getNumEvents(), incremental.getNumEvents());
+
+            for (int i = 0; i < full.getNumEvents(); ++i)
+                expectEquals (incremental.getIndexOfMatchingKeyUp (i), full.getIndexOfMatchingKeyUp (i));
+        }
+
+        beginTest ("Finding and deleting events by time");
+        {
+            CompactMidiSequence s;
+
+            for (int i = 0; i < 10; ++i)
+            {
+                s.addEvent (MidiMessage::noteOn (1, 60 + i, 0.5f).withTimeStamp (i * 2.0));
+                s.addEvent (MidiMessage::noteOff (1, 60 + i, 0.5f).withTimeStamp (i * 2.0 + 1.0));
+            }
+
+            s.updateMatchedPairs();
+
+            expectEquals (s.getNextIndexAtTime (-1.0), 0);
+            expectEquals (s.getNextIndexAtTime (4.0), 4);
+            expectEquals (s.getNextIndexAtTime (4.5), 5);
+            expectEquals (s.getNextIndexAtTime (100.0), 20);
+
+            s.deleteEventsInTimeRange (3.0, 8.0);
+            expectEquals (s.getNumEvents(), 15);
+            expectEquals (s.getEventTime (3), 8.0);
+            expectEquals (s.getIndexOfMatchingKeyUp (0), 1);
+            expectEquals (s.getIndexOfMatchingKeyUp (2), -1);
+            expectEquals (s.getIndexOfMatchingKeyUp (3), 4);
+
+            s.compactStorage();
+            s.addTimeToMessages (1.0);
+            expectEquals (s.getStartTime(), 1.0);
+            expectEquals (s.getMessage (3).getNoteNumber(), 64);
+            expectEquals (s.getMessage (3).getTimeStamp(), 9.0);
+        }
+
+        beginTest ("Merging sequences");
+        {
+            CompactMidiSequence a, b;
+            a.addEvent (MidiMessage::noteOn (1, 60, 0.5f).withTimeStamp (0.0));
+            a.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (4.0));
+            b.addEvent (MidiMessage::noteOn (2, 40, 0.5f).withTimeStamp (1.0));
+            b.addEvent (MidiMessage::noteOff (2, 40, 0.5f).withTimeStamp (2.0));
+
+            a.updateMatchedPairs();
+            a.addSequence (b, 2.0);
+
+            expectEquals (a.getNumEvents(), 4);
+            expectEquals (a.getMessage (1).getChannel(), 2);
+            expectEquals (a.getEventTime (1), 3.0);
+
+            // (at the same time, the existing event comes first)
+            expectEquals (a.getMessage (2).getChannel(), 1);
+            expectEquals (a.getMessage (3).getChannel(), 2);
+            expectEquals (a.getIndexOfMatchingKeyUp (0), 2);
+            expectEquals (a.getIndexOfMatchingKeyUp (1), 3);
+        }
+    }
+};
+
+static CompactMidiSequenceTests compactMidiSequenceTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A sequence of timestamped midi messages, stored contiguously.
+
+    This holds the same kind of data as a MidiMessageSequence, but instead of a
+    heap-allocated MidiEventHolder for every event, the events are kept in a single
+    array, and the bytes of all their messages are packed together in another. Once
+    enough space has been reserved with ensureStorageAllocated(), adding events
+    doesn't allocate, and clearing the sequence keeps its storage, so one sequence
+    can be reused to read many midi files.
+
+    Finding events by time uses a binary search, and once updateMatchedPairs() has
+    been called, addEvent() keeps the note pairs matched by only looking at the
+    neighbouring events for the same note. Larger edits should use the bulk
+    operations, such as addSequence() and deleteEventsInTimeRange(), which work on
+    the whole array at once.
+
+    @code
+    CompactMidiSequence sequence;
+
+    for (int i = 0; i < reader.getNumTracks(); ++i)
+    {
+        sequence.clear();
+        sequence.addEvents (reader.getTrack (i));
+        sequence.updateMatchedPairs();
+        ...
+    }
+    @endcode
+
+    @see MidiMessageSequence, MidiFileReader, MidiFileWriter
+
+    @tags{Audio}
+*/
+class JUCE_API  CompactMidiSequence
+{
+public:
+    //==============================================================================
+    /** Creates an empty sequence. */
+    CompactMidiSequence() = default;
+
+    //==============================================================================
+    /** Removes all the events, but keeps the storage that was allocated for them. */
+    void clear() noexcept;
+
+    /** Makes sure there's enough space for a number of events, whose messages
+        take up a total number of bytes.
+    */
+    void ensureStorageAllocated (int numEvents, size_t numBytesOfMessageData);
+
+    //==============================================================================
+    /** Returns the number of events in the sequence. */
+    int getNumEvents() const noexcept                       { return (int) events.size(); }
+
+    /** Returns the timestamp of one of the events. */
+    double getEventTime (int index) const noexcept          { return events[(size_t) index].time; }
+
+    /** Returns the raw midi data of one of the events, in the same form as
+        MidiMessage::getRawData().
+    */
+    const uint8* getRawData (int index) const noexcept      { return storage.data() + events[(size_t) index].offset; }
+
+    /** Returns the number of bytes of raw midi data in one of the events. */
+    int getRawDataSize (int index) const noexcept           { return events[(size_t) index].size; }
+
+    /** Creates a MidiMessage for one of the events. */
+    MidiMessage getMessage (int index) const;
+
+    /** Returns the timestamp of the first event, or 0 if there are none. */
+    double getStartTime() const noexcept;
+
+    /** Returns the timestamp of the last event, or 0 if there are none. */
+    double getEndTime() const noexcept;
+
+    /** Returns the index of the first event at or after the given time.
+        If the time is beyond the end of the sequence, this returns the number of events.
+    */
+    int getNextIndexAtTime (double timeStamp) const noexcept;
+
+    //==============================================================================
+    /** Inserts a midi message into the sequence.
+
+        The event is placed after any existing events with the same or an earlier time.
+        If updateMatchedPairs() has been called, the note pairs are kept up to date,
+        which may involve inserting a note-off before a retriggered note, exactly
+        as updateMatchedPairs() would.
+
+        @param message          the message to add
+        @param timeAdjustment   an optional value to add to the message's timestamp
+    */
+    void addEvent (const MidiMessage& message, double timeAdjustment = 0);
+
+    /** Inserts some raw midi data into the sequence, with the given timestamp. */
+    void addEvent (const uint8* rawData, int numBytes, double time);
+
+    /** Adds all the remaining events from a track of a midi file.
+
+        As MidiFile does, this puts note-offs before any note-ons that happen at the
+        same time, and uses the events' ticks as their timestamps.
+    */
+    void addEvents (MidiFileReader::TrackReader track);
+
+    //==============================================================================
+    /** Merges all the events from another sequence into this one.
+
+        Events from the other sequence are placed after any events in this one
+        that have the same time.
+        @param other            the sequence to add
+        @param timeAdjustment   an amount to add to the timestamps of the new events
+    */
+    void addSequence (const CompactMidiSequence& other, double timeAdjustment = 0);
+
+    /** Removes a range of events.
+
+        The note pairs of the remaining events will need to be matched again
+        with updateMatchedPairs(). The space that the events' data used isn't
+        reclaimed until compactStorage() is called.
+    */
+    void deleteEvents (int startIndex, int numEventsToDelete);
+
+    /** Removes all the events from startTime up to (but not including) endTime.
+        @see deleteEvents
+    */
+    void deleteEventsInTimeRange (double startTime, double endTime);
+
+    /** Adds an offset to the timestamps of all the events. */
+    void addTimeToMessages (double delta) noexcept;
+
+    /** Frees up the space used by the data of events that have been deleted. */
+    void compactStorage();
+
+    //==============================================================================
+    /** Makes sure that every note-on has a matching note-off.
+
+        This behaves like MidiMessageSequence::updateMatchedPairs(), inserting a
+        note-off wherever a note is retriggered before it's been released, but it
+        takes linear time rather than comparing each note-on with the events that
+        follow it.
+
+        @see getIndexOfMatchingKeyUp
+    */
+    void updateMatchedPairs();
+
+    /** Returns the index of the note-off that matches the note-on at this index,
+        or -1 if there isn't one. This is only valid after updateMatchedPairs().
+    */
+    int getIndexOfMatchingKeyUp (int index) const noexcept  { return events[(size_t) index].matchedIndex; }
+
+    /** Returns the time of the note-off that matches the note-on at this index,
+        or 0 if there isn't one.
+    */
+    double getTimeOfMatchingKeyUp (int index) const noexcept;
+
+private:
+    //==============================================================================
+    struct Event
+    {
+        double time;
+        uint32 offset;
+        int size;
+        int matchedIndex;
+    };
+
+    bool isNoteOn (const Event&) const noexcept;
+    bool isNoteOff (const Event&) const noexcept;
+    int getNoteIndex (const Event&) const noexcept;
+    uint32 storeData (const uint8* rawData, int numBytes);
+    size_t insertEvent (const Event&);
+    void insertEventAt (size_t index, const Event&);
+    void insertNoteOffBefore (size_t index);
+    void updatePairsAfterInsertion (size_t index);
+    int findNeighbouringNoteEvent (size_t index, int noteIndex, int direction) const noexcept;
+    void putNoteOffsBeforeNoteOns() noexcept;
+
+    std::vector<Event> events;
+    std::vector<uint8> storage;
+    std::vector<int> noteOnsToRelease;
+    bool pairsMatched = false;
+
+    JUCE_LEAK_DETECTOR (CompactMidiSequence)
+};
+
+} // namespace juce
@@ -28,6 +28,11 @@ namespace juce
     Helper class that takes chunks of incoming midi bytes, packages them into
     messages, and dispatches them to a midi callback.
 
+    If the callback has a handleIncomingMidiData (input, data, numBytes, time) method,
+    complete messages are passed to that as raw bytes, which avoids creating a
+    MidiMessage (and allocating space for it, in the case of a long sysex). Otherwise
+    they're passed to handleIncomingMidiMessage() as MidiMessage objects.
+
     @tags{Audio}
 */
 class MidiDataConcatenator
@@ -67,7 +72,7 @@ public:
 
             if (isRealtimeMessage (nextByte))
             {
-                callback.handleIncomingMidiMessage (input, MidiMessage (nextByte, time));
+                dispatchMessage (&nextByte, 1, time, input, callback);
                 // These can be embedded in the middle of a normal message, so we won't
                 // reset the currentMessageLen here.
                 continue;
@@ -93,7 +98,7 @@ public:
 
             if (expectedLength == currentMessageLen)
             {
-                callback.handleIncomingMidiMessage (input, MidiMessage (currentMessage, expectedLength, time));
+                dispatchMessage (currentMessage, expectedLength, time, input, callback);
                 currentMessageLen = 1; // reset, but leave the first byte to use as the running status byte
             }
         }
@@ -128,7 +133,7 @@ private:
 
                 if (*d >= 0xfa || *d == 0xf8)
                 {
-                    callback.handleIncomingMidiMessage (input, MidiMessage (*d, time));
+                    dispatchMessage (d, 1, time, input, callback);
                     ++d;
                     --numBytes;
                 }
@@ -140,7 +145,7 @@ private:
 
                     if (used > 0)
                     {
-                        callback.handleIncomingMidiMessage (input, m);
+                        dispatchMessage (m.getRawData(), m.getRawDataSize(), time, input, callback);
                         numBytes -= used;
                         d += used;
                     }
@@ -161,7 +166,7 @@ private:
         {
             if (totalMessage [pendingSysexSize - 1] == 0xf7)
             {
-                callback.handleIncomingMidiMessage (input, MidiMessage (totalMessage, pendingSysexSize, pendingSysexTime));
+                dispatchMessage (totalMessage, pendingSysexSize, pendingSysexTime, input, callback);
                 pendingSysexSize = 0;
             }
             else
@@ -171,6 +176,38 @@ private:
         }
     }
 
+    //==============================================================================
+    template <typename UserDataType, typename CallbackType, typename = void>
+    struct HasRawDataCallback : std::false_type {};
+
+    template <typename UserDataType, typename CallbackType>
+    struct HasRawDataCallback<UserDataType, CallbackType,
+                              decltype (std::declval<CallbackType&>().handleIncomingMidiData (std::declval<UserDataType*>(),
+                                                                                              std::declval<const uint8*>(),
+                                                                                              0, 0.0), void())>
+        : std::true_type {};
+
+    template <typename UserDataType, typename CallbackType>
+    static void dispatchMessage (const uint8* data, int numBytes, double time,
+                                 UserDataType* input, CallbackType& callback)
+    {
+        dispatchMessage (data, numBytes, time, input, callback, HasRawDataCallback<UserDataType, CallbackType>{});
+    }
+
+    template <typename UserDataType, typename CallbackType>
+    static void dispatchMessage (const uint8* data, int numBytes, double time,
+                                 UserDataType* input, CallbackType& callback, std::true_type)
+    {
+        callback.handleIncomingMidiData (input, data, numBytes, time);
+    }
+
+    template <typename UserDataType, typename CallbackType>
+    static void dispatchMessage (const uint8* data, int numBytes, double time,
+                                 UserDataType* input, CallbackType& callback, std::false_type)
+    {
+        callback.handleIncomingMidiMessage (input, MidiMessage (data, numBytes, time));
+    }
+
     static bool isRealtimeMessage (uint8 byte)  { return byte >= 0xf8 && byte <= 0xfe; }
     static bool isStatusByte (uint8 byte)       { return byte >= 0x80; }
     static bool isInitialByte (uint8 byte)      { return isStatusByte (byte) && byte != 0xf7; }
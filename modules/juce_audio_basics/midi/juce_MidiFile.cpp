@@ -222,41 +222,11 @@ namespace MidiFileHelpers
 
     static MidiMessageSequence readTrack (const uint8* data, int size)
     {
-        double time = 0;
-        uint8 lastStatusByte = 0;
-
         MidiMessageSequence result;
+        MidiFileReader::TrackReader reader (data, (size_t) jmax (0, size));
 
-        while (size > 0)
-        {
-            const auto delay = MidiMessage::readVariableLengthValue (data, (int) size);
-
-            if (! delay.isValid())
-                break;
-
-            data += delay.bytesUsed;
-            size -= delay.bytesUsed;
-            time += delay.value;
-
-            if (size <= 0)
-                break;
-
-            int messSize = 0;
-            const MidiMessage mm (data, size, messSize, lastStatusByte, time);
-
-            if (messSize <= 0)
-                break;
-
-            size -= messSize;
-            data += messSize;
-
-            result.addEvent (mm);
-
-            auto firstByte = *(mm.getRawData());
-
-            if ((firstByte & 0xf0) != 0xf0)
-                lastStatusByte = firstByte;
-        }
+        for (MidiFileReader::Event event; reader.next (event);)
+            result.addEvent (event.toMidiMessage());
 
         return result;
     }
@@ -461,13 +431,8 @@ void MidiFile::convertTimestampTicksToSeconds()
 //==============================================================================
 bool MidiFile::writeTo (OutputStream& out, int midiFileType) const
 {
-    jassert (midiFileType >= 0 && midiFileType <= 2);
-
-    if (! out.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MThd"))) return false;
-    if (! out.writeIntBigEndian (6))                                      return false;
-    if (! out.writeShortBigEndian ((short) midiFileType))                 return false;
-    if (! out.writeShortBigEndian ((short) tracks.size()))                return false;
-    if (! out.writeShortBigEndian (timeFormat))                           return false;
+    if (! MidiFileWriter (out).writeHeader (midiFileType, tracks.size(), timeFormat))
+        return false;
 
     for (auto* ms : tracks)
         if (! writeTrack (out, *ms))
@@ -479,63 +444,13 @@ bool MidiFile::writeTo (OutputStream& out, int midiFileType) const
 
 bool MidiFile::writeTrack (OutputStream& mainOut, const MidiMessageSequence& ms) const
 {
-    MemoryOutputStream out;
+    MidiFileWriter writer (mainOut);
+    writer.startTrack();
 
-    int lastTick = 0;
-    uint8 lastStatusByte = 0;
-    bool endOfTrackEventWritten = false;
-
-    for (int i = 0; i < ms.getNumEvents(); ++i)
-    {
-        auto& mm = ms.getEventPointer(i)->message;
+    for (auto* event : ms)
+        writer.addEvent (event->message);
 
-        if (mm.isEndOfTrackMetaEvent())
-            endOfTrackEventWritten = true;
-
-        auto tick = roundToInt (mm.getTimeStamp());
-        auto delta = jmax (0, tick - lastTick);
-        MidiFileHelpers::writeVariableLengthInt (out, (uint32) delta);
-        lastTick = tick;
-
-        auto* data = mm.getRawData();
-        auto dataSize = mm.getRawDataSize();
-        auto statusByte = data[0];
-
-        if (statusByte == lastStatusByte
-             && (statusByte & 0xf0) != 0xf0
-             && dataSize > 1
-             && i > 0)
-        {
-            ++data;
-            --dataSize;
-        }
-        else if (statusByte == 0xf0)  // Write sysex message with length bytes.
-        {
-            out.writeByte ((char) statusByte);
-
-            ++data;
-            --dataSize;
-
-            MidiFileHelpers::writeVariableLengthInt (out, (uint32) dataSize);
-        }
-
-        out.write (data, (size_t) dataSize);
-        lastStatusByte = statusByte;
-    }
-
-    if (! endOfTrackEventWritten)
-    {
-        out.writeByte (0); // (tick delta)
-        auto m = MidiMessage::endOfTrack();
-        out.write (m.getRawData(), (size_t) m.getRawDataSize());
-    }
-
-    if (! mainOut.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MTrk"))) return false;
-    if (! mainOut.writeIntBigEndian ((int) out.getDataSize()))                return false;
-
-    mainOut << out;
-
-    return true;
+    return writer.finishTrack();
 }
 
 //==============================================================================
@@ -0,0 +1,355 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+int MidiFileReader::Event::getRawDataSize() const noexcept
+{
+    if (statusByte == 0xf0 || statusByte == 0xff)
+        return dataSize + 1;
+
+    return MidiMessage::getMessageLengthFromFirstByte (statusByte);
+}
+
+void MidiFileReader::Event::copyRawData (uint8* destination) const noexcept
+{
+    auto size = getRawDataSize();
+    destination[0] = statusByte;
+
+    for (int i = 1; i < size; ++i)
+        destination[i] = getDataByte (i - 1);
+}
+
+MidiMessage MidiFileReader::Event::toMidiMessage() const
+{
+    auto size = getRawDataSize();
+
+    if (size <= 3)
+    {
+        uint8 buffer[3];
+        copyRawData (buffer);
+        return MidiMessage (buffer, size, (double) tick);
+    }
+
+    HeapBlock<uint8> buffer ((size_t) size);
+    copyRawData (buffer);
+    return MidiMessage (buffer, size, (double) tick);
+}
+
+//==============================================================================
+MidiFileReader::TrackReader::TrackReader (const uint8* trackData, size_t numBytes) noexcept
+    : data (trackData), remaining ((int) numBytes)
+{
+}
+
+bool MidiFileReader::TrackReader::next (Event& event) noexcept
+{
+    if (remaining <= 0)
+        return false;
+
+    const auto delay = MidiMessage::readVariableLengthValue (data, remaining);
+
+    if (! delay.isValid())
+        return finish();
+
+    data += delay.bytesUsed;
+    remaining -= delay.bytesUsed;
+    tick += delay.value;
+
+    if (remaining <= 0)
+        return finish();
+
+    auto statusByte = *data;
+
+    if (statusByte < 0x80)
+    {
+        // running status
+        statusByte = lastStatusByte;
+
+        if (statusByte < 0x80)
+            return finish();
+    }
+    else
+    {
+        ++data;
+        --remaining;
+    }
+
+    auto* eventData = data;
+    int dataSize = 0, numBytesUsed = 0;
+
+    if (statusByte == 0xf0)
+    {
+        // The sysex length bytes are skipped, and the message ends at its 0xf7
+        // or at the first byte with the high bit set after the length
+        auto* end = data + remaining;
+        auto* d = data;
+        bool haveReadAllLengthBytes = false;
+        int numLengthBytes = 0;
+
+        while (d < end)
+        {
+            if (*d >= 0x80)
+            {
+                if (*d == 0xf7)
+                {
+                    ++d;
+                    break;
+                }
+
+                if (haveReadAllLengthBytes)
+                    break;
+
+                ++numLengthBytes;
+            }
+            else if (! haveReadAllLengthBytes)
+            {
+                haveReadAllLengthBytes = true;
+                ++numLengthBytes;
+            }
+
+            ++d;
+        }
+
+        eventData = data + numLengthBytes;
+        dataSize = (int) (d - eventData);
+        numBytesUsed = (int) (d - data);
+    }
+    else if (statusByte == 0xff)
+    {
+        const auto length = MidiMessage::readVariableLengthValue (data + 1, remaining - 1);
+        dataSize = jmin (remaining, length.bytesUsed + 1 + length.value);
+        numBytesUsed = dataSize;
+    }
+    else
+    {
+        dataSize = jmin (remaining, MidiMessage::getMessageLengthFromFirstByte (statusByte) - 1);
+        numBytesUsed = dataSize;
+    }
+
+    data += numBytesUsed;
+    remaining -= numBytesUsed;
+
+    if ((statusByte & 0xf0) != 0xf0)
+        lastStatusByte = statusByte;
+
+    event.tick = tick;
+    event.statusByte = statusByte;
+    event.data = eventData;
+    event.dataSize = dataSize;
+    return true;
+}
+
+bool MidiFileReader::TrackReader::finish() noexcept
+{
+    remaining = 0;
+    return false;
+}
+
+//==============================================================================
+bool MidiFileReader::open (const void* fileData, size_t numBytes)
+{
+    tracks.clearQuick();
+    timeFormat = 0;
+    fileType = 0;
+
+    auto* d = static_cast<const uint8*> (fileData);
+    auto size = numBytes;
+
+    const auto optHeader = MidiFileHelpers::parseMidiHeader (d, size);
+
+    if (! optHeader.valid)
+        return false;
+
+    const auto header = optHeader.value;
+    timeFormat = header.timeFormat;
+    fileType = header.fileType;
+
+    d += header.bytesRead;
+    size -= (size_t) header.bytesRead;
+
+    for (int track = 0; track < header.numberOfTracks; ++track)
+    {
+        const auto optChunkType = MidiFileHelpers::tryRead<uint32> (d, size);
+
+        if (! optChunkType.valid)
+            return false;
+
+        const auto optChunkSize = MidiFileHelpers::tryRead<uint32> (d, size);
+
+        if (! optChunkSize.valid)
+            return false;
+
+        const auto chunkSize = optChunkSize.value;
+
+        if (size < chunkSize)
+            return false;
+
+        if (optChunkType.value == ByteOrder::bigEndianInt ("MTrk"))
+            tracks.add ({ d, (size_t) chunkSize });
+
+        size -= chunkSize;
+        d += chunkSize;
+    }
+
+    return size == 0;
+}
+
+MidiFileReader::TrackReader MidiFileReader::getTrack (int index) const noexcept
+{
+    if (! isPositiveAndBelow (index, tracks.size()))
+        return {};
+
+    auto& chunk = tracks.getReference (index);
+    return { chunk.data, chunk.size };
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiFileReaderTests  : public UnitTest
+{
+    MidiFileReaderTests()
+        : UnitTest ("MidiFileReader", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        MidiFile file;
+        file.setTicksPerQuarterNote (480);
+        file.addTrack (createTrack (getRandom(), 0));
+        file.addTrack (createTrack (getRandom(), 1));
+
+        MemoryOutputStream fileData;
+        file.writeTo (fileData, 1);
+
+        MidiFile expected;
+        MemoryInputStream input (fileData.getData(), fileData.getDataSize(), false);
+        expect (expected.readFrom (input, false));
+
+        beginTest ("Events match the ones that MidiFile reads");
+        {
+            MidiFileReader reader;
+            expect (reader.open (fileData.getData(), fileData.getDataSize()));
+            expectEquals (reader.getFileType(), 1);
+            expectEquals ((int) reader.getTimeFormat(), 480);
+            expectEquals (reader.getNumTracks(), expected.getNumTracks());
+
+            for (int i = 0; i < reader.getNumTracks(); ++i)
+            {
+                auto track = reader.getTrack (i);
+                auto& expectedTrack = *expected.getTrack (i);
+                int numEvents = 0;
+
+                for (MidiFileReader::Event e; track.next (e); ++numEvents)
+                {
+                    auto& m = expectedTrack.getEventPointer (numEvents)->message;
+                    auto message = e.toMidiMessage();
+
+                    expectEquals (message.getTimeStamp(), m.getTimeStamp());
+                    expect (message.getRawDataSize() == m.getRawDataSize()
+                              && std::equal (m.getRawData(), m.getRawData() + m.getRawDataSize(), message.getRawData()));
+                    expect (e.isNoteOn() == m.isNoteOn());
+                    expect (e.isNoteOff() == m.isNoteOff());
+                }
+
+                expectEquals (numEvents, expectedTrack.getNumEvents());
+            }
+        }
+
+        beginTest ("Invalid files are rejected");
+        {
+            MidiFileReader reader;
+            const uint8 notAMidiFile[] = { 'R', 'I', 'F', 'F', 0, 0 };
+            expect (! reader.open (notAMidiFile, sizeof (notAMidiFile)));
+            expect (! reader.open (fileData.getData(), fileData.getDataSize() - 1));
+        }
+
+        beginTest ("Writing a file read into CompactMidiSequences matches MidiFile");
+        {
+            MemoryOutputStream expectedData;
+            expected.writeTo (expectedData, 1);
+
+            MidiFileReader reader;
+            reader.open (fileData.getData(), fileData.getDataSize());
+
+            MemoryOutputStream rewritten;
+            MidiFileWriter writer (rewritten);
+            expect (writer.writeHeader (1, reader.getNumTracks(), reader.getTimeFormat()));
+
+            CompactMidiSequence sequence;
+
+            for (int i = 0; i < reader.getNumTracks(); ++i)
+            {
+                sequence.clear();
+                sequence.addEvents (reader.getTrack (i));
+
+                writer.startTrack();
+                writer.addEvents (sequence);
+                expect (writer.finishTrack());
+            }
+
+            expect (rewritten.getMemoryBlock() == expectedData.getMemoryBlock());
+        }
+    }
+
+    static MidiMessageSequence createTrack (Random random, int channelOffset)
+    {
+        MidiMessageSequence track;
+        track.addEvent (MidiMessage::tempoMetaEvent (500000));
+        track.addEvent (MidiMessage::textMetaEvent (3, "Track " + String (channelOffset)));
+
+        double time = 0;
+
+        for (int i = 0; i < 200; ++i)
+        {
+            auto channel = 1 + channelOffset + random.nextInt (2);
+            auto note = 40 + random.nextInt (30);
+            time += 2 * random.nextInt (50);
+
+            track.addEvent (MidiMessage::noteOn (channel, note, (uint8) (1 + random.nextInt (127))).withTimeStamp (time));
+            track.addEvent (MidiMessage::noteOff (channel, note).withTimeStamp (time + 2 * (1 + random.nextInt (200))));
+
+            // (these go at odd times, so that they don't affect the order of the notes)
+            if (random.nextInt (20) == 0)
+            {
+                const uint8 sysexData[] = { 0x7e, 0x7f, 0x09, 0x01 };
+                track.addEvent (MidiMessage::createSysExMessage (sysexData, (int) sizeof (sysexData)).withTimeStamp (time + 1));
+            }
+        }
+
+        track.sort();
+        return track;
+    }
+};
+
+static MidiFileReaderTests midiFileReaderTests;
+
+#endif
+
+} // namespace juce
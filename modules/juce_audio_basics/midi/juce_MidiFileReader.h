@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Iterates the events in a standard midi file without copying it.
+
+    Unlike MidiFile::readFrom(), which loads a whole file and creates a heap-allocated
+    MidiMessage for every event, this reads the events directly from a block of
+    memory that you provide, such as a MemoryMappedFile. Apart from a small array of
+    track positions (which is reused if you call open() again), nothing is allocated,
+    so it's well-suited to scanning large numbers of files.
+
+    @code
+    MemoryMappedFile mapped (file, MemoryMappedFile::readOnly);
+    MidiFileReader reader;
+
+    if (mapped.getData() != nullptr && reader.open (mapped.getData(), mapped.getSize()))
+    {
+        for (int i = 0; i < reader.getNumTracks(); ++i)
+        {
+            auto track = reader.getTrack (i);
+
+            for (MidiFileReader::Event e; track.next (e);)
+                if (e.isNoteOn())
+                    ++numNotes;
+        }
+    }
+    @endcode
+
+    The events are parsed exactly as MidiFile parses them, and the times are in
+    midi ticks, as they are before MidiFile::convertTimestampTicksToSeconds() is called.
+
+    @see MidiFile, MidiFileWriter, CompactMidiSequence
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiFileReader
+{
+public:
+    //==============================================================================
+    /** A single event in a midi file track.
+
+        The event's data points into the block of memory that the reader was opened
+        with, so it's only valid as long as that memory is.
+    */
+    struct JUCE_API  Event
+    {
+        /** The time of the event, in ticks from the start of the track. */
+        int64 tick = 0;
+
+        /** The status byte of the event. For messages that use running status, this
+            is the status byte of the previous channel message.
+        */
+        uint8 statusByte = 0;
+
+        /** The bytes that follow the status byte, in the form that MidiMessage stores
+            them. For a sysex, the length bytes are skipped, and for a meta-event, this
+            starts with the meta-event type.
+        */
+        const uint8* data = nullptr;
+
+        /** The number of bytes that data points to. This can be less than the
+            message needs if the track was truncated - see getDataByte().
+        */
+        int dataSize = 0;
+
+        /** Returns one of the bytes that follow the status byte, or 0 if it's missing. */
+        uint8 getDataByte (int index) const noexcept        { return index < dataSize ? data[index] : 0; }
+
+        /** Returns the number of bytes in the equivalent MidiMessage's raw data. */
+        int getRawDataSize() const noexcept;
+
+        /** Writes the equivalent MidiMessage's raw data to a buffer, which must have
+            space for getRawDataSize() bytes.
+        */
+        void copyRawData (uint8* destination) const noexcept;
+
+        /** Returns true if this is a note-on with a non-zero velocity. */
+        bool isNoteOn() const noexcept                      { return (statusByte & 0xf0) == 0x90 && getDataByte (1) != 0; }
+
+        /** Returns true if this is a note-off, or a note-on with a velocity of zero. */
+        bool isNoteOff() const noexcept                     { return (statusByte & 0xf0) == 0x80 || ((statusByte & 0xf0) == 0x90 && getDataByte (1) == 0); }
+
+        /** Returns true if this is a sysex message. */
+        bool isSysEx() const noexcept                       { return statusByte == 0xf0; }
+
+        /** Returns true if this is a meta-event. */
+        bool isMetaEvent() const noexcept                   { return statusByte == 0xff; }
+
+        /** Returns the type of a meta-event, or -1 if this isn't one. */
+        int getMetaEventType() const noexcept               { return isMetaEvent() && dataSize > 0 ? data[0] : -1; }
+
+        /** Creates a MidiMessage from this event, using the tick as its timestamp. */
+        MidiMessage toMidiMessage() const;
+    };
+
+    //==============================================================================
+    /** Reads the events of one track, in order. */
+    class JUCE_API  TrackReader
+    {
+    public:
+        /** Creates a reader with no events. */
+        TrackReader() = default;
+
+        /** Creates a reader for the contents of an MTrk chunk. */
+        TrackReader (const uint8* trackData, size_t numBytes) noexcept;
+
+        /** Reads the next event, returning false when there are no more. */
+        bool next (Event& event) noexcept;
+
+    private:
+        bool finish() noexcept;
+
+        const uint8* data = nullptr;
+        int remaining = 0;
+        int64 tick = 0;
+        uint8 lastStatusByte = 0;
+    };
+
+    //==============================================================================
+    /** Creates a reader that hasn't been opened. */
+    MidiFileReader() = default;
+
+    /** Parses the header and locates the tracks of a midi file in a block of memory.
+
+        The memory must stay valid while the reader and its events are in use. This
+        returns false if the file isn't valid, although any tracks that were found
+        before the problem can still be read.
+    */
+    bool open (const void* fileData, size_t numBytes);
+
+    /** Returns the midi file type (0, 1 or 2) from the file's header. */
+    int getFileType() const noexcept                        { return fileType; }
+
+    /** Returns the raw time format code from the file's header.
+        @see MidiFile::getTimeFormat
+    */
+    short getTimeFormat() const noexcept                    { return timeFormat; }
+
+    /** Returns the number of tracks that were found. */
+    int getNumTracks() const noexcept                       { return tracks.size(); }
+
+    /** Returns a reader for one of the tracks. */
+    TrackReader getTrack (int index) const noexcept;
+
+private:
+    //==============================================================================
+    struct Chunk
+    {
+        const uint8* data;
+        size_t size;
+    };
+
+    Array<Chunk> tracks;
+    short timeFormat = 0, fileType = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiFileReader)
+};
+
+} // namespace juce
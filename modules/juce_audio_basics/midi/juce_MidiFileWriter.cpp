@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+MidiFileWriter::MidiFileWriter (OutputStream& destination)
+    : output (destination)
+{
+}
+
+bool MidiFileWriter::writeHeader (int midiFileType, int numTracks, short timeFormat)
+{
+    jassert (midiFileType >= 0 && midiFileType <= 2);
+
+    return output.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MThd"))
+        && output.writeIntBigEndian (6)
+        && output.writeShortBigEndian ((short) midiFileType)
+        && output.writeShortBigEndian ((short) numTracks)
+        && output.writeShortBigEndian (timeFormat);
+}
+
+void MidiFileWriter::startTrack()
+{
+    track.reset();
+    lastTick = 0;
+    lastStatusByte = 0;
+    endOfTrackEventWritten = false;
+}
+
+void MidiFileWriter::addEvent (double tickTime, const uint8* data, int dataSize)
+{
+    jassert (dataSize > 0);
+
+    if (data[0] == 0xff && dataSize > 1 && data[1] == 0x2f)
+        endOfTrackEventWritten = true;
+
+    auto tick = roundToInt (tickTime);
+    MidiFileHelpers::writeVariableLengthInt (track, (uint32) jmax (0, tick - lastTick));
+    lastTick = tick;
+
+    auto statusByte = data[0];
+
+    if (statusByte == lastStatusByte
+         && (statusByte & 0xf0) != 0xf0
+         && dataSize > 1)
+    {
+        ++data;
+        --dataSize;
+    }
+    else if (statusByte == 0xf0)  // Write sysex message with length bytes.
+    {
+        track.writeByte ((char) statusByte);
+
+        ++data;
+        --dataSize;
+
+        MidiFileHelpers::writeVariableLengthInt (track, (uint32) dataSize);
+    }
+
+    track.write (data, (size_t) dataSize);
+    lastStatusByte = statusByte;
+}
+
+void MidiFileWriter::addEvent (const MidiMessage& message)
+{
+    addEvent (message.getTimeStamp(), message.getRawData(), message.getRawDataSize());
+}
+
+void MidiFileWriter::addEvents (const CompactMidiSequence& sequence)
+{
+    for (int i = 0; i < sequence.getNumEvents(); ++i)
+        addEvent (sequence.getEventTime (i), sequence.getRawData (i), sequence.getRawDataSize (i));
+}
+
+bool MidiFileWriter::finishTrack()
+{
+    if (! endOfTrackEventWritten)
+    {
+        track.writeByte (0); // (tick delta)
+        const uint8 endOfTrack[] = { 0xff, 0x2f, 0x00 };
+        track.write (endOfTrack, sizeof (endOfTrack));
+    }
+
+    if (! output.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MTrk"))) return false;
+    if (! output.writeIntBigEndian ((int) track.getDataSize()))                return false;
+
+    return output.write (track.getData(), track.getDataSize());
+}
+
+} // namespace juce
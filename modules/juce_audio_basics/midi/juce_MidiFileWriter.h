@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Writes a standard midi file to a stream, one event at a time.
+
+    This produces the same output as MidiFile::writeTo(), but the events can come
+    from anywhere, so a file can be written without building a MidiMessageSequence
+    for each track. The buffer that holds each track until it's finished is reused,
+    so once it has grown to the size of the largest track, writing doesn't allocate.
+
+    @code
+    MidiFileWriter writer (stream);
+    writer.writeHeader (1, 1, 960);
+
+    writer.startTrack();
+    writer.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100).withTimeStamp (0));
+    writer.addEvent (MidiMessage::noteOff (1, 60).withTimeStamp (960));
+    writer.finishTrack();
+    @endcode
+
+    @see MidiFile, MidiFileReader, CompactMidiSequence
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiFileWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer for a stream, which must stay valid while it's in use. */
+    explicit MidiFileWriter (OutputStream& destination);
+
+    //==============================================================================
+    /** Writes the file's header. This must be called once, before any tracks are written.
+
+        @param midiFileType     the type of file, 0, 1 or 2
+        @param numTracks        the number of tracks that will be written
+        @param timeFormat       the raw time format code - see MidiFile::getTimeFormat()
+    */
+    bool writeHeader (int midiFileType, int numTracks, short timeFormat);
+
+    /** Begins a new track. */
+    void startTrack();
+
+    /** Adds an event to the current track.
+
+        The time is in ticks, and events must be added in time order.
+        @param tick         the time of the event
+        @param rawData      the message, in the same form as MidiMessage::getRawData()
+        @param numBytes     the size of the message
+    */
+    void addEvent (double tick, const uint8* rawData, int numBytes);
+
+    /** Adds a message to the current track, using its timestamp as the time in ticks. */
+    void addEvent (const MidiMessage& message);
+
+    /** Adds all the events in a sequence to the current track. */
+    void addEvents (const CompactMidiSequence& sequence);
+
+    /** Finishes the current track, adding an end-of-track event if there wasn't one,
+        and writes it to the stream.
+    */
+    bool finishTrack();
+
+private:
+    //==============================================================================
+    OutputStream& output;
+    MemoryOutputStream track;
+    int lastTick = 0;
+    uint8 lastStatusByte = 0;
+    bool endOfTrackEventWritten = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiFileWriter)
+};
+
+} // namespace juce
@@ -102,6 +102,19 @@ int MidiMessageSequence::getIndexOfMatchingKeyUp (int index) const noexcept
     {
         if (auto* noteOff = meh->noteOffObject)
         {
+            // the note-off will normally be among the events with its own timestamp..
+            for (int i = jmax (index, getNextIndexAtTime (noteOff->message.getTimeStamp())); i < list.size(); ++i)
+            {
+                auto* e = list.getUnchecked(i);
+
+                if (e == noteOff)
+                    return i;
+
+                if (e->message.getTimeStamp() > noteOff->message.getTimeStamp())
+                    break;
+            }
+
+            // ..but if the sequence hasn't been kept sorted, it could be anywhere
             for (int i = index; i < list.size(); ++i)
                 if (list.getUnchecked(i) == noteOff)
                     return i;
@@ -120,14 +133,10 @@ int MidiMessageSequence::getIndexOf (const MidiEventHolder* event) const noexcep
 
 int MidiMessageSequence::getNextIndexAtTime (double timeStamp) const noexcept
 {
-    auto numEvents = list.size();
-    int i;
-
-    for (i = 0; i < numEvents; ++i)
-        if (list.getUnchecked(i)->message.getTimeStamp() >= timeStamp)
-            break;
+    auto position = std::lower_bound (list.begin(), list.end(), timeStamp,
+                                      [] (const MidiEventHolder* e, double t) { return e->message.getTimeStamp() < t; });
 
-    return i;
+    return (int) std::distance (list.begin(), position);
 }
 
 //==============================================================================
@@ -154,13 +163,11 @@ MidiMessageSequence::MidiEventHolder* MidiMessageSequence::addEvent (MidiEventHo
 {
     newEvent->message.addToTimeStamp (timeAdjustment);
     auto time = newEvent->message.getTimeStamp();
-    int i;
 
-    for (i = list.size(); --i >= 0;)
-        if (list.getUnchecked(i)->message.getTimeStamp() <= time)
-            break;
+    auto position = std::upper_bound (list.begin(), list.end(), time,
+                                      [] (double t, const MidiEventHolder* e) { return t < e->message.getTimeStamp(); });
 
-    list.insert (i + 1, newEvent);
+    list.insert ((int) std::distance (list.begin(), position), newEvent);
     return newEvent;
 }
 
@@ -225,42 +232,72 @@ void MidiMessageSequence::sort() noexcept
 
 void MidiMessageSequence::updateMatchedPairs() noexcept
 {
-    for (int i = 0; i < list.size(); ++i)
+    constexpr int numNotes = 16 * 128;
+    MidiEventHolder* pendingNoteOns[numNotes] = {};
+
+    auto getNoteIndex = [] (const MidiMessage& m) { return ((m.getChannel() - 1) << 7) | m.getNoteNumber(); };
+
+    // A note-on is matched by the next note-off for the same note. If the note is
+    // retriggered first, a note-off is inserted just before the new note-on.
+    int numNoteOffsNeeded = 0;
+
+    for (auto* meh : list)
     {
-        auto* meh = list.getUnchecked(i);
-        auto& m1 = meh->message;
+        auto& m = meh->message;
 
-        if (m1.isNoteOn())
+        if (m.isNoteOn())
         {
+            auto& pending = pendingNoteOns[getNoteIndex (m)];
+
+            if (pending != nullptr)
+                ++numNoteOffsNeeded;
+
             meh->noteOffObject = nullptr;
-            auto note = m1.getNoteNumber();
-            auto chan = m1.getChannel();
-            auto len = list.size();
+            pending = meh;
+        }
+        else if (m.isNoteOff())
+        {
+            auto& pending = pendingNoteOns[getNoteIndex (m)];
 
-            for (int j = i + 1; j < len; ++j)
-            {
-                auto* meh2 = list.getUnchecked(j);
-                auto& m = meh2->message;
+            if (pending != nullptr)
+                pending->noteOffObject = meh;
 
-                if (m.getNoteNumber() == note && m.getChannel() == chan)
-                {
-                    if (m.isNoteOff())
-                    {
-                        meh->noteOffObject = meh2;
-                        break;
-                    }
-
-                    if (m.isNoteOn())
-                    {
-                        auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
-                        list.insert (j, newEvent);
-                        newEvent->message.setTimeStamp (m.getTimeStamp());
-                        meh->noteOffObject = newEvent;
-                        break;
-                    }
-                }
+            pending = nullptr;
+        }
+    }
+
+    if (numNoteOffsNeeded == 0)
+        return;
+
+    // Rebuild the list in a single pass, rather than inserting each note-off separately
+    Array<MidiEventHolder*> oldList (list.getRawDataPointer(), list.size());
+    list.clearQuick (false);
+    list.ensureStorageAllocated (oldList.size() + numNoteOffsNeeded);
+    std::fill (std::begin (pendingNoteOns), std::end (pendingNoteOns), nullptr);
+
+    for (auto* meh : oldList)
+    {
+        auto& m = meh->message;
+
+        if (m.isNoteOn())
+        {
+            auto& pending = pendingNoteOns[getNoteIndex (m)];
+
+            if (pending != nullptr)
+            {
+                auto* noteOff = list.add (new MidiEventHolder (MidiMessage::noteOff (m.getChannel(), m.getNoteNumber())));
+                noteOff->message.setTimeStamp (m.getTimeStamp());
+                pending->noteOffObject = noteOff;
             }
+
+            pending = meh;
+        }
+        else if (m.isNoteOff())
+        {
+            pendingNoteOns[getNoteIndex (m)] = nullptr;
         }
+
+        list.add (meh);
     }
 }
 
@@ -537,6 +574,24 @@ struct MidiMessageSequenceTest  : public UnitTest
         expectEquals (s.getIndexOfMatchingKeyUp (0), -1); // Truncated note, should be no note off
         expectEquals (s.getTimeOfMatchingKeyUp (1), 5.0);
 
+        beginTest ("Retriggered notes get note-offs");
+        {
+            MidiMessageSequence r;
+            r.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (0.0));
+            r.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (2.0));
+            r.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (3.0));
+            r.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (4.0));
+            r.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (5.0));
+            r.updateMatchedPairs();
+
+            expectEquals (r.getNumEvents(), 6);
+            expect (r.getEventPointer (1)->message.isNoteOff());
+            expectEquals (r.getEventTime (1), 2.0);
+            expectEquals (r.getIndexOfMatchingKeyUp (0), 1);
+            expectEquals (r.getIndexOfMatchingKeyUp (2), 3);
+            expectEquals (r.getIndexOfMatchingKeyUp (5), -1);
+        }
+
         struct ControlValue { int control, value; };
 
         struct DataEntry
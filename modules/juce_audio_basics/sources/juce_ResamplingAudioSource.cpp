@@ -39,27 +39,98 @@ void ResamplingAudioSource::setResamplingRatio (const double samplesInPerOutputS
 {
     jassert (samplesInPerOutputSample > 0);
 
-    const SpinLock::ScopedLockType sl (ratioLock);
-    ratio = jmax (0.0, samplesInPerOutputSample);
+    {
+        const SpinLock::ScopedLockType sl (ratioLock);
+        ratio = jmax (0.0, samplesInPerOutputSample);
+    }
+
+    if (samplesInPerOutputSample > polyphaseMaximumRatio.load())
+        preparePolyphaseResamplerForRatio (samplesInPerOutputSample);
 }
 
 void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
 {
-    const SpinLock::ScopedLockType sl (ratioLock);
+    const SpinLock::ScopedLockType ratioSl (ratioLock);
 
     auto scaledBlockSize = roundToInt (samplesPerBlockExpected * ratio);
     input->prepareToPlay (scaledBlockSize, sampleRate * ratio);
 
     buffer.setSize (numChannels, scaledBlockSize + 32);
+    blockSizeExpected = samplesPerBlockExpected;
 
     filterStates.calloc (numChannels);
     srcBuffers.calloc (numChannels);
     destBuffers.calloc (numChannels);
     createLowPass (ratio);
 
+    {
+        const ScopedLock sl (callbackLock);
+
+        if (polyphaseResampler != nullptr)
+        {
+            polyphaseResampler->prepare (numChannels, jmax (1.0, ratio));
+            polyphaseMaximumRatio = polyphaseResampler->getMaximumSpeedRatio();
+        }
+    }
+
     flushBuffers();
 }
 
+void ResamplingAudioSource::setPolyphaseResamplingEnabled (bool shouldBeEnabled, PolyphaseResampler::Quality quality)
+{
+    std::unique_ptr<PolyphaseResampler> newResampler;
+
+    if (shouldBeEnabled)
+    {
+        newResampler = std::make_unique<PolyphaseResampler> (quality);
+
+        const SpinLock::ScopedLockType sl (ratioLock);
+        newResampler->prepare (numChannels, jmax (1.0, ratio));
+    }
+
+    {
+        const ScopedLock sl (callbackLock);
+        std::swap (polyphaseResampler, newResampler);
+
+        polyphaseMaximumRatio = polyphaseResampler != nullptr ? polyphaseResampler->getMaximumSpeedRatio()
+                                                              : std::numeric_limits<double>::max();
+    }
+
+    flushBuffers();
+}
+
+void ResamplingAudioSource::preparePolyphaseResamplerForRatio (double newRatio)
+{
+    // The new resampler's kernels are calculated here rather than on the audio thread,
+    // which will just clamp the ratio until the new resampler has been swapped in
+    auto quality = PolyphaseResampler::Quality::medium;
+
+    {
+        const ScopedLock sl (callbackLock);
+
+        if (polyphaseResampler == nullptr || newRatio <= polyphaseResampler->getMaximumSpeedRatio())
+            return;
+
+        quality = polyphaseResampler->getQuality();
+    }
+
+    auto newResampler = std::make_unique<PolyphaseResampler> (quality);
+    newResampler->prepare (numChannels, newRatio);
+
+    const ScopedLock sl (callbackLock);
+
+    if (polyphaseResampler == nullptr || newRatio <= polyphaseResampler->getMaximumSpeedRatio())
+        return;
+
+    std::swap (polyphaseResampler, newResampler);
+    polyphaseMaximumRatio = polyphaseResampler->getMaximumSpeedRatio();
+
+    const auto numNeeded = roundToInt (blockSizeExpected * polyphaseMaximumRatio.load()) + 32;
+
+    if (buffer.getNumSamples() < numNeeded)
+        buffer.setSize (numChannels, numNeeded, false, false, true);
+}
+
 void ResamplingAudioSource::flushBuffers()
 {
     const ScopedLock sl (callbackLock);
@@ -69,6 +140,9 @@ void ResamplingAudioSource::flushBuffers()
     sampsInBuffer = 0;
     subSampleOffset = 0.0;
     resetFilters();
+
+    if (polyphaseResampler != nullptr)
+        polyphaseResampler->reset();
 }
 
 void ResamplingAudioSource::releaseResources()
@@ -88,6 +162,12 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
         localRatio = ratio;
     }
 
+    if (polyphaseResampler != nullptr)
+    {
+        getNextPolyphaseBlock (info, localRatio);
+        return;
+    }
+
     if (lastRatio != localRatio)
     {
         createLowPass (localRatio);
@@ -195,6 +275,32 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     jassert (sampsInBuffer >= 0);
 }
 
+void ResamplingAudioSource::getNextPolyphaseBlock (const AudioSourceChannelInfo& info, double localRatio)
+{
+    // The polyphase resampler keeps its own history, so the input is always read into
+    // the start of the buffer, and exactly as much as is needed is read each time
+    const auto numNeeded = polyphaseResampler->getNumInputSamplesNeeded (localRatio, info.numSamples);
+
+    if (buffer.getNumSamples() < numNeeded)
+        buffer.setSize (numChannels, numNeeded, false, false, true);
+
+    if (numNeeded > 0)
+    {
+        AudioSourceChannelInfo readInfo (&buffer, 0, numNeeded);
+        input->getNextAudioBlock (readInfo);
+    }
+
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+
+    for (int channel = 0; channel < channelsToProcess; ++channel)
+    {
+        destBuffers[channel] = info.buffer->getWritePointer (channel, info.startSample);
+        srcBuffers[channel] = buffer.getReadPointer (channel);
+    }
+
+    polyphaseResampler->process (localRatio, srcBuffers, destBuffers, channelsToProcess, info.numSamples);
+}
+
 void ResamplingAudioSource::createLowPass (const double frequencyRatio)
 {
     const double proportionalRate = (frequencyRatio > 1.0) ? 0.5 / frequencyRatio
@@ -262,4 +368,115 @@ void ResamplingAudioSource::applyFilter (float* samples, int num, FilterState& f
     }
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ResamplingAudioSourceTests  : public UnitTest
+{
+public:
+    ResamplingAudioSourceTests()
+        : UnitTest ("ResamplingAudioSource", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Polyphase resampling preserves passband signals");
+        {
+            for (auto ratio : { 0.5, 1.0, 1.5 })
+                expectWithinAbsoluteError (getOutputLevel (ratio, ratio, 0.05), 1.0, 0.02);
+        }
+
+        beginTest ("Downsampling removes content above the new Nyquist frequency");
+        {
+            expectLessThan (getOutputLevel (2.0, 2.0, 0.35), 0.01);
+        }
+
+        beginTest ("Raising the ratio after preparing switches to a kernel for the new ratio");
+        {
+            // Prepared for a ratio of 1, this tone would come straight through and alias
+            expectLessThan (getOutputLevel (1.0, 2.0, 0.35), 0.01);
+        }
+
+        beginTest ("Only the input that's needed is read");
+        {
+            for (auto ratio : { 0.73, 1.0, 2.6 })
+            {
+                SineSource sine (0.05);
+                ResamplingAudioSource source (&sine, false, 1);
+                source.setPolyphaseResamplingEnabled (true);
+                source.setResamplingRatio (ratio);
+                source.prepareToPlay (blockSize, 44100.0);
+
+                AudioBuffer<float> output (1, blockSize);
+                int numOutputSamples = 0;
+
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    const auto numSamples = 1 + (block * 97) % blockSize;
+                    source.getNextAudioBlock ({ &output, 0, numSamples });
+                    numOutputSamples += numSamples;
+                }
+
+                expectWithinAbsoluteError ((double) sine.position, numOutputSamples * ratio, 2.0);
+            }
+        }
+    }
+
+private:
+    static constexpr int blockSize = 512, numBlocks = 32;
+
+    // An endless sine wave, which counts the samples that have been read from it
+    struct SineSource  : public AudioSource
+    {
+        explicit SineSource (double normalisedFrequency)  : frequency (normalisedFrequency) {}
+
+        void prepareToPlay (int, double) override   {}
+        void releaseResources() override            {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            for (int i = 0; i < info.numSamples; ++i)
+            {
+                const auto sample = (float) std::sin (MathConstants<double>::twoPi * frequency * (double) position++);
+
+                for (int channel = 0; channel < info.buffer->getNumChannels(); ++channel)
+                    info.buffer->setSample (channel, info.startSample + i, sample);
+            }
+        }
+
+        const double frequency;
+        int64 position = 0;
+    };
+
+    // Returns the peak level of the output in the second half of the run, after the start-up transient
+    static double getOutputLevel (double preparedRatio, double ratio, double normalisedFrequency)
+    {
+        SineSource sine (normalisedFrequency);
+        ResamplingAudioSource source (&sine, false, 1);
+        source.setPolyphaseResamplingEnabled (true);
+        source.setResamplingRatio (preparedRatio);
+        source.prepareToPlay (blockSize, 44100.0);
+        source.setResamplingRatio (ratio);
+
+        AudioBuffer<float> output (1, blockSize);
+        float peak = 0.0f;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            source.getNextAudioBlock ({ &output, 0, blockSize });
+
+            if (block >= numBlocks / 2)
+                peak = jmax (peak, output.getMagnitude (0, 0, blockSize));
+        }
+
+        return peak;
+    }
+};
+
+static ResamplingAudioSourceTests resamplingAudioSourceTests;
+
+#endif
+
 } // namespace juce
@@ -27,7 +27,11 @@ namespace juce
 /**
     A type of AudioSource that takes an input source and changes its sample rate.
 
-    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator
+    By default this uses a simple low-pass filter and linear interpolation, which is
+    cheap but not very accurate. Call setPolyphaseResamplingEnabled() to use a
+    PolyphaseResampler instead.
+
+    @see AudioSource, PolyphaseResampler, LagrangeInterpolator, CatmullRomInterpolator
 
     @tags{Audio}
 */
@@ -53,6 +57,11 @@ public:
 
         (This value can be changed at any time, even while the source is running).
 
+        If the polyphase resampler is enabled, and the ratio is higher than any it has
+        been prepared for, this call prepares a new resampler before returning, so that
+        the audio thread doesn't have to. If you'll be changing the ratio from the audio
+        thread, set the highest ratio you'll need before playback starts.
+
         @param samplesInPerOutputSample     if set to 1.0, the input is passed through; higher
                                             values will speed it up; lower values will slow it
                                             down. The ratio must be greater than 0
@@ -68,6 +77,18 @@ public:
     /** Clears any buffers and filters that the resampler is using. */
     void flushBuffers();
 
+    /** Switches between the default filter and linear interpolation, and a much higher
+        quality PolyphaseResampler.
+
+        The polyphase resampler adds PolyphaseResampler::getLatencyInInputSamples() samples
+        of latency, measured at the input's sample rate.
+    */
+    void setPolyphaseResamplingEnabled (bool shouldBeEnabled,
+                                        PolyphaseResampler::Quality quality = PolyphaseResampler::Quality::medium);
+
+    /** Returns true if setPolyphaseResamplingEnabled() has been used to turn on the polyphase resampler. */
+    bool isPolyphaseResamplingEnabled() const noexcept          { return polyphaseResampler != nullptr; }
+
     //==============================================================================
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
     void releaseResources() override;
@@ -86,6 +107,9 @@ private:
     const int numChannels;
     HeapBlock<float*> destBuffers;
     HeapBlock<const float*> srcBuffers;
+    std::unique_ptr<PolyphaseResampler> polyphaseResampler;
+    std::atomic<double> polyphaseMaximumRatio { std::numeric_limits<double>::max() };
+    int blockSizeExpected = 0;
 
     void setFilterCoefficients (double c1, double c2, double c3, double c4, double c5, double c6);
     void createLowPass (double proportionalRate);
@@ -99,6 +123,8 @@ private:
     void resetFilters();
 
     void applyFilter (float* samples, int num, FilterState& fs);
+    void getNextPolyphaseBlock (const AudioSourceChannelInfo&, double localRatio);
+    void preparePolyphaseResamplerForRatio (double newRatio);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResamplingAudioSource)
 };
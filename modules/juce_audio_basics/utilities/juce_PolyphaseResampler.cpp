@@ -0,0 +1,363 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace PolyphaseResamplerHelpers
+{
+    struct Preset
+    {
+        int numTaps, numPhases;
+        double rolloff, kaiserBeta;
+    };
+
+    static Preset getPreset (PolyphaseResampler::Quality quality) noexcept
+    {
+        switch (quality)
+        {
+            case PolyphaseResampler::Quality::low:     return { 16, 64,  0.85, 6.0 };
+            case PolyphaseResampler::Quality::high:    return { 64, 256, 0.95, 10.0 };
+            case PolyphaseResampler::Quality::medium:
+            default:                                   break;
+        }
+
+        return { 32, 128, 0.91, 8.0 };
+    }
+
+    static double besselI0 (double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+        const auto halfX = x * 0.5;
+
+        for (int k = 1; k < 50 && term > sum * 1.0e-12; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    static int roundUpToMultipleOf4 (double value) noexcept
+    {
+        return ((int) std::ceil (value) + 3) & ~3;
+    }
+
+    static constexpr double stretchStepsPerUnit = 8.0;
+
+    static double quantiseStretch (double speedRatio) noexcept
+    {
+        return jmax (1.0, std::ceil (speedRatio * stretchStepsPerUnit) / stretchStepsPerUnit);
+    }
+
+    static int getStretchIndex (double stretch) noexcept
+    {
+        return roundToInt ((stretch - 1.0) * stretchStepsPerUnit);
+    }
+
+    // Four separate accumulators let the compiler vectorise this without reassociating
+    static void dotProducts (const float* window, const float* c0, const float* c1, int num,
+                             float& result0, float& result1) noexcept
+    {
+        float a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+        float b0 = 0, b1 = 0, b2 = 0, b3 = 0;
+
+        for (int i = 0; i < num; i += 4)
+        {
+            a0 += window[i]     * c0[i];        b0 += window[i]     * c1[i];
+            a1 += window[i + 1] * c0[i + 1];    b1 += window[i + 1] * c1[i + 1];
+            a2 += window[i + 2] * c0[i + 2];    b2 += window[i + 2] * c1[i + 2];
+            a3 += window[i + 3] * c0[i + 3];    b3 += window[i + 3] * c1[i + 3];
+        }
+
+        result0 = (a0 + a1) + (a2 + a3);
+        result1 = (b0 + b1) + (b2 + b3);
+    }
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler (Quality q)
+    : quality (q),
+      baseNumTaps (PolyphaseResamplerHelpers::getPreset (q).numTaps),
+      numPhases (PolyphaseResamplerHelpers::getPreset (q).numPhases),
+      rolloff (PolyphaseResamplerHelpers::getPreset (q).rolloff),
+      kaiserBeta (PolyphaseResamplerHelpers::getPreset (q).kaiserBeta)
+{
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+void PolyphaseResampler::prepare (int numChannels, double maximumSpeedRatio)
+{
+    jassert (numChannels > 0 && maximumSpeedRatio > 0);
+
+    using namespace PolyphaseResamplerHelpers;
+
+    maximumRatio = quantiseStretch (maximumSpeedRatio);
+    maxNumTaps = roundUpToMultipleOf4 (baseNumTaps * maximumRatio);
+    numChannelsPrepared = numChannels;
+
+    // Each step of the ratio gets its own bank of numPhases + 1 rows, as long as its kernel
+    kernels.resize ((size_t) getStretchIndex (maximumRatio) + 1);
+    size_t totalSize = 0;
+
+    for (size_t i = 0; i < kernels.size(); ++i)
+    {
+        const auto stretch = 1.0 + (double) i / stretchStepsPerUnit;
+        kernels[i] = { totalSize, jmin (maxNumTaps, roundUpToMultipleOf4 (baseNumTaps * stretch)) };
+        totalSize += (size_t) ((numPhases + 1) * kernels[i].numTaps);
+    }
+
+    coefficients.calloc (totalSize);
+    history.calloc ((size_t) (numChannels * 2 * maxNumTaps));
+
+    for (size_t i = 0; i < kernels.size(); ++i)
+        calculateKernel (kernels[i], 1.0 + (double) i / stretchStepsPerUnit);
+
+    reset();
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    if (history != nullptr)
+        history.clear ((size_t) (numChannelsPrepared * 2 * maxNumTaps));
+
+    writeIndex = 0;
+    subSamplePos = 1.0;
+}
+
+const PolyphaseResampler::Kernel& PolyphaseResampler::getKernelForRatio (double speedRatio) const noexcept
+{
+    const auto stretch = jmin (maximumRatio, PolyphaseResamplerHelpers::quantiseStretch (speedRatio));
+    const auto index = jlimit (0, (int) kernels.size() - 1, PolyphaseResamplerHelpers::getStretchIndex (stretch));
+    return kernels[(size_t) index];
+}
+
+void PolyphaseResampler::calculateKernel (const Kernel& kernel, double stretch) noexcept
+{
+    const auto numTaps = kernel.numTaps;
+    const auto cutoff = rolloff / stretch;
+    const auto halfLength = numTaps * 0.5;
+    const auto windowScale = 1.0 / PolyphaseResamplerHelpers::besselI0 (kaiserBeta);
+
+    for (int phase = 0; phase <= numPhases; ++phase)
+    {
+        auto* row = coefficients + kernel.offset + (size_t) (phase * numTaps);
+        const auto fraction = phase / (double) numPhases;
+        double sum = 0.0;
+
+        // Tap k is applied to the k'th oldest sample in the window, so its distance from
+        // the output position is (halfLength - 1 - k + fraction)
+        for (int k = 0; k < numTaps; ++k)
+        {
+            const auto x = halfLength - 1.0 - k + fraction;
+            const auto normalisedPosition = x / halfLength;
+
+            if (std::abs (normalisedPosition) >= 1.0)
+            {
+                row[k] = 0.0f;
+                continue;
+            }
+
+            const auto t = MathConstants<double>::pi * cutoff * x;
+            const auto sinc = t == 0.0 ? 1.0 : std::sin (t) / t;
+            const auto window = PolyphaseResamplerHelpers::besselI0 (kaiserBeta * std::sqrt (1.0 - normalisedPosition * normalisedPosition)) * windowScale;
+            const auto value = sinc * window;
+
+            row[k] = (float) value;
+            sum += value;
+        }
+
+        // normalise each phase to unity gain at DC, which also removes any ripple between phases
+        if (sum != 0.0)
+            FloatVectorOperations::multiply (row, (float) (1.0 / sum), numTaps);
+    }
+}
+
+int PolyphaseResampler::getNumInputSamplesNeeded (double speedRatio, int numOutputSamples) const noexcept
+{
+    // This has to follow exactly the same arithmetic as process() to agree with it
+    auto pos = subSamplePos;
+    int numNeeded = 0;
+
+    for (int i = 0; i < numOutputSamples; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            ++numNeeded;
+            pos -= 1.0;
+        }
+
+        pos += speedRatio;
+    }
+
+    return numNeeded;
+}
+
+int PolyphaseResampler::process (double speedRatio,
+                                 const float* const* inputs,
+                                 float* const* outputs,
+                                 int numChannels,
+                                 int numOutputSamples) noexcept
+{
+    jassert (speedRatio > 0);
+    jassert (numChannels <= numChannelsPrepared); // did you forget to call prepare()?
+
+    numChannels = jmin (numChannels, numChannelsPrepared);
+
+    const auto& kernel = getKernelForRatio (speedRatio);
+    const auto numTaps = kernel.numTaps;
+    const auto historySize = 2 * maxNumTaps;
+    const auto windowOffset = (maxNumTaps - numTaps) / 2;
+    int numUsed = 0;
+
+    for (int i = 0; i < numOutputSamples; ++i)
+    {
+        while (subSamplePos >= 1.0)
+        {
+            // Each sample is written twice, so the most recent maxNumTaps samples are
+            // always contiguous, starting at writeIndex
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* channelHistory = history + channel * historySize;
+                const auto sample = inputs[channel][numUsed];
+
+                channelHistory[writeIndex] = sample;
+                channelHistory[writeIndex + maxNumTaps] = sample;
+            }
+
+            if (++writeIndex >= maxNumTaps)
+                writeIndex = 0;
+
+            ++numUsed;
+            subSamplePos -= 1.0;
+        }
+
+        const auto phasePosition = subSamplePos * numPhases;
+        const auto phase = jmin (numPhases - 1, (int) phasePosition);
+        const auto alpha = (float) (phasePosition - phase);
+
+        const auto* c0 = coefficients + kernel.offset + (size_t) (phase * numTaps);
+        const auto* c1 = c0 + numTaps;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const auto* window = history + channel * historySize + writeIndex + windowOffset;
+
+            float y0, y1;
+            PolyphaseResamplerHelpers::dotProducts (window, c0, c1, numTaps, y0, y1);
+            outputs[channel][i] = y0 + alpha * (y1 - y0);
+        }
+
+        subSamplePos += speedRatio;
+    }
+
+    return numUsed;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PolyphaseResamplerTests  : public UnitTest
+{
+public:
+    PolyphaseResamplerTests()
+        : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Input consumption matches getNumInputSamplesNeeded");
+        {
+            PolyphaseResampler resampler;
+            resampler.prepare (1, 3.0);
+
+            std::vector<float> input (4096, 0.0f), output (512);
+            const float* in[] = { input.data() };
+            float* out[] = { output.data() };
+
+            for (auto ratio : { 0.5, 1.0, 1.37, 2.9 })
+            {
+                for (int block = 0; block < 8; ++block)
+                {
+                    const auto numOut = 100 + block * 37;
+                    const auto expected = resampler.getNumInputSamplesNeeded (ratio, numOut);
+                    expectEquals (resampler.process (ratio, in, out, 1, numOut), expected);
+                }
+            }
+        }
+
+        beginTest ("Passband signals are preserved");
+        {
+            for (auto quality : { PolyphaseResampler::Quality::low, PolyphaseResampler::Quality::medium, PolyphaseResampler::Quality::high })
+            {
+                for (auto ratio : { 0.5, 1.0, 1.5 })
+                {
+                    // A tone at 1/20 of the sample rate should come through at unity gain
+                    const auto level = getOutputLevel (quality, ratio, 0.05);
+                    expectWithinAbsoluteError (level, 1.0, 0.02);
+                }
+            }
+        }
+
+        beginTest ("Downsampling removes content above the new Nyquist frequency");
+        {
+            for (auto quality : { PolyphaseResampler::Quality::medium, PolyphaseResampler::Quality::high })
+            {
+                // At a ratio of 2, a tone at 0.35 of the input rate would alias to 0.3 of the output rate
+                const auto level = getOutputLevel (quality, 2.0, 0.35);
+                expectLessThan (level, quality == PolyphaseResampler::Quality::high ? 0.001 : 0.01);
+            }
+        }
+    }
+
+private:
+    // Returns the peak level of the output after resampling a sine wave, ignoring the start-up transient
+    static double getOutputLevel (PolyphaseResampler::Quality quality, double ratio, double normalisedFrequency)
+    {
+        PolyphaseResampler resampler (quality);
+        resampler.prepare (1, ratio);
+
+        const int numOutputSamples = 4096;
+        std::vector<float> input ((size_t) resampler.getNumInputSamplesNeeded (ratio, numOutputSamples)), output (numOutputSamples);
+
+        for (size_t i = 0; i < input.size(); ++i)
+            input[i] = (float) std::sin (MathConstants<double>::twoPi * normalisedFrequency * (double) i);
+
+        const float* in[] = { input.data() };
+        float* out[] = { output.data() };
+        resampler.process (ratio, in, out, 1, numOutputSamples);
+
+        return FloatVectorOperations::findMaximum (output.data() + numOutputSamples / 2, numOutputSamples / 2);
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A multi-channel polyphase windowed-sinc resampler.
+
+    The interpolation kernel is precomputed into a bank of coefficient sets, one for
+    each of a fixed number of fractional positions, so each output sample only costs
+    a pair of contiguous dot products rather than evaluating the sinc function for every
+    tap, as WindowedSincInterpolator does.
+
+    The speed ratio can change on every call to process(). When downsampling, the kernel
+    is widened to remove everything above the new Nyquist frequency, using a different
+    coefficient bank for each 1/8 step of the ratio. prepare() calculates all of these
+    banks up front, so changing the ratio while processing just selects a different one,
+    and nothing is allocated or calculated on the audio thread.
+
+    Like the other interpolators, the resampler is stateful, so call reset() when there's
+    a break in the continuity of the input you're feeding it.
+
+    @see ResamplingAudioSource, GenericInterpolator
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** The quality presets.
+
+        Higher qualities use longer kernels with a steeper cut-off, which costs more
+        CPU and adds more latency.
+    */
+    enum class Quality
+    {
+        low,        /**< 16 taps, for previewing or when CPU is tight. */
+        medium,     /**< 32 taps, a good general-purpose choice. */
+        high        /**< 64 taps, for offline rendering. */
+    };
+
+    /** Creates a resampler. You'll need to call prepare() before using it. */
+    explicit PolyphaseResampler (Quality quality = Quality::medium);
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    //==============================================================================
+    /** Allocates the coefficient bank and the history for a number of channels.
+
+        @param numChannels          the maximum number of channels that will be processed
+        @param maximumSpeedRatio    the highest speed ratio that will be passed to process().
+                                    Higher ratios will still work, but will alias, because their
+                                    kernel is limited to the one used for this ratio. Note that
+                                    the latency, the memory used and the time this method takes
+                                    all grow with this value.
+    */
+    void prepare (int numChannels, double maximumSpeedRatio = 1.0);
+
+    /** Clears the history. Call this when there's a break in the continuity of the input. */
+    void reset() noexcept;
+
+    /** Returns the quality preset that this resampler was created with. */
+    Quality getQuality() const noexcept                 { return quality; }
+
+    /** Returns the maximum speed ratio that was passed to prepare(). */
+    double getMaximumSpeedRatio() const noexcept        { return maximumRatio; }
+
+    /** Returns the latency, in input samples.
+
+        This is the same for all speed ratios, so the latency in output samples is this
+        value divided by the speed ratio.
+    */
+    int getLatencyInInputSamples() const noexcept       { return maxNumTaps / 2; }
+
+    //==============================================================================
+    /** Returns the number of input samples that the next call to process() will use
+        to produce a given number of output samples.
+    */
+    int getNumInputSamplesNeeded (double speedRatio, int numOutputSamples) const noexcept;
+
+    /** Resamples a block of audio.
+
+        @param speedRatio           the number of input samples to use for each output sample
+        @param inputs               one pointer per channel to the source data. Each channel must contain
+                                    at least getNumInputSamplesNeeded (speedRatio, numOutputSamples) samples
+        @param outputs              one pointer per channel to write the results into
+        @param numChannels          the number of channels to process. This can't be more than the
+                                    number that was passed to prepare()
+        @param numOutputSamples     the number of output samples that should be created
+
+        @returns the number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* const* inputs,
+                 float* const* outputs,
+                 int numChannels,
+                 int numOutputSamples) noexcept;
+
+private:
+    //==============================================================================
+    struct Kernel
+    {
+        size_t offset;
+        int numTaps;
+    };
+
+    void calculateKernel (const Kernel&, double stretch) noexcept;
+    const Kernel& getKernelForRatio (double speedRatio) const noexcept;
+
+    const Quality quality;
+    const int baseNumTaps, numPhases;
+    const double rolloff, kaiserBeta;
+
+    double maximumRatio = 1.0, subSamplePos = 1.0;
+    int maxNumTaps = 0, numChannelsPrepared = 0, writeIndex = 0;
+
+    std::vector<Kernel> kernels;
+    HeapBlock<float> coefficients, history;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
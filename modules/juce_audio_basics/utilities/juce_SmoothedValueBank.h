@@ -0,0 +1,336 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A collection of smoothed values that are all advanced together, one block at
+    a time.
+
+    This behaves like an array of SmoothedValue objects, but is designed for
+    cases where there are thousands of values, only a few of which are moving at
+    any moment. The ramps that are currently active are kept packed together in
+    separate arrays of values, steps and countdowns, so advancing them is a single
+    vectorised pass, and values that have reached their targets cost nothing.
+
+    New targets are passed from another thread (e.g. the message thread) through a
+    lock-free queue, and only take effect when the audio thread calls
+    processPendingChanges(). A typical audio callback looks like this:
+
+    @code
+    bank.processPendingChanges();
+
+    for (int i = 0; i < numVoices; ++i)
+        voices[i].setCutoff (bank.getCurrentValue (cutoffIndex + i));
+
+    bank.advance (numSamples);
+    @endcode
+
+    Only one thread may call setTargetValue() and setCurrentAndTargetValue(), and
+    only one (other) thread may call the methods that process or read the values.
+
+    @see SmoothedValue, ValueSmoothingTypes
+
+    @tags{Audio}
+*/
+template <typename FloatType, typename SmoothingType = ValueSmoothingTypes::Linear>
+class SmoothedValueBank
+{
+public:
+    //==============================================================================
+    /** Creates an empty bank. Call setSize() before using it. */
+    SmoothedValueBank() = default;
+
+    //==============================================================================
+    /** Sets the number of values in the bank, and the number of changes that can be
+        queued between two calls to processPendingChanges().
+
+        All the values are set to the initial value, without any smoothing. This
+        allocates memory, so it mustn't be called while either thread is using the bank.
+    */
+    void setSize (int numValues, int maxPendingChanges = 1024,
+                  FloatType initialValue = (FloatType) (std::is_same<SmoothingType, ValueSmoothingTypes::Linear>::value ? 0 : 1))
+    {
+        jassert (numValues >= 0 && maxPendingChanges > 0);
+
+        // Multiplicative smoothed values cannot ever reach 0!
+        jassert (! (isMultiplicative && initialValue <= 0));
+
+        auto n = (size_t) numValues;
+
+        currentValues.assign (n, initialValue);
+        targetValues.assign (n, initialValue);
+        activeSlots.assign (n, -1);
+
+        activeIndices.resize (n);
+        activeValues.resize (n);
+        activeSteps.resize (n);
+        activeCountdowns.resize (n);
+        numActive = 0;
+
+        pendingChanges.resize ((size_t) maxPendingChanges + 1);
+        pendingFifo.setTotalSize (maxPendingChanges + 1);
+    }
+
+    /** Returns the number of values in the bank. */
+    int size() const noexcept                                   { return (int) currentValues.size(); }
+
+    //==============================================================================
+    /** Reset to a new sample rate and ramp length.
+        @param sampleRate           The sample rate
+        @param rampLengthInSeconds  The duration of the ramps in seconds
+    */
+    void reset (double sampleRate, double rampLengthInSeconds) noexcept
+    {
+        jassert (sampleRate > 0 && rampLengthInSeconds >= 0);
+        reset ((int) std::floor (rampLengthInSeconds * sampleRate));
+    }
+
+    /** Sets a new ramp length in samples, and moves every value straight to its target.
+        @param numSteps     The number of samples over which the ramps should be active
+    */
+    void reset (int numSteps) noexcept
+    {
+        stepsToTarget = numSteps;
+
+        while (numActive > 0)
+            finishRamp (numActive - 1);
+    }
+
+    //==============================================================================
+    /** Queues a new target for one of the values to ramp towards.
+
+        This is lock-free, and is intended to be called from a thread other than
+        the one that processes the values. It returns false if the queue is full.
+    */
+    bool setTargetValue (int index, FloatType newValue) noexcept
+    {
+        return pushChange (index, newValue, false);
+    }
+
+    /** Queues a new value that one of the values will jump to, without smoothing.
+
+        This is lock-free, and is intended to be called from a thread other than
+        the one that processes the values. It returns false if the queue is full.
+    */
+    bool setCurrentAndTargetValue (int index, FloatType newValue) noexcept
+    {
+        return pushChange (index, newValue, true);
+    }
+
+    //==============================================================================
+    /** Applies any changes that have been queued by setTargetValue() and
+        setCurrentAndTargetValue(). Call this at the start of each block.
+    */
+    void processPendingChanges() noexcept
+    {
+        pendingFifo.read (pendingFifo.getNumReady()).forEach ([this] (int i)
+        {
+            const auto& change = pendingChanges[(size_t) i];
+            applyChange (change.index, change.value, change.jump);
+        });
+    }
+
+    /** Moves all the ramps on by a number of samples.
+
+        This is identical to calling SmoothedValue::skip() on every value. Values
+        that aren't smoothing aren't touched.
+    */
+    void advance (int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        if (numSamples <= 0)
+            return;
+
+        for (int i = 0; i < numActive;)
+        {
+            if (activeCountdowns[(size_t) i] <= numSamples)
+            {
+                finishRamp (i);
+            }
+            else
+            {
+                activeCountdowns[(size_t) i] -= numSamples;
+                ++i;
+            }
+        }
+
+        if (numActive == 0)
+            return;
+
+        FloatVectorOperations::addWithMultiply (activeValues.data(), activeSteps.data(), (FloatType) numSamples, numActive);
+
+        for (int i = 0; i < numActive; ++i)
+            currentValues[(size_t) activeIndices[(size_t) i]] = fromRampDomain (activeValues[(size_t) i]);
+    }
+
+    //==============================================================================
+    /** Returns the current value of one of the ramps. */
+    FloatType getCurrentValue (int index) const noexcept        { return currentValues[(size_t) index]; }
+
+    /** Returns the value towards which one of the ramps is moving. */
+    FloatType getTargetValue (int index) const noexcept         { return targetValues[(size_t) index]; }
+
+    /** Returns true if one of the values is currently being interpolated. */
+    bool isSmoothing (int index) const noexcept                 { return activeSlots[(size_t) index] >= 0; }
+
+    /** Returns the number of values that are currently being interpolated. */
+    int getNumSmoothing() const noexcept                        { return numActive; }
+
+    /** Returns the current values of all the ramps, as an array of size() elements. */
+    const FloatType* getCurrentValues() const noexcept          { return currentValues.data(); }
+
+    /** Writes the values that one ramp will take over the next numSamples samples,
+        without advancing it.
+
+        The values are the ones that a SmoothedValue would return from successive
+        calls to getNextValue(), so this is useful for applying a per-sample ramp
+        before calling advance() at the end of the block.
+    */
+    void getNextValues (int index, FloatType* destination, int numSamples) const noexcept
+    {
+        auto slot = activeSlots[(size_t) index];
+        auto target = targetValues[(size_t) index];
+
+        if (slot < 0)
+        {
+            FloatVectorOperations::fill (destination, target, numSamples);
+            return;
+        }
+
+        auto value = activeValues[(size_t) slot];
+        auto step = activeSteps[(size_t) slot];
+        auto numToRamp = jmin (numSamples, activeCountdowns[(size_t) slot] - 1);
+
+        for (int i = 0; i < numToRamp; ++i)
+            destination[i] = fromRampDomain (value + step * (FloatType) (i + 1));
+
+        if (numToRamp < numSamples)
+            FloatVectorOperations::fill (destination + numToRamp, target, numSamples - numToRamp);
+    }
+
+private:
+    //==============================================================================
+    struct PendingChange
+    {
+        int index;
+        FloatType value;
+        bool jump;
+    };
+
+    static constexpr bool isMultiplicative = std::is_same<SmoothingType, ValueSmoothingTypes::Multiplicative>::value;
+
+    // Multiplicative ramps are linear ramps of the logarithm of the value
+    static FloatType toRampDomain (FloatType value) noexcept      { return isMultiplicative ? std::log (value) : value; }
+    static FloatType fromRampDomain (FloatType value) noexcept    { return isMultiplicative ? std::exp (value) : value; }
+
+    bool pushChange (int index, FloatType newValue, bool jump) noexcept
+    {
+        jassert (isPositiveAndBelow (index, size()));
+
+        // Multiplicative smoothed values cannot ever reach 0!
+        jassert (! (isMultiplicative && newValue <= 0));
+
+        auto scope = pendingFifo.write (1);
+
+        if (scope.blockSize1 + scope.blockSize2 == 0)
+            return false;
+
+        pendingChanges[(size_t) (scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = { index, newValue, jump };
+        return true;
+    }
+
+    void applyChange (int index, FloatType newValue, bool jump) noexcept
+    {
+        auto i = (size_t) index;
+
+        if (jump || stepsToTarget <= 0)
+        {
+            if (activeSlots[i] >= 0)
+                removeRamp (activeSlots[i]);
+
+            currentValues[i] = targetValues[i] = newValue;
+            return;
+        }
+
+        if (newValue == targetValues[i])
+            return;
+
+        targetValues[i] = newValue;
+        auto slot = activeSlots[i];
+
+        if (slot < 0)
+        {
+            slot = numActive++;
+            activeSlots[i] = slot;
+            activeIndices[(size_t) slot] = index;
+            activeValues[(size_t) slot] = toRampDomain (currentValues[i]);
+        }
+
+        activeCountdowns[(size_t) slot] = stepsToTarget;
+        activeSteps[(size_t) slot] = (toRampDomain (newValue) - activeValues[(size_t) slot]) / (FloatType) stepsToTarget;
+    }
+
+    void finishRamp (int slot) noexcept
+    {
+        auto index = (size_t) activeIndices[(size_t) slot];
+        currentValues[index] = targetValues[index];
+        removeRamp (slot);
+    }
+
+    // Keeps the active ramps packed by moving the last one into the gap
+    void removeRamp (int slot) noexcept
+    {
+        auto s = (size_t) slot;
+        auto last = (size_t) --numActive;
+
+        activeSlots[(size_t) activeIndices[s]] = -1;
+
+        if (s != last)
+        {
+            activeIndices[s]    = activeIndices[last];
+            activeValues[s]     = activeValues[last];
+            activeSteps[s]      = activeSteps[last];
+            activeCountdowns[s] = activeCountdowns[last];
+
+            activeSlots[(size_t) activeIndices[s]] = slot;
+        }
+    }
+
+    //==============================================================================
+    std::vector<FloatType> currentValues, targetValues, activeValues, activeSteps;
+    std::vector<int> activeSlots, activeIndices, activeCountdowns;
+    int numActive = 0, stepsToTarget = 0;
+
+    std::vector<PendingChange> pendingChanges;
+    AbstractFifo pendingFifo { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SmoothedValueBank)
+};
+
+} // namespace juce
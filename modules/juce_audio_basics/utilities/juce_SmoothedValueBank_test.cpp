@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SmoothedValueBankTests  : public UnitTest
+{
+public:
+    SmoothedValueBankTests()
+        : UnitTest ("SmoothedValueBank", UnitTestCategories::smoothedValues)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Linear ramps match SmoothedValue");
+        matchesSmoothedValue<ValueSmoothingTypes::Linear>();
+
+        beginTest ("Multiplicative ramps match SmoothedValue");
+        matchesSmoothedValue<ValueSmoothingTypes::Multiplicative>();
+
+        beginTest ("Only moving values are active");
+        {
+            SmoothedValueBank<float> bank;
+            bank.setSize (5000);
+            bank.reset (100);
+
+            bank.setTargetValue (10, 1.0f);
+            bank.setTargetValue (4000, -1.0f);
+            bank.setCurrentAndTargetValue (20, 3.0f);
+            bank.processPendingChanges();
+
+            expectEquals (bank.getNumSmoothing(), 2);
+            expect (bank.isSmoothing (10) && bank.isSmoothing (4000) && ! bank.isSmoothing (20));
+            expectEquals (bank.getCurrentValue (20), 3.0f);
+
+            bank.advance (50);
+            expectWithinAbsoluteError (bank.getCurrentValue (10), 0.5f, 1.0e-6f);
+            expectWithinAbsoluteError (bank.getCurrentValue (4000), -0.5f, 1.0e-6f);
+
+            bank.advance (50);
+            expectEquals (bank.getNumSmoothing(), 0);
+            expectEquals (bank.getCurrentValue (10), 1.0f);
+            expectEquals (bank.getCurrentValue (4000), -1.0f);
+        }
+
+        beginTest ("Changes are dropped when the queue is full");
+        {
+            SmoothedValueBank<float> bank;
+            bank.setSize (4, 2);
+
+            expect (bank.setTargetValue (0, 1.0f));
+            expect (bank.setTargetValue (1, 1.0f));
+            expect (! bank.setTargetValue (2, 1.0f));
+
+            bank.processPendingChanges();
+            expect (bank.setTargetValue (2, 1.0f));
+        }
+
+        beginTest ("Values can be set from another thread");
+        {
+            constexpr int numValues = 64, numRounds = 300, numChanges = numValues * numRounds;
+
+            SmoothedValueBank<float> bank;
+            bank.setSize (numValues, 16);
+            bank.reset (8);
+
+            struct Producer  : public Thread
+            {
+                explicit Producer (SmoothedValueBank<float>& b)  : Thread ("SmoothedValueBank producer"), bank (b) {}
+
+                void run() override
+                {
+                    for (int i = 0; i < numChanges; ++i)
+                        while (! bank.setTargetValue (i % numValues, (float) (i / numValues)))
+                            Thread::yield();
+
+                    finished = true;
+                }
+
+                SmoothedValueBank<float>& bank;
+                std::atomic<bool> finished { false };
+            };
+
+            Producer producer (bank);
+            producer.startThread();
+
+            while (! producer.finished)
+            {
+                bank.processPendingChanges();
+                bank.advance (4);
+            }
+
+            producer.stopThread (-1);
+            bank.processPendingChanges();
+            bank.advance (8);
+
+            for (int i = 0; i < numValues; ++i)
+                expectEquals (bank.getCurrentValue (i), (float) (numRounds - 1));
+        }
+    }
+
+private:
+    template <typename SmoothingType>
+    void matchesSmoothedValue()
+    {
+        constexpr int numValues = 32, numSteps = 100;
+
+        auto random = getRandom();
+        auto nextTarget = [&random] { return 0.1f + random.nextFloat() * 10.0f; };
+
+        SmoothedValueBank<float, SmoothingType> bank;
+        bank.setSize (numValues, 1024, 1.0f);
+        bank.reset (numSteps);
+
+        std::vector<SmoothedValue<float, SmoothingType>> references ((size_t) numValues, 1.0f);
+
+        for (auto& ref : references)
+            ref.reset (numSteps);
+
+        std::vector<float> ramp (64);
+
+        for (int block = 0; block < 50; ++block)
+        {
+            for (int i = 0; i < numValues; ++i)
+            {
+                if (random.nextInt (4) == 0)
+                {
+                    auto target = nextTarget();
+                    bank.setTargetValue (i, target);
+                    references[(size_t) i].setTargetValue (target);
+                }
+            }
+
+            bank.processPendingChanges();
+            auto blockSize = 1 + random.nextInt ((int) ramp.size());
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                auto& ref = references[(size_t) i];
+                expect (bank.isSmoothing (i) == ref.isSmoothing());
+
+                bank.getNextValues (i, ramp.data(), blockSize);
+
+                for (int j = 0; j < blockSize; ++j)
+                    expectWithinAbsoluteError (ramp[(size_t) j], ref.getNextValue(), 1.0e-3f);
+            }
+
+            bank.advance (blockSize);
+
+            for (int i = 0; i < numValues; ++i)
+                expectWithinAbsoluteError (bank.getCurrentValue (i), references[(size_t) i].getCurrentValue(), 1.0e-3f);
+        }
+    }
+};
+
+static SmoothedValueBankTests smoothedValueBankTests;
+
+} // namespace juce
@@ -94,6 +94,11 @@ private:
         owner.handleIncomingMidiMessageInt (source, message);
     }
 
+    void handleIncomingMidiData (MidiInput* source, const uint8* messageData, int numBytes, double timestamp) override
+    {
+        owner.handleIncomingMidiDataInt (source, messageData, numBytes, timestamp);
+    }
+
     void audioDeviceListChanged() override
     {
         owner.audioDeviceListChanged();
@@ -902,6 +907,8 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
                                                    int numOutputChannels,
                                                    int numSamples)
 {
+    JUCE_TRACE_REALTIME_SCOPE_IN_CATEGORY ("audio", "AudioIODeviceCallback");
+
     const ScopedLock sl (audioCallbackLock);
 
     inputLevelGetter->updateLevel (inputChannelData, numInputChannels, numSamples);
@@ -958,6 +965,12 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
 
 void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device)
 {
+    // The device's callback thread may not belong to us, so this makes a trace buffer that
+    // the callback's real-time span can take without locking or allocating. It isn't kept
+    // for this device's thread, so if another real-time span takes it first, or tracing was
+    // disabled when the device started, the callback's spans are dropped.
+    JUCE_TRACE_PREALLOCATE_BUFFER();
+
     loadMeasurer.reset (device->getCurrentSampleRate(),
                         device->getCurrentBufferSizeSamples());
 
@@ -1069,6 +1082,19 @@ void AudioDeviceManager::handleIncomingMidiMessageInt (MidiInput* source, const
     }
 }
 
+void AudioDeviceManager::handleIncomingMidiDataInt (MidiInput* source, const uint8* messageData, int numBytes, double timestamp)
+{
+    // (the bytes are passed straight on, so that a callback can avoid building a MidiMessage)
+    if (numBytes > 0 && messageData[0] != 0xfe)
+    {
+        const ScopedLock sl (midiCallbackLock);
+
+        for (auto& mc : midiCallbacks)
+            if (mc.deviceIdentifier.isEmpty() || mc.deviceIdentifier == source->getIdentifier())
+                mc.callback->handleIncomingMidiData (source, messageData, numBytes, timestamp);
+    }
+}
+
 //==============================================================================
 void AudioDeviceManager::setDefaultMidiOutputDevice (const String& identifier)
 {
@@ -1483,6 +1509,60 @@ public:
             ptr->restartDevices (newSr, newBs);
             expectEquals (numCalls, 1);
         }
+
+        beginTest ("Incoming MIDI data is passed on to the MIDI callbacks as raw bytes");
+        {
+            AudioDeviceManager manager;
+            manager.addAudioDeviceType (std::make_unique<MockDeviceType> ("foo"));
+            manager.initialiseWithDefaultDevices (2, 2);
+
+            auto* device = dynamic_cast<MockDevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            if (device == nullptr)
+                return;
+
+            // the device's callback is the manager's handler, which is also its MIDI input callback
+            auto* handler = dynamic_cast<MidiInputCallback*> (device->getCallback());
+            expect (handler != nullptr);
+
+            if (handler == nullptr)
+                return;
+
+            MockMidiCallback rawCallback, messageCallback;
+            rawCallback.handlesRawData = true;
+            manager.addMidiInputDeviceCallback ({}, &rawCallback);
+            manager.addMidiInputDeviceCallback ({}, &messageCallback);
+
+            std::vector<uint8> sysex { 0xf0 };
+
+            for (int i = 0; i < 1000; ++i)
+                sysex.push_back ((uint8) (i & 0x7f));
+
+            sysex.push_back (0xf7);
+
+            const uint8 noteOn[] { 0x90, 0x40, 0x7f };
+            const uint8 activeSense[] { 0xfe };
+
+            handler->handleIncomingMidiData (nullptr, noteOn, 3, 1.0);
+            handler->handleIncomingMidiData (nullptr, activeSense, 1, 2.0);
+            handler->handleIncomingMidiData (nullptr, sysex.data(), (int) sysex.size(), 3.0);
+
+            const std::vector<std::vector<uint8>> expected { { 0x90, 0x40, 0x7f }, sysex };
+
+            // a callback that takes raw data never has a MidiMessage built for it..
+            expect (rawCallback.rawData == expected);
+            expect (rawCallback.messages.empty());
+            expect (rawCallback.timestamps == std::vector<double> { 1.0, 3.0 });
+
+            // ..and one that doesn't still receives the same messages
+            expect (messageCallback.rawData.empty());
+            expect (messageCallback.messages == expected);
+            expect (messageCallback.timestamps == std::vector<double> { 1.0, 3.0 });
+
+            manager.removeMidiInputDeviceCallback ({}, &rawCallback);
+            manager.removeMidiInputDeviceCallback ({}, &messageCallback);
+        }
     }
 
 private:
@@ -1703,6 +1783,8 @@ private:
 
         bool isPlaying() override { return playing; }
 
+        AudioIODeviceCallback* getCallback() const noexcept { return callback; }
+
         String getLastError() override { return {}; }
         int getCurrentBufferSizeSamples() override { return blockSize; }
         double getCurrentSampleRate() override { return sampleRate; }
@@ -1801,6 +1883,29 @@ private:
         void audioDeviceError (const String&)                              override { NullCheckedInvocation::invoke (error); }
     };
 
+    class MockMidiCallback : public MidiInputCallback
+    {
+    public:
+        bool handlesRawData = false;
+        std::vector<std::vector<uint8>> rawData, messages;
+        std::vector<double> timestamps;
+
+        void handleIncomingMidiMessage (MidiInput*, const MidiMessage& message) override
+        {
+            messages.emplace_back (message.getRawData(), message.getRawData() + message.getRawDataSize());
+            timestamps.push_back (message.getTimeStamp());
+        }
+
+        void handleIncomingMidiData (MidiInput* source, const uint8* data, int numBytes, double timestamp) override
+        {
+            if (! handlesRawData)
+                return MidiInputCallback::handleIncomingMidiData (source, data, numBytes, timestamp);
+
+            rawData.emplace_back (data, data + numBytes);
+            timestamps.push_back (timestamp);
+        }
+    };
+
     void initialiseManager (AudioDeviceManager& manager)
     {
         manager.addAudioDeviceType (std::make_unique<MockDeviceType> (mockAName));
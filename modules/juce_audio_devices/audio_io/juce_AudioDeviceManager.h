@@ -532,6 +532,7 @@ private:
     void audioDeviceStoppedInt();
     void audioDeviceErrorInt (const String&);
     void handleIncomingMidiMessageInt (MidiInput*, const MidiMessage&);
+    void handleIncomingMidiDataInt (MidiInput*, const uint8*, int, double);
     void audioDeviceListChanged();
 
     String restartDevice (int blockSizeToUse, double sampleRateToUse,
@@ -35,6 +35,15 @@ bool AudioIODevice::setAudioPreprocessingEnabled (bool)         { return false;
 bool AudioIODevice::hasControlPanel() const                     { return false; }
 int  AudioIODevice::getXRunCount() const noexcept               { return -1; }
 
+bool AudioIODevice::setAudioThreadRealtimeOptions (const Thread::RealtimeOptions&)  { return false; }
+
+AudioIODevice::CallbackStatistics AudioIODevice::getCallbackStatistics() const
+{
+    CallbackStatistics stats;
+    stats.xrunCount = getXRunCount();
+    return stats;
+}
+
 bool AudioIODevice::showControlPanel()
 {
     jassertfalse;    // this should only be called for devices which return true from
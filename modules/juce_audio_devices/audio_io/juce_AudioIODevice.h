@@ -312,6 +312,50 @@ public:
     */
     virtual int getXRunCount() const noexcept;
 
+    //==============================================================================
+    /** Timing information that a device gathers about its audio callbacks.
+
+        @see getCallbackStatistics
+    */
+    struct CallbackStatistics
+    {
+        /** The number of audio callbacks made since the device was opened. */
+        int numCallbacks = 0;
+
+        /** The value that getXRunCount() would return. */
+        int xrunCount = -1;
+
+        /** The mean and longest time spent inside the audio callback, in milliseconds. */
+        double averageCallbackDurationMs = 0, maxCallbackDurationMs = 0;
+
+        /** The longest delay between the device having a whole buffer ready and the
+            audio thread waking up to deal with it, in milliseconds.
+        */
+        double maxWakeupLatencyMs = 0;
+    };
+
+    /** Returns timing statistics for the audio callbacks made since the device was opened.
+
+        This can safely be called from any thread while the device is running. Devices
+        that don't measure their timing just fill in the xrunCount.
+    */
+    virtual CallbackStatistics getCallbackStatistics() const;
+
+    //==============================================================================
+    /** Sets the real-time scheduling to use for the thread that makes this device's
+        audio callbacks.
+
+        The audio thread applies the options to itself the next time it runs, and again
+        whenever the device is reopened. If the options' periodMs is zero, the duration
+        of the device's buffer is used.
+
+        Only devices that run their own audio thread (currently ALSA) can support this.
+        Returns false if the device doesn't.
+
+        @see Thread::setCurrentThreadRealtime
+    */
+    virtual bool setAudioThreadRealtimeOptions (const Thread::RealtimeOptions& options);
+
     //==============================================================================
 protected:
     /** Creates a device, setting its name and type member variables. */
@@ -109,6 +109,26 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_USE_MMAP
+    Makes ALSA audio devices use memory-mapped access where the hardware supports it.
+    Samples are then converted directly into and out of the device's ring buffer, and
+    the audio thread is woken by polling the device once per period.
+*/
+#ifndef JUCE_ALSA_USE_MMAP
+ #define JUCE_ALSA_USE_MMAP 0
+#endif
+
+/** Config: JUCE_ALSA_FIFO_PRIORITY
+    If this is greater than zero, the ALSA audio thread switches itself to SCHED_FIFO
+    scheduling with this priority (1 to 99) when it starts, unless other options are
+    given to AudioIODevice::setAudioThreadRealtimeOptions(). The process needs permission
+    to do this (e.g. an rtprio entry in /etc/security/limits.conf), otherwise the thread
+    keeps its normal priority.
+*/
+#ifndef JUCE_ALSA_FIFO_PRIORITY
+ #define JUCE_ALSA_FIFO_PRIORITY 0
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices (Linux only).
 */
@@ -212,6 +212,29 @@ public:
     virtual void handleIncomingMidiMessage (MidiInput* source,
                                             const MidiMessage& message) = 0;
 
+    /** Receives an incoming message as raw bytes.
+
+        When a MidiInput receives its data as a stream of bytes, as it does on most
+        platforms, each complete message is delivered through this method. The default
+        implementation creates a MidiMessage and passes it to
+        handleIncomingMidiMessage(), but because a MidiMessage has to allocate space
+        for a long sysex, a callback that needs to be real-time safe can override this
+        to copy the data into its own preallocated storage instead.
+
+        @param source       the MidiInput object that generated the message
+        @param messageData  the message, which is only valid for the duration of this call
+        @param numBytes     the size of the message
+        @param timestamp    the time at which the message arrived, in the same form as
+                            the timestamp of the message passed to handleIncomingMidiMessage()
+    */
+    virtual void handleIncomingMidiData (MidiInput* source,
+                                         const uint8* messageData,
+                                         int numBytes,
+                                         double timestamp)
+    {
+        handleIncomingMidiMessage (source, MidiMessage (messageData, numBytes, timestamp));
+    }
+
     /** Notification sent each time a packet of a multi-packet sysex message arrives.
 
         If a long sysex message is broken up into multiple packets, this callback is made
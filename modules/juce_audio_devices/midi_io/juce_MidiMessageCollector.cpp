@@ -47,6 +47,11 @@ void MidiMessageCollector::reset (const double newSampleRate)
 }
 
 void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
+{
+    addDataToQueue (message.getRawData(), message.getRawDataSize(), message.getTimeStamp());
+}
+
+void MidiMessageCollector::addDataToQueue (const uint8* data, int numBytes, double timeStamp)
 {
     const ScopedLock sl (midiCallbackLock);
 
@@ -56,11 +61,11 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
 
     // the messages that come in here need to be time-stamped correctly - see MidiInput
     // for details of what the number should be.
-    jassert (message.getTimeStamp() != 0);
+    jassert (timeStamp != 0);
 
-    auto sampleNumber = (int) ((message.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
+    auto sampleNumber = (int) ((timeStamp - 0.001 * lastCallbackTime) * sampleRate);
 
-    incomingMessages.addEvent (message, sampleNumber);
+    incomingMessages.addEvent (data, numBytes, sampleNumber);
 
     // if the messages don't get used for over a second, we'd better
     // get rid of any old ones to avoid the queue getting too big
@@ -155,4 +160,67 @@ void MidiMessageCollector::handleIncomingMidiMessage (MidiInput*, const MidiMess
     addMessageToQueue (message);
 }
 
+void MidiMessageCollector::handleIncomingMidiData (MidiInput*, const uint8* messageData, int numBytes, double timeStamp)
+{
+    addDataToQueue (messageData, numBytes, timeStamp);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiMessageCollectorTests final : public UnitTest
+{
+public:
+    MidiMessageCollectorTests()
+        : UnitTest ("MidiMessageCollector", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Raw messages arrive intact");
+        {
+            MidiMessageCollector collector;
+            collector.reset (44100.0);
+            collector.ensureStorageAllocated (4096);
+
+            std::vector<uint8> sysex { 0xf0 };
+
+            for (int i = 0; i < 1000; ++i)
+                sysex.push_back ((uint8) (i & 0x7f));
+
+            sysex.push_back (0xf7);
+
+            const uint8 noteOn[] { 0x90, 0x40, 0x7f };
+            const uint8 noteOff[] { 0x80, 0x40, 0x00 };
+            const auto time = Time::getMillisecondCounterHiRes() * 0.001;
+
+            collector.handleIncomingMidiData (nullptr, noteOn, 3, time);
+            collector.handleIncomingMidiData (nullptr, sysex.data(), (int) sysex.size(), time);
+            collector.addMessageToQueue (MidiMessage (noteOff, 3, time));
+
+            MidiBuffer result;
+            collector.removeNextBlockOfMessages (result, 512);
+
+            std::vector<std::vector<uint8>> received;
+
+            for (const auto metadata : result)
+                received.emplace_back (metadata.data, metadata.data + metadata.numBytes);
+
+            expectEquals ((int) received.size(), 3);
+
+            if (received.size() == 3)
+            {
+                expect (received[0] == std::vector<uint8> { 0x90, 0x40, 0x7f });
+                expect (received[1] == sysex);
+                expect (received[2] == std::vector<uint8> { 0x80, 0x40, 0x00 });
+            }
+        }
+    }
+};
+
+static MidiMessageCollectorTests midiMessageCollectorTests;
+
+#endif
+
 } // namespace juce
@@ -85,6 +85,12 @@ public:
         This can be called before audio processing begins to ensure that there
         is sufficient space for the expected MIDI messages, in order to avoid
         allocations within the audio callback.
+
+        Messages that arrive from a MidiInput are copied straight from the input's
+        buffer into this storage, so if it's large enough to hold the largest
+        block of messages (including any sysex data) that can arrive between two
+        calls to removeNextBlockOfMessages(), neither the input thread nor the
+        audio thread will need to allocate.
     */
     void ensureStorageAllocated (size_t bytes);
 
@@ -96,9 +102,13 @@ public:
     void handleNoteOff (MidiKeyboardState*, int midiChannel, int midiNoteNumber, float velocity) override;
     /** @internal */
     void handleIncomingMidiMessage (MidiInput*, const MidiMessage&) override;
+    /** @internal */
+    void handleIncomingMidiData (MidiInput*, const uint8*, int, double) override;
 
 private:
     //==============================================================================
+    void addDataToQueue (const uint8* data, int numBytes, double timeStamp);
+
     double lastCallbackTime = 0;
     CriticalSection midiCallbackLock;
     MidiBuffer incomingMessages;
@@ -210,6 +210,21 @@ public:
             return false;
         }
 
+        isMMap = false;
+
+       #if JUCE_ALSA_USE_MMAP
+        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+        {
+            isInterleaved = true;
+            isMMap = true;
+        }
+        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_NONINTERLEAVED) >= 0)
+        {
+            isInterleaved = false;
+            isMMap = true;
+        }
+        else
+       #endif
         if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
             isInterleaved = true;
         else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
@@ -274,9 +289,15 @@ public:
 
         if (JUCE_ALSA_FAILED (snd_pcm_hw_params_get_period_size (hwParams, &frames, &dir))
              || JUCE_ALSA_FAILED (snd_pcm_hw_params_get_periods (hwParams, &periods, &dir)))
+        {
             latency = 0;
+            periodSize = (snd_pcm_sframes_t) samplesPerPeriod;
+        }
         else
+        {
             latency = (int) frames * ((int) periods - 1); // (this is the method JACK uses to guess the latency..)
+            periodSize = (snd_pcm_sframes_t) frames;
+        }
 
         JUCE_ALSA_LOG ("frames: " << (int) frames << ", periods: " << (int) periods
                           << ", samplesPerPeriod: " << (int) samplesPerPeriod);
@@ -291,11 +312,25 @@ public:
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_silence_size (handle, swParams, boundary))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_start_threshold (handle, swParams, samplesPerPeriod))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_stop_threshold (handle, swParams, boundary))
+            || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_avail_min (handle, swParams, (snd_pcm_uframes_t) periodSize))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params (handle, swParams)))
         {
             return false;
         }
 
+        numPollDescriptors = snd_pcm_poll_descriptors_count (handle);
+
+        if (numPollDescriptors <= 0)
+        {
+            error = "couldn't get the device's poll descriptors";
+            return false;
+        }
+
+        pollDescriptors.calloc (numPollDescriptors);
+
+        if (JUCE_ALSA_FAILED (snd_pcm_poll_descriptors (handle, pollDescriptors, (unsigned int) numPollDescriptors)))
+            return false;
+
        #if JUCE_ALSA_LOGGING
         // enable this to dump the config of the devices that get opened
         snd_output_t* out;
@@ -310,9 +345,67 @@ public:
     }
 
     //==============================================================================
+    /** Blocks until at least a period of frames can be read or written, or until the
+        timeout expires. Returns the number of frames available, or a negative error code
+        if the device couldn't be recovered from an xrun.
+    */
+    snd_pcm_sframes_t waitForPeriod (int timeoutMs)
+    {
+        auto avail = snd_pcm_avail_update (handle);
+
+        if (avail >= 0 && avail < periodSize)
+        {
+            // a stream that's been prepared but not started will never wake us up
+            if (snd_pcm_state (handle) == SND_PCM_STATE_PREPARED)
+                snd_pcm_start (handle);
+
+            bool woken = false;
+
+            for (;;)
+            {
+                auto result = poll (pollDescriptors, (nfds_t) numPollDescriptors, timeoutMs);
+
+                if (result < 0 && errno == EINTR)
+                    continue;
+
+                if (result <= 0)
+                    break;
+
+                unsigned short revents = 0;
+                snd_pcm_poll_descriptors_revents (handle, pollDescriptors, (unsigned int) numPollDescriptors, &revents);
+
+                if ((revents & (POLLERR | POLLNVAL)) != 0 || (revents & (isInput ? POLLIN : POLLOUT)) != 0)
+                {
+                    woken = true;
+                    break;
+                }
+            }
+
+            avail = snd_pcm_avail_update (handle);
+
+            // anything beyond the period that woke us up arrived while we were waiting to run
+            if (woken && avail > periodSize)
+                maxFramesLateOnWakeup = jmax (maxFramesLateOnWakeup.load(), (int) (avail - periodSize));
+        }
+
+        if (avail < 0)
+        {
+            if (! recover ((int) avail, false))
+                return avail;
+
+            avail = snd_pcm_avail_update (handle);
+        }
+
+        return avail;
+    }
+
     bool writeToOutputDevice (AudioBuffer<float>& outputChannelBuffer, const int numSamples)
     {
         jassert (numChannelsRunning <= outputChannelBuffer.getNumChannels());
+
+        if (isMMap)
+            return transferMMapped (outputChannelBuffer, numSamples);
+
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
 
@@ -333,14 +426,8 @@ public:
             numDone = snd_pcm_writen (handle, (void**) data, (snd_pcm_uframes_t) numSamples);
         }
 
-        if (numDone < 0)
-        {
-            if (numDone == -(EPIPE))
-                underrunCount++;
-
-            if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) numDone, 1 /* silent */)))
-                return false;
-        }
+        if (numDone < 0 && ! recover ((int) numDone, true))
+            return false;
 
         if (numDone < numSamples)
             JUCE_ALSA_LOG ("Did not write all samples: numDone: " << numDone << ", numSamples: " << numSamples);
@@ -351,6 +438,10 @@ public:
     bool readFromInputDevice (AudioBuffer<float>& inputChannelBuffer, const int numSamples)
     {
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
+
+        if (isMMap)
+            return transferMMapped (inputChannelBuffer, numSamples);
+
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
         if (isInterleaved)
@@ -360,14 +451,8 @@ public:
 
             auto num = snd_pcm_readi (handle, scratch.getData(), (snd_pcm_uframes_t) numSamples);
 
-            if (num < 0)
-            {
-                if (num == -(EPIPE))
-                    overrunCount++;
-
-                if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) num, 1 /* silent */)))
-                    return false;
-            }
+            if (num < 0 && ! recover ((int) num, true))
+                return false;
 
 
             if (num < numSamples)
@@ -380,14 +465,8 @@ public:
         {
             auto num = snd_pcm_readn (handle, (void**) data, (snd_pcm_uframes_t) numSamples);
 
-            if (num < 0)
-            {
-                if (num == -(EPIPE))
-                    overrunCount++;
-
-                if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) num, 1 /* silent */)))
-                    return false;
-            }
+            if (num < 0 && ! recover ((int) num, true))
+                return false;
 
             if (num < numSamples)
                 JUCE_ALSA_LOG ("Did not read all samples: num: " << num << ", numSamples: " << numSamples);
@@ -403,16 +482,125 @@ public:
     snd_pcm_t* handle;
     String error;
     int bitDepth, numChannelsRunning, latency;
-    int underrunCount = 0, overrunCount = 0;
+    std::atomic<int> underrunCount { 0 }, overrunCount { 0 }, maxFramesLateOnWakeup { 0 };
 
 private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isMMap = false;
+    snd_pcm_sframes_t periodSize = 0;
+    HeapBlock<pollfd> pollDescriptors;
+    int numPollDescriptors = 0;
     MemoryBlock scratch;
     std::unique_ptr<AudioData::Converter> converter;
 
+    //==============================================================================
+    bool recover (int errorNum, bool silent)
+    {
+        if (errorNum == -(EPIPE))
+            ++(isInput ? overrunCount : underrunCount);
+
+        return ! JUCE_ALSA_FAILED (snd_pcm_recover (handle, errorNum, silent ? 1 : 0));
+    }
+
+    // Converts the samples straight into or out of the device's ring buffer
+    bool transferMMapped (AudioBuffer<float>& buffer, const int numSamples)
+    {
+        float* const* const data = buffer.getArrayOfWritePointers();
+        int numDone = 0;
+
+        while (numDone < numSamples)
+        {
+            auto avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+            {
+                if (! recover ((int) avail, true))
+                    return false;
+
+                continue;
+            }
+
+            if (avail == 0)
+            {
+                avail = waitForPeriod (2000);
+
+                if (avail < 0)
+                    return false;
+
+                if (avail == 0)
+                    break; // timed out, so give up on this block rather than hanging the thread
+
+                continue;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            auto frames = (snd_pcm_uframes_t) jmin ((snd_pcm_sframes_t) (numSamples - numDone), avail);
+
+            auto err = snd_pcm_mmap_begin (handle, &areas, &offset, &frames);
+
+            if (err < 0)
+            {
+                if (! recover (err, true))
+                    return false;
+
+                continue;
+            }
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+            {
+                if (isInterleaved)
+                {
+                    // all the channels share the first area's frames
+                    auto* frameData = getAreaAddress (areas[0], offset);
+
+                    if (isInput)
+                        converter->convertSamples (data[i] + numDone, 0, frameData, i, (int) frames);
+                    else
+                        converter->convertSamples (frameData, i, data[i] + numDone, 0, (int) frames);
+                }
+                else
+                {
+                    auto* channelData = getAreaAddress (areas[i], offset);
+
+                    if (isInput)
+                        converter->convertSamples (data[i] + numDone, channelData, (int) frames);
+                    else
+                        converter->convertSamples (channelData, data[i] + numDone, (int) frames);
+                }
+            }
+
+            auto numCommitted = snd_pcm_mmap_commit (handle, offset, frames);
+
+            if (numCommitted < 0 || (snd_pcm_uframes_t) numCommitted != frames)
+            {
+                if (! recover (numCommitted < 0 ? (int) numCommitted : -(EPIPE), true))
+                    return false;
+
+                continue;
+            }
+
+            numDone += (int) frames;
+
+            // unlike snd_pcm_writei, committing frames doesn't start a prepared stream
+            if (! isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED)
+                JUCE_ALSA_FAILED (snd_pcm_start (handle));
+        }
+
+        if (isInput && numDone < numSamples)
+            for (int i = 0; i < numChannelsRunning; ++i)
+                zeromem (data[i] + numDone, sizeof (float) * (size_t) (numSamples - numDone));
+
+        return true;
+    }
+
+    static void* getAreaAddress (const snd_pcm_channel_area_t& area, snd_pcm_uframes_t offset) noexcept
+    {
+        return addBytesToPointer (area.addr, (area.first + offset * area.step) / 8);
+    }
+
     //==============================================================================
     template <class SampleType>
     struct ConverterHelper
@@ -491,6 +679,12 @@ public:
           inputId (inputDeviceID),
           outputId (outputDeviceID)
     {
+       #if JUCE_ALSA_FIFO_PRIORITY > 0
+        realtimeOptions.policy = Thread::RealtimeOptions::Policy::fifo;
+        realtimeOptions.priority = JUCE_ALSA_FIFO_PRIORITY;
+        hasRealtimeOptions = true;
+       #endif
+
         initialiseRatesAndChannels();
     }
 
@@ -666,6 +860,9 @@ public:
         outputChannelBuffer.setSize (1, 1);
 
         numCallbacks = 0;
+        numTimedCallbacks = 0;
+        totalCallbackDurationMs = 0;
+        maxCallbackDurationMs = 0;
     }
 
     void setCallback (AudioIODeviceCallback* const newCallback) noexcept
@@ -674,23 +871,31 @@ public:
         callback = newCallback;
     }
 
+    void setRealtimeOptions (const Thread::RealtimeOptions& newOptions)
+    {
+        const ScopedLock sl (realtimeOptionsLock);
+        realtimeOptions = newOptions;
+        hasRealtimeOptions = true;
+        realtimeOptionsChanged = true;
+    }
+
     void run() override
     {
+        applyRealtimeOptions();
+
         while (! threadShouldExit())
         {
+            if (realtimeOptionsChanged)
+                applyRealtimeOptions();
+
             if (inputDevice != nullptr && inputDevice->handle != nullptr)
             {
                 if (outputDevice == nullptr || outputDevice->handle == nullptr)
                 {
-                    JUCE_ALSA_FAILED (snd_pcm_wait (inputDevice->handle, 2000));
+                    inputDevice->waitForPeriod (2000);
 
                     if (threadShouldExit())
                         break;
-
-                    auto avail = snd_pcm_avail_update (inputDevice->handle);
-
-                    if (avail < 0)
-                        JUCE_ALSA_FAILED (snd_pcm_recover (inputDevice->handle, (int) avail, 0));
                 }
 
                 audioIoInProgress = true;
@@ -713,11 +918,18 @@ public:
 
                 if (callback != nullptr)
                 {
+                    auto callbackStart = Time::getMillisecondCounterHiRes();
+
                     callback->audioDeviceIOCallback (inputChannelDataForCallback.getRawDataPointer(),
                                                      inputChannelDataForCallback.size(),
                                                      outputChannelDataForCallback.getRawDataPointer(),
                                                      outputChannelDataForCallback.size(),
                                                      bufferSize);
+
+                    auto duration = Time::getMillisecondCounterHiRes() - callbackStart;
+                    totalCallbackDurationMs = totalCallbackDurationMs + duration;
+                    maxCallbackDurationMs = jmax (maxCallbackDurationMs.load(), duration);
+                    ++numTimedCallbacks;
                 }
                 else
                 {
@@ -728,16 +940,11 @@ public:
 
             if (outputDevice != nullptr && outputDevice->handle != nullptr)
             {
-                JUCE_ALSA_FAILED (snd_pcm_wait (outputDevice->handle, 2000));
+                outputDevice->waitForPeriod (2000);
 
                 if (threadShouldExit())
                     break;
 
-                auto avail = snd_pcm_avail_update (outputDevice->handle);
-
-                if (avail < 0)
-                    JUCE_ALSA_FAILED (snd_pcm_recover (outputDevice->handle, (int) avail, 0));
-
                 audioIoInProgress = true;
 
                 if (! outputDevice->writeToOutputDevice (outputChannelBuffer, bufferSize))
@@ -777,6 +984,31 @@ public:
         return result;
     }
 
+    AudioIODevice::CallbackStatistics getCallbackStatistics() const
+    {
+        AudioIODevice::CallbackStatistics stats;
+        stats.numCallbacks = numCallbacks;
+        stats.xrunCount = getXRunCount();
+
+        if (auto numTimed = numTimedCallbacks.load())
+            stats.averageCallbackDurationMs = totalCallbackDurationMs / numTimed;
+
+        stats.maxCallbackDurationMs = maxCallbackDurationMs;
+
+        int maxFramesLate = 0;
+
+        if (outputDevice != nullptr)
+            maxFramesLate = jmax (maxFramesLate, outputDevice->maxFramesLateOnWakeup.load());
+
+        if (inputDevice != nullptr)
+            maxFramesLate = jmax (maxFramesLate, inputDevice->maxFramesLateOnWakeup.load());
+
+        if (sampleRate > 0)
+            stats.maxWakeupLatencyMs = 1000.0 * maxFramesLate / sampleRate;
+
+        return stats;
+    }
+
     //==============================================================================
     String error;
     double sampleRate = 0;
@@ -791,11 +1023,17 @@ private:
     //==============================================================================
     const String inputId, outputId;
     std::unique_ptr<ALSADevice> outputDevice, inputDevice;
-    std::atomic<int> numCallbacks { 0 };
+    std::atomic<int> numCallbacks { 0 }, numTimedCallbacks { 0 };
+    std::atomic<double> totalCallbackDurationMs { 0 }, maxCallbackDurationMs { 0 };
     bool audioIoInProgress = false;
 
     CriticalSection callbackLock;
 
+    CriticalSection realtimeOptionsLock;
+    Thread::RealtimeOptions realtimeOptions;
+    bool hasRealtimeOptions = false;
+    std::atomic<bool> realtimeOptionsChanged { false };
+
     AudioBuffer<float> inputChannelBuffer, outputChannelBuffer;
     Array<const float*> inputChannelDataForCallback;
     Array<float*> outputChannelDataForCallback;
@@ -813,6 +1051,28 @@ private:
         return true;
     }
 
+    // (called on the audio thread)
+    void applyRealtimeOptions()
+    {
+        Thread::RealtimeOptions options;
+
+        {
+            const ScopedLock sl (realtimeOptionsLock);
+            realtimeOptionsChanged = false;
+
+            if (! hasRealtimeOptions)
+                return;
+
+            options = realtimeOptions;
+        }
+
+        if (options.periodMs <= 0 && sampleRate > 0)
+            options.periodMs = 1000.0 * bufferSize / sampleRate;
+
+        if (! Thread::setCurrentThreadRealtime (options))
+            JUCE_ALSA_LOG ("Couldn't apply the real-time options to the audio thread");
+    }
+
     void initialiseRatesAndChannels()
     {
         sampleRates.clear();
@@ -935,6 +1195,13 @@ public:
     int getInputLatencyInSamples() override          { return internal.inputLatency; }
 
     int getXRunCount() const noexcept override       { return internal.getXRunCount(); }
+    CallbackStatistics getCallbackStatistics() const override   { return internal.getCallbackStatistics(); }
+
+    bool setAudioThreadRealtimeOptions (const Thread::RealtimeOptions& options) override
+    {
+        internal.setRealtimeOptions (options);
+        return true;
+    }
 
     void start (AudioIODeviceCallback* callback) override
     {
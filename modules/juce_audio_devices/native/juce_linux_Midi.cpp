@@ -201,10 +201,10 @@ public:
             }
         }
 
-        void handleIncomingMidiMessage (const MidiMessage& message) const
+        void handleIncomingMidiData (const uint8* messageData, int numBytes, double timeStamp) const
         {
             if (callbackEnabled)
-                callback->handleIncomingMidiMessage (midiInput, message);
+                callback->handleIncomingMidiData (midiInput, messageData, numBytes, timeStamp);
         }
 
         void handlePartialSysexMessage (const uint8* messageData, int numBytesSoFar, double timeStamp)
@@ -255,12 +255,12 @@ public:
             inputThread->signalThreadShouldExit();
     }
 
-    void handleIncomingMidiMessage (snd_seq_event* event, const MidiMessage& message)
+    void handleIncomingMidiData (snd_seq_event* event, const uint8* messageData, int numBytes, double timeStamp)
     {
         const ScopedLock sl (callbackLock);
 
         if (auto* port = ports[event->dest.port])
-            port->handleIncomingMidiMessage (message);
+            port->handleIncomingMidiData (messageData, numBytes, timeStamp);
     }
 
     void handlePartialSysexMessage (snd_seq_event* event, const uint8* messageData, int numBytesSoFar, double timeStamp)
@@ -340,15 +340,24 @@ private:
 
                             if (snd_seq_event_input (seqHandle, &inputEvent) >= 0)
                             {
-                                // xxx what about SYSEXes that are too big for the buffer?
-                                auto numBytes = snd_midi_event_decode (midiParser, buffer,
-                                                                       maxEventSize, inputEvent);
+                                auto time = Time::getMillisecondCounter() * 0.001;
 
-                                snd_midi_event_reset_decode (midiParser);
+                                if (inputEvent->type == SND_SEQ_EVENT_SYSEX)
+                                {
+                                    // A sysex already holds its raw bytes, so it can be passed on without
+                                    // being decoded into the buffer, however big it is
+                                    concatenator.pushMidiData (inputEvent->data.ext.ptr, (int) inputEvent->data.ext.len,
+                                                               time, inputEvent, client);
+                                }
+                                else
+                                {
+                                    auto numBytes = snd_midi_event_decode (midiParser, buffer,
+                                                                           maxEventSize, inputEvent);
 
-                                concatenator.pushMidiData (buffer, (int) numBytes,
-                                                           Time::getMillisecondCounter() * 0.001,
-                                                           inputEvent, client);
+                                    snd_midi_event_reset_decode (midiParser);
+
+                                    concatenator.pushMidiData (buffer, (int) numBytes, time, inputEvent, client);
+                                }
 
                                 snd_seq_free_event (inputEvent);
                             }
@@ -363,7 +372,8 @@ private:
 
     private:
         AlsaClient& client;
-        MidiDataConcatenator concatenator { 2048 };
+        // (preallocated so that typical sysex messages can be assembled without allocating)
+        MidiDataConcatenator concatenator { 16 * 1024 };
     };
 
     std::unique_ptr<MidiInputThread> inputThread;
@@ -464,12 +464,10 @@ public:
         }
     }
 
-    void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
+    static void packStreamInfo (const FlacNamespace::FLAC__StreamMetadata_StreamInfo& info,
+                                unsigned char* buffer)
     {
         using namespace FlacNamespace;
-        auto& info = metadata->data.stream_info;
-
-        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
         const unsigned int channelsMinus1 = info.channels - 1;
         const unsigned int bitsMinus1 = info.bits_per_sample - 1;
 
@@ -483,6 +481,14 @@ public:
         buffer[13] = (FLAC__byte) (((bitsMinus1 & 0x0f) << 4) | (unsigned int) ((info.total_samples >> 32) & 0x0f));
         packUint32 ((FLAC__uint32) info.total_samples, buffer + 14, 4);
         memcpy (buffer + 18, info.md5sum, 16);
+    }
+
+    void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
+    {
+        using namespace FlacNamespace;
+
+        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
+        packStreamInfo (metadata->data.stream_info, buffer);
 
         const bool seekOk = output->setPosition (streamStartPos + 4);
         ignoreUnused (seekOk);
@@ -536,6 +542,389 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
 
+//==============================================================================
+/*  Splits the audio into chunks of whole FLAC frames, and encodes each chunk with its
+    own libFLAC encoder on a ThreadPool. Frames don't depend on each other, so the only
+    thing that differs from a serially-encoded stream is each frame's number, which is
+    rewritten (along with the header and frame CRCs) before the frames are written out
+    in order. libFLAC only calculates the MD5 signature over a whole stream, so that is
+    left unset, which the format allows.
+*/
+class ParallelFlacWriter  : public AudioFormatWriter
+{
+public:
+    ParallelFlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits,
+                        int qualityOptionIndex, ThreadPool& poolToUse)
+        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
+          pool (poolToUse),
+          quality (qualityOptionIndex),
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
+    {
+        using namespace FlacNamespace;
+
+        // Find the block size that this compression level would choose, so that every
+        // chunk apart from the last one can be an exact number of frames
+        auto* encoder = FLAC__stream_encoder_new();
+        configureEncoder (encoder, 0);
+        blockSize = FLAC__stream_encoder_get_max_lpc_order (encoder) == 0 ? 1152 : 4096;
+        FLAC__stream_encoder_delete (encoder);
+
+        ok = output->write ("fLaC", 4);
+        writeStreamInfo();
+    }
+
+    ~ParallelFlacWriter() override
+    {
+        if (ok)
+        {
+            submitChunk();
+
+            if (writeFinishedChunks (0))
+            {
+                writeStreamInfo();
+                output->flush();
+            }
+        }
+        else
+        {
+            for (auto* chunk : chunksInProgress)
+                pool.waitForJobToFinish (chunk, -1);
+
+            output = nullptr; // to stop the base class deleting this, as it needs to be returned
+                              // to the caller of createWriter()
+        }
+    }
+
+    //==============================================================================
+    bool write (const int** samplesToWrite, int numSamples) override
+    {
+        if (! ok || failed)
+            return false;
+
+        auto bitsToShift = 32 - (int) bitsPerSample;
+
+        for (int done = 0; done < numSamples;)
+        {
+            if (currentChunk == nullptr)
+                currentChunk.reset (new EncoderJob (*this, (uint32) (numChunksStarted++ * framesPerChunk)));
+
+            auto numToCopy = jmin (numSamples - done, currentChunk->getSpaceLeft());
+
+            for (unsigned int i = 0; i < numChannels; ++i)
+            {
+                auto* dest = currentChunk->getChannel ((int) i) + currentChunk->numSamples;
+
+                if (samplesToWrite[i] == nullptr)
+                    zeromem (dest, sizeof (int) * (size_t) numToCopy);
+                else
+                    for (int j = 0; j < numToCopy; ++j)
+                        dest[j] = samplesToWrite[i][done + j] >> bitsToShift;
+            }
+
+            currentChunk->numSamples += numToCopy;
+            done += numToCopy;
+
+            if (currentChunk->getSpaceLeft() == 0)
+            {
+                submitChunk();
+
+                // keep a couple of chunks queued for each thread, but don't let the writer
+                // run too far ahead of the encoders
+                if (! writeFinishedChunks (2 * pool.getNumThreads()))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool ok = false;
+
+private:
+    //==============================================================================
+    class EncoderJob  : public ThreadPoolJob
+    {
+    public:
+        EncoderJob (ParallelFlacWriter& w, uint32 firstFrame)
+            : ThreadPoolJob ("FLAC encoder"),
+              writer (w),
+              firstFrameNumber (firstFrame),
+              samples ((size_t) (w.numChannels * (unsigned int) w.getChunkSize()))
+        {
+        }
+
+        int* getChannel (int channel) noexcept      { return samples + channel * writer.getChunkSize(); }
+        int getSpaceLeft() const noexcept           { return writer.getChunkSize() - numSamples; }
+
+        JobStatus runJob() override
+        {
+            using namespace FlacNamespace;
+
+            auto* encoder = FLAC__stream_encoder_new();
+            writer.configureEncoder (encoder, writer.blockSize);
+
+            HeapBlock<const FLAC__int32*> channels (writer.numChannels);
+
+            for (unsigned int i = 0; i < writer.numChannels; ++i)
+                channels[i] = getChannel ((int) i);
+
+            succeeded = FLAC__stream_encoder_init_stream (encoder, frameCallback, nullptr, nullptr, nullptr, this)
+                            == FLAC__STREAM_ENCODER_INIT_STATUS_OK
+                         && (numSamples == 0 || FLAC__stream_encoder_process (encoder, channels, (unsigned int) numSamples) != 0);
+
+            succeeded = (FLAC__stream_encoder_finish (encoder) != 0) && succeeded;
+            FLAC__stream_encoder_delete (encoder);
+
+            return jobHasFinished;
+        }
+
+        ParallelFlacWriter& writer;
+        const uint32 firstFrameNumber;
+        HeapBlock<int> samples;
+        int numSamples = 0;
+
+        MemoryOutputStream encodedFrames;
+        uint32 numFrames = 0, minFrameSize = 0, maxFrameSize = 0;
+        bool succeeded = false;
+
+    private:
+        static FlacNamespace::FLAC__StreamEncoderWriteStatus frameCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                            const FlacNamespace::FLAC__byte buffer[],
+                                                                            size_t bytes,
+                                                                            unsigned int samples,
+                                                                            unsigned int,
+                                                                            void* client_data)
+        {
+            // Each of our encoders writes its own stream header and metadata, which are
+            // skipped here, and then each frame in a single callback
+            if (samples > 0 && ! static_cast<EncoderJob*> (client_data)->addFrame (buffer, bytes))
+                return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+
+            return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+        }
+
+        bool addFrame (const uint8* frame, size_t size)
+        {
+            // A frame header starts with a sync code, the block size, sample rate, channel
+            // and bit depth fields, then the UTF-8 style coded frame number, then optional
+            // block size and sample rate values, and finally a CRC-8 of the header. The
+            // frame ends with a CRC-16 of everything before it.
+            if (size < 8 || frame[0] != 0xff || (frame[1] & 0xfe) != 0xf8)
+                return false;
+
+            auto numberLength = 1;
+
+            for (auto b = frame[4]; (b & 0x80) != 0 && numberLength < 7; b = (uint8) (b << 1))
+                ++numberLength;
+
+            if (numberLength > 1)
+                --numberLength;
+
+            auto blockSizeCode  = frame[2] >> 4;
+            auto sampleRateCode = frame[2] & 0x0f;
+            auto extraLength = (blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                             + (sampleRateCode == 12 ? 1 : ((sampleRateCode == 13 || sampleRateCode == 14) ? 2 : 0));
+
+            auto oldHeaderSize = (size_t) (4 + numberLength + extraLength);
+
+            if (oldHeaderSize + 3 > size)
+                return false;
+
+            uint8 header[16];
+            memcpy (header, frame, 4);
+            auto headerSize = 4 + writeCodedNumber (firstFrameNumber + numFrames, header + 4);
+            memcpy (header + headerSize, frame + 4 + numberLength, (size_t) extraLength);
+            headerSize += extraLength;
+            header[headerSize] = crc8 (header, (size_t) headerSize);
+            ++headerSize;
+
+            auto* body = frame + oldHeaderSize + 1;
+            auto bodySize = size - (oldHeaderSize + 1) - 2;
+
+            auto crc = crc16 (0, header, (size_t) headerSize);
+            crc = crc16 (crc, body, bodySize);
+
+            const uint8 footer[] = { (uint8) (crc >> 8), (uint8) (crc & 0xff) };
+
+            encodedFrames.write (header, (size_t) headerSize);
+            encodedFrames.write (body, bodySize);
+            encodedFrames.write (footer, 2);
+
+            auto frameSize = (uint32) ((size_t) headerSize + bodySize + 2);
+            minFrameSize = numFrames == 0 ? frameSize : jmin (minFrameSize, frameSize);
+            maxFrameSize = jmax (maxFrameSize, frameSize);
+            ++numFrames;
+            return true;
+        }
+
+        static int writeCodedNumber (uint32 value, uint8* dest) noexcept
+        {
+            if (value < 0x80)
+            {
+                dest[0] = (uint8) value;
+                return 1;
+            }
+
+            auto numBytes = value < 0x800 ? 2 : value < 0x10000 ? 3 : value < 0x200000 ? 4 : value < 0x4000000 ? 5 : 6;
+
+            for (int i = numBytes; --i > 0;)
+            {
+                dest[i] = (uint8) (0x80 | (value & 0x3f));
+                value >>= 6;
+            }
+
+            dest[0] = (uint8) ((0xff00 >> numBytes) | value);
+            return numBytes;
+        }
+
+        static uint8 crc8 (const uint8* data, size_t size) noexcept
+        {
+            uint8 crc = 0;
+
+            while (size-- > 0)
+            {
+                crc ^= *data++;
+
+                for (int bit = 0; bit < 8; ++bit)
+                    crc = (uint8) ((crc & 0x80) != 0 ? (crc << 1) ^ 0x07 : crc << 1);
+            }
+
+            return crc;
+        }
+
+        static uint16 crc16 (uint16 crc, const uint8* data, size_t size) noexcept
+        {
+            static const auto table = []
+            {
+                std::array<uint16, 256> t;
+
+                for (int i = 0; i < 256; ++i)
+                {
+                    auto value = (uint16) (i << 8);
+
+                    for (int bit = 0; bit < 8; ++bit)
+                        value = (uint16) ((value & 0x8000) != 0 ? (value << 1) ^ 0x8005 : value << 1);
+
+                    t[(size_t) i] = value;
+                }
+
+                return t;
+            }();
+
+            while (size-- > 0)
+                crc = (uint16) ((crc << 8) ^ table[(size_t) ((crc >> 8) ^ *data++)]);
+
+            return crc;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (EncoderJob)
+    };
+
+    //==============================================================================
+    ThreadPool& pool;
+    const int quality;
+    const int64 streamStartPos;
+    int blockSize = 4096;
+    enum { framesPerChunk = 16 };
+
+    std::unique_ptr<EncoderJob> currentChunk;
+    OwnedArray<EncoderJob> chunksInProgress;
+    int64 numChunksStarted = 0, totalSamplesWritten = 0;
+    uint32 minFrameSize = 0, maxFrameSize = 0;
+    bool failed = false;
+
+    int getChunkSize() const noexcept   { return blockSize * framesPerChunk; }
+
+    void configureEncoder (FlacNamespace::FLAC__StreamEncoder* encoder, int encoderBlockSize) const
+    {
+        using namespace FlacNamespace;
+
+        if (quality > 0)
+            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, quality));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
+        FLAC__stream_encoder_set_channels (encoder, numChannels);
+        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
+        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
+        FLAC__stream_encoder_set_blocksize (encoder, (unsigned int) encoderBlockSize);
+        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+    }
+
+    void submitChunk()
+    {
+        if (currentChunk != nullptr && currentChunk->numSamples > 0)
+        {
+            pool.addJob (currentChunk.get(), false);
+            chunksInProgress.add (currentChunk.release());
+        }
+
+        currentChunk.reset();
+    }
+
+    bool writeFinishedChunks (int maxChunksToLeaveInProgress)
+    {
+        while (! chunksInProgress.isEmpty())
+        {
+            auto* chunk = chunksInProgress.getFirst();
+
+            if (chunksInProgress.size() <= maxChunksToLeaveInProgress && pool.contains (chunk))
+                break;
+
+            pool.waitForJobToFinish (chunk, -1);
+
+            if (! failed)
+                failed = ! (chunk->succeeded && output->write (chunk->encodedFrames.getData(),
+                                                               chunk->encodedFrames.getDataSize()));
+
+            if (chunk->numFrames > 0)
+            {
+                minFrameSize = minFrameSize == 0 ? chunk->minFrameSize : jmin (minFrameSize, chunk->minFrameSize);
+                maxFrameSize = jmax (maxFrameSize, chunk->maxFrameSize);
+            }
+
+            totalSamplesWritten += chunk->numSamples;
+            chunksInProgress.remove (0);
+        }
+
+        return ! failed;
+    }
+
+    void writeStreamInfo()
+    {
+        using namespace FlacNamespace;
+
+        FLAC__StreamMetadata_StreamInfo info;
+        zerostruct (info);
+
+        info.min_blocksize = info.max_blocksize = (unsigned int) blockSize;
+        info.min_framesize = minFrameSize;
+        info.max_framesize = maxFrameSize;
+        info.sample_rate = (unsigned int) sampleRate;
+        info.channels = numChannels;
+        info.bits_per_sample = jmin ((unsigned int) 24, bitsPerSample);
+        info.total_samples = (FLAC__uint64) totalSamplesWritten;
+
+        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
+        FlacWriter::packStreamInfo (info, buffer);
+
+        const bool seekOk = output->setPosition (streamStartPos + 4);
+        ignoreUnused (seekOk);
+
+        // if this fails, you've given it an output stream that can't seek! It needs
+        // to be able to seek back to write the header
+        jassert (seekOk);
+
+        // This is the only metadata block, so it's flagged as the last one
+        output->writeByte ((char) 0x80);
+        output->writeByte (0);
+        output->writeShortBigEndian ((short) FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+        output->write (buffer, FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelFlacWriter)
+};
+
 
 //==============================================================================
 FlacAudioFormat::FlacAudioFormat()  : AudioFormat (flacFormatName, ".flac") {}
@@ -587,11 +976,183 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     return nullptr;
 }
 
+AudioFormatWriter* FlacAudioFormat::createParallelWriterFor (OutputStream* out,
+                                                             double sampleRate,
+                                                             unsigned int numberOfChannels,
+                                                             int bitsPerSample,
+                                                             int qualityOptionIndex,
+                                                             ThreadPool& threadPoolToUse)
+{
+    if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample))
+    {
+        std::unique_ptr<ParallelFlacWriter> w (new ParallelFlacWriter (out, sampleRate, numberOfChannels,
+                                                                       (uint32) bitsPerSample, qualityOptionIndex,
+                                                                       threadPoolToUse));
+        if (w->ok)
+            return w.release();
+    }
+
+    return nullptr;
+}
+
 StringArray FlacAudioFormat::getQualityOptions()
 {
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct FlacAudioFormatTests  : public UnitTest
+{
+    FlacAudioFormatTests()
+        : UnitTest ("FLAC audio format tests", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        ThreadPool pool (3);
+
+        for (auto quality : { 0, 5, 8 })
+        {
+            for (auto numSamples : { 0, 1000, 4096 * 16, 4096 * 16 * 5 + 123, 300000 })
+            {
+                for (auto bits : { 16, 24 })
+                {
+                    beginTest ("Parallel writer round trip, quality " + String (quality) + ", "
+                                 + String (numSamples) + " samples, " + String (bits) + " bits");
+
+                    runRoundTripTest (pool, quality, numSamples, bits);
+                }
+            }
+        }
+
+        beginTest ("Parallel writer applies the quality setting");
+        {
+            constexpr int numSamples = 300000, bits = 16;
+            AudioBuffer<float> source (2, numSamples);
+            Random r (1);
+
+            // something more like music than the round trip signal, so that the higher qualities' predictors can help
+            for (int i = 0; i < numSamples; ++i)
+                for (int ch = 0; ch < 2; ++ch)
+                    source.setSample (ch, i, 0.3f * std::sin ((float) i * 0.013f + (float) ch)
+                                               + 0.2f * std::sin ((float) i * 0.0517f)
+                                               + 0.1f * std::sin ((float) i * 0.173f + 2.0f * (float) ch)
+                                               + r.nextFloat() * 0.002f - 0.001f);
+
+            auto getSize = [&] (int quality, bool parallel)
+            {
+                MemoryBlock mb;
+                write (mb, source, parallel ? &pool : nullptr, quality, bits);
+                return (int64) mb.getSize();
+            };
+
+            const auto fastest = getSize (0, true), highest = getSize (8, true);
+            expectLessThan (highest, fastest);
+
+            // The frames aren't identical to the serial writer's, but they should compress about as well
+            for (auto quality : { 0, 5, 8 })
+            {
+                const auto serialSize = getSize (quality, false), parallelSize = getSize (quality, true);
+                expectLessThan (std::abs (parallelSize - serialSize), serialSize / 20);
+            }
+        }
+    }
+
+    void runRoundTripTest (ThreadPool& pool, int quality, int numSamples, int bits)
+    {
+        const auto source = createTestSignal (numSamples, numSamples + bits);
+
+        MemoryBlock mb;
+        write (mb, source, &pool, quality, bits, numSamples);
+
+        FlacAudioFormat format;
+        auto reader = rawToUniquePtr (format.createReaderFor (new MemoryInputStream (mb, false), true));
+        expect (reader != nullptr);
+
+        if (reader == nullptr)
+            return;
+
+        expectEquals ((int) reader->lengthInSamples, numSamples);
+        expectEquals ((int) reader->bitsPerSample, bits);
+
+        if (numSamples == 0)
+            return;
+
+        AudioBuffer<float> result (2, numSamples);
+        reader->read (&result, 0, numSamples, 0, true, true);
+
+        auto scale = (float) (1 << (bits - 1));
+        auto maxError = 0.0f;
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                maxError = jmax (maxError, std::abs (source.getSample (ch, i) - result.getSample (ch, i)) * scale);
+
+        expect (maxError <= 1.0f, "Decoded audio differs from the source");
+
+        // reading from an arbitrary position makes the decoder seek using the frame numbers
+        auto start = numSamples * 2 / 3;
+        AudioBuffer<float> part (2, numSamples - start);
+        reader->read (&part, 0, part.getNumSamples(), start, true, true);
+
+        auto partMatches = true;
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < part.getNumSamples(); ++i)
+                partMatches = partMatches && part.getSample (ch, i) == result.getSample (ch, start + i);
+
+        expect (partMatches, "Audio read after seeking differs");
+    }
+
+    static AudioBuffer<float> createTestSignal (int numSamples, int seed)
+    {
+        AudioBuffer<float> source (2, jmax (1, numSamples));
+        Random r (seed);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto sine = std::sin ((float) i * 0.01f) * 0.5f;
+            source.setSample (0, i, sine);
+            source.setSample (1, i, sine * 0.5f + r.nextFloat() * 0.1f - 0.05f);
+        }
+
+        return source;
+    }
+
+    // Writes the signal with the parallel writer if a pool is given, or the serial one if not
+    void write (MemoryBlock& mb, const AudioBuffer<float>& source, ThreadPool* pool, int quality, int bits, int numSamples = -1)
+    {
+        if (numSamples < 0)
+            numSamples = source.getNumSamples();
+
+        FlacAudioFormat format;
+        auto* stream = new MemoryOutputStream (mb, false);
+        auto writer = rawToUniquePtr (pool != nullptr ? format.createParallelWriterFor (stream, 44100.0, 2, bits, quality, *pool)
+                                                      : format.createWriterFor (stream, 44100.0, 2, bits, {}, quality));
+        expect (writer != nullptr);
+
+        if (writer == nullptr)
+            return;
+
+        // write in awkward sizes, so that blocks straddle the chunk boundaries
+        Random r (numSamples);
+
+        for (int pos = 0; pos < numSamples;)
+        {
+            auto num = jmin (numSamples - pos, 777 + r.nextInt (5000));
+            expect (writer->writeFromAudioSampleBuffer (source, pos, num));
+            pos += num;
+        }
+    }
+};
+
+static const FlacAudioFormatTests flacAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
@@ -65,6 +65,28 @@ public:
                                         int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
 
+    /** Creates a writer that encodes on several threads at once.
+
+        The audio is split into chunks of a few FLAC frames, and each chunk is encoded
+        by a job on the given ThreadPool before being written to the stream in order.
+        The result is a standard, seekable FLAC stream that decodes to the same audio as
+        one from createWriterFor(), and the MD5 signature in its STREAMINFO block is left
+        unset, which the format allows. The frames themselves may differ slightly, because
+        each chunk uses a fixed block size and a fresh encoder, so adaptive choices such as
+        loose mid-side stereo start again at every chunk boundary.
+
+        The pool can be shared between several writers, and must outlive them. As with
+        createWriterFor(), the stream must be seekable, and will be deleted by the writer.
+
+        @returns a writer, or nullptr if the parameters aren't supported
+    */
+    AudioFormatWriter* createParallelWriterFor (OutputStream* streamToWriteTo,
+                                                double sampleRateToUse,
+                                                unsigned int numberOfChannels,
+                                                int bitsPerSample,
+                                                int qualityOptionIndex,
+                                                ThreadPool& threadPoolToUse);
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
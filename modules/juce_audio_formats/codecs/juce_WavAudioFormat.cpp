@@ -1958,6 +1958,61 @@ struct WaveAudioFormatTests : public UnitTest
             expect (a[WavAudioFormat::riffInfoSource] == "source");
             expect (a[WavAudioFormat::internationalStandardRecordingCode] == "UUVVVXXYYYYY");
         }
+
+        {
+            beginTest ("Preallocated files can be written through a ThreadedWriter");
+
+            const auto numChannels = 2, numSamples = 100000, blockSize = 512;
+
+            AudioBuffer<float> source (numChannels, numSamples);
+            auto random = getRandom();
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    source.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+            TemporaryFile tempFile (".wav");
+            TimeSliceThread thread ("Preallocated WAV writer");
+            thread.startThread();
+
+            {
+                // (asks for more space than is needed, to check that the excess is trimmed off)
+                auto* writer = format.createPreallocatedWriterFor (tempFile.getFile(), 44100.0, AudioChannelSet::stereo(),
+                                                                   24, {}, 0, numSamples * 2, 4096);
+                expect (writer != nullptr);
+
+                if (writer == nullptr)
+                    return;
+
+                AudioFormatWriter::ThreadedWriter threadedWriter (writer, thread, 8192);
+                threadedWriter.setFlushInterval (16384);
+
+                for (int pos = 0; pos < numSamples;)
+                {
+                    const auto num = jmin (blockSize, numSamples - pos);
+                    const float* channels[] = { source.getReadPointer (0, pos), source.getReadPointer (1, pos) };
+
+                    if (threadedWriter.write (channels, num))
+                        pos += num;
+                    else
+                        Thread::sleep (1);
+                }
+            }
+
+            thread.stopThread (5000);
+
+            MemoryBlock expectedData;
+
+            {
+                auto writer = rawToUniquePtr (format.createWriterFor (new MemoryOutputStream (expectedData, false), 44100.0,
+                                                                      AudioChannelSet::stereo(), 24, {}, 0));
+                expect (writer->writeFromAudioSampleBuffer (source, 0, numSamples));
+            }
+
+            MemoryBlock writtenData;
+            expect (tempFile.getFile().loadFileAsData (writtenData));
+            expect (writtenData == expectedData);
+        }
     }
 
 private:
@@ -88,4 +88,91 @@ AudioFormatWriter* AudioFormat::createWriterFor (OutputStream* streamToWriteTo,
     return nullptr;
 }
 
+//==============================================================================
+namespace AudioFormatHelpers
+{
+    /*  Writes to a preallocated file, and when deleted, trims the file back to the
+        furthest point that was written, which also hands back any unused space.
+    */
+    struct PreallocatedFileOutputStream  : public OutputStream
+    {
+        PreallocatedFileOutputStream (const File& file, size_t bufferSize)
+            : stream (file, bufferSize)
+        {
+        }
+
+        ~PreallocatedFileOutputStream() override
+        {
+            if (stream.openedOk() && stream.setPosition (endPosition))
+                stream.truncate();
+        }
+
+        bool openAndPreallocate (int64 totalLength)
+        {
+            if (stream.failedToOpen() || ! stream.setPosition (0) || stream.truncate().failed())
+                return false;
+
+            // if the space can't be reserved, the file will just grow as it's written
+            stream.preallocate (totalLength);
+            return true;
+        }
+
+        void flush() override                   { stream.flush(); }
+        int64 getPosition() override            { return stream.getPosition(); }
+        bool setPosition (int64 pos) override   { return stream.setPosition (pos); }
+
+        bool write (const void* data, size_t numBytes) override
+        {
+            auto ok = stream.write (data, numBytes);
+            endPosition = jmax (endPosition, stream.getPosition());
+            return ok;
+        }
+
+        bool writeRepeatedByte (uint8 byte, size_t numTimesToRepeat) override
+        {
+            auto ok = stream.writeRepeatedByte (byte, numTimesToRepeat);
+            endPosition = jmax (endPosition, stream.getPosition());
+            return ok;
+        }
+
+        FileOutputStream stream;
+        int64 endPosition = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PreallocatedFileOutputStream)
+    };
+}
+
+AudioFormatWriter* AudioFormat::createPreallocatedWriterFor (const File& fileToWriteTo,
+                                                             double sampleRateToUse,
+                                                             const AudioChannelSet& channelLayout,
+                                                             int bitsPerSample,
+                                                             const StringPairArray& metadataValues,
+                                                             int qualityOptionIndex,
+                                                             int64 expectedLengthInSamples,
+                                                             size_t bufferSizeBytes)
+{
+    auto fileExisted = fileToWriteTo.exists();
+    auto out = std::make_unique<AudioFormatHelpers::PreallocatedFileOutputStream> (fileToWriteTo, bufferSizeBytes);
+
+    // (allows a bit of extra room for the header and any metadata chunks)
+    auto bytesPerFrame = (int64) channelLayout.size() * bitsPerSample / 8;
+
+    if (out->openAndPreallocate (jmax ((int64) 0, expectedLengthInSamples) * bytesPerFrame + 65536))
+    {
+        if (auto* writer = createWriterFor (out.get(), sampleRateToUse, channelLayout,
+                                            bitsPerSample, metadataValues, qualityOptionIndex))
+        {
+            out.release();
+            return writer;
+        }
+    }
+
+    out.reset();
+
+    if (! fileExisted)
+        fileToWriteTo.deleteFile();
+
+    return nullptr;
+}
+
 } // namespace juce
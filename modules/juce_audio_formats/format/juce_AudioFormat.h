@@ -191,6 +191,45 @@ public:
                                                 const StringPairArray& metadataValues,
                                                 int qualityOptionIndex);
 
+    /** Tries to create a writer that records into a file which has its disk space
+        reserved in advance.
+
+        This is intended for long recordings, where writing a file a buffer at a time
+        through a normal FileOutputStream will fragment the disk and make a system call
+        for every block. Instead, the space for the expected length is preallocated (if
+        the OS and filesystem support it), the data goes through one large write buffer,
+        and any of the reserved space that didn't get used is released when the writer
+        is deleted.
+
+        The format must be one whose writer can seek back to the start of the stream to
+        fill in its header, like WAV or AIFF. Any existing file will be overwritten.
+
+        The writer that is returned can be passed to an AudioFormatWriter::ThreadedWriter
+        in just the same way as any other writer.
+
+        @param fileToWriteTo            the file to create
+        @param sampleRateToUse          the sample rate for the file
+        @param channelLayout            the channel layout for the file
+        @param bitsPerSample            the bits per sample to use
+        @param metadataValues           a set of metadata values that the writer should try to write
+        @param qualityOptionIndex       the index of one of compression qualities returned by the
+                                        getQualityOptions() method
+        @param expectedLengthInSamples  the number of samples that you expect to write. This is only
+                                        used to decide how much space to reserve, so it's fine to
+                                        write more or less than this
+        @param bufferSizeBytes          the size of the buffer that the data is written through
+        @returns the new writer, or nullptr if the file or writer couldn't be created
+        @see createWriterFor, FileOutputStream::preallocate
+    */
+    AudioFormatWriter* createPreallocatedWriterFor (const File& fileToWriteTo,
+                                                    double sampleRateToUse,
+                                                    const AudioChannelSet& channelLayout,
+                                                    int bitsPerSample,
+                                                    const StringPairArray& metadataValues,
+                                                    int qualityOptionIndex,
+                                                    int64 expectedLengthInSamples,
+                                                    size_t bufferSizeBytes = 1 << 20);
+
 protected:
     /** Creates an AudioFormat object.
 
@@ -26,6 +26,26 @@
 namespace juce
 {
 
+namespace BufferingAudioReaderHelpers
+{
+    static std::atomic<size_t> memoryBudget { 0 }, memoryUsage { 0 };
+
+    static bool reserveMemory (size_t numBytes, bool ignoreBudget) noexcept
+    {
+        auto budget = memoryBudget.load();
+        auto used = memoryUsage.load();
+
+        do
+        {
+            if (! ignoreBudget && budget > 0 && used + numBytes > budget)
+                return false;
+        }
+        while (! memoryUsage.compare_exchange_weak (used, used + numBytes));
+
+        return true;
+    }
+}
+
 BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
@@ -53,15 +73,100 @@ void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
     timeoutMs = timeoutMilliseconds;
 }
 
+void BufferingAudioReader::prefetch (Range<int64> samplesToPrefetch)
+{
+    samplesToPrefetch = samplesToPrefetch.getIntersectionWith ({ 0, lengthInSamples });
+
+    if (samplesToPrefetch.isEmpty())
+        return;
+
+    {
+        const ScopedLock sl (lock);
+        prefetchHints.add (samplesToPrefetch);
+
+        if (prefetchHints.size() > maxNumPrefetchHints)
+            prefetchHints.remove (0);
+    }
+
+    thread.moveToFrontOfQueue (this);
+}
+
+void BufferingAudioReader::clearPrefetchHints()
+{
+    const ScopedLock sl (lock);
+    prefetchHints.clear();
+}
+
+bool BufferingAudioReader::isBuffered (Range<int64> samples) const
+{
+    samples = samples.getIntersectionWith ({ 0, lengthInSamples });
+
+    const ScopedLock sl (lock);
+
+    for (auto pos = samples.getStart(); pos < samples.getEnd();)
+    {
+        auto* block = getBlockContaining (pos);
+
+        if (block == nullptr)
+            return false;
+
+        pos = block->range.getEnd();
+    }
+
+    return true;
+}
+
+BufferingAudioReader::Statistics BufferingAudioReader::getStatistics() const noexcept
+{
+    Statistics stats;
+    stats.numHits          = numHits.load();
+    stats.numMisses        = numMisses.load();
+    stats.numTimeouts      = numTimeouts.load();
+    stats.totalStallTimeMs = (double) stallTimeMicroseconds.load() / 1000.0;
+    return stats;
+}
+
+void BufferingAudioReader::resetStatistics() noexcept
+{
+    numHits = 0;
+    numMisses = 0;
+    numTimeouts = 0;
+    stallTimeMicroseconds = 0;
+}
+
+void BufferingAudioReader::setGlobalMemoryBudget (size_t maxNumBytes) noexcept
+{
+    BufferingAudioReaderHelpers::memoryBudget = maxNumBytes;
+}
+
+size_t BufferingAudioReader::getGlobalMemoryBudget() noexcept
+{
+    return BufferingAudioReaderHelpers::memoryBudget;
+}
+
+size_t BufferingAudioReader::getGlobalMemoryUsage() noexcept
+{
+    return BufferingAudioReaderHelpers::memoryUsage;
+}
+
 bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
                                         int64 startSampleInFile, int numSamples)
 {
     auto startTime = Time::getMillisecondCounter();
+    auto startTimeHiRes = Time::getMillisecondCounterHiRes();
     clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
                                        startSampleInFile, numSamples, lengthInSamples);
 
     const ScopedLock sl (lock);
+    nextReadEnd = startSampleInFile + numSamples;
     nextReadPosition = startSampleInFile;
+    updatePlaybackRate (startSampleInFile);
+
+    for (int i = prefetchHints.size(); --i >= 0;)
+        if (prefetchHints.getReference (i).contains (startSampleInFile))
+            prefetchHints.remove (i);
+
+    bool hasWaited = false, hasTimedOut = false;
 
     while (numSamples > 0)
     {
@@ -95,19 +200,58 @@ bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels,
                     if (auto* dest = (float*) destSamples[j])
                         FloatVectorOperations::clear (dest + startOffsetInDestBuffer, numSamples);
 
+                hasTimedOut = true;
                 break;
             }
             else
             {
+                // (the blocks before this one have been copied already, so the background
+                // thread can move on to the ones that are still missing)
+                nextReadPosition = startSampleInFile;
                 ScopedUnlock ul (lock);
+
+                if (! hasWaited)
+                {
+                    hasWaited = true;
+                    thread.moveToFrontOfQueue (this);
+                }
+
                 Thread::yield();
             }
         }
     }
 
+    if (hasTimedOut)
+        ++numTimeouts;
+    else if (hasWaited)
+        ++numMisses;
+    else
+        ++numHits;
+
+    if (hasWaited)
+        stallTimeMicroseconds += (int64) ((Time::getMillisecondCounterHiRes() - startTimeHiRes) * 1000.0);
+
     return true;
 }
 
+void BufferingAudioReader::updatePlaybackRate (int64 startSample)
+{
+    auto now = Time::getMillisecondCounterHiRes();
+    auto elapsedMs = now - lastReadTime;
+    auto distance = startSample - lastReadStart;
+
+    // Gaps between reads that are too long, or jumps further than the buffered window,
+    // are treated as seeks, and don't say anything about the playback speed
+    if (lastReadStart >= 0 && elapsedMs > 0 && elapsedMs < 1000.0
+         && std::abs (distance) <= (int64) numBlocks * samplesPerBlock)
+    {
+        playbackRate = playbackRate * 0.8 + 0.2 * (double) distance * 1000.0 / elapsedMs;
+    }
+
+    lastReadStart = startSample;
+    lastReadTime = now;
+}
+
 BufferingAudioReader::BufferedBlock::BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples)
     : range (pos, pos + numSamples),
       buffer ((int) reader.numChannels, numSamples)
@@ -115,6 +259,17 @@ BufferingAudioReader::BufferedBlock::BufferedBlock (AudioFormatReader& reader, i
     reader.read (&buffer, 0, numSamples, pos, true, true);
 }
 
+BufferingAudioReader::BufferedBlock::~BufferedBlock()
+{
+    // (the memory was reserved by the reader that created the block)
+    BufferingAudioReaderHelpers::memoryUsage -= getSizeInBytes();
+}
+
+size_t BufferingAudioReader::BufferedBlock::getSizeInBytes() const noexcept
+{
+    return sizeof (float) * (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples();
+}
+
 BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (int64 pos) const noexcept
 {
     for (auto* b : blocks)
@@ -126,46 +281,105 @@ BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (i
 
 int BufferingAudioReader::useTimeSlice()
 {
-    return readNextBufferChunk() ? 1 : 100;
+    if (readNextBufferChunk())
+        return 1;
+
+    // Everything that's wanted is buffered, so wait until playback is likely to have
+    // moved into another block, which depends on how fast it's going
+    auto rate = playbackRate.load();
+
+    if (std::abs (rate) < 1.0)
+        return 100;
+
+    auto offsetInBlock = nextReadPosition.load() % samplesPerBlock;
+    auto samplesLeftInBlock = rate > 0 ? samplesPerBlock - offsetInBlock : offsetInBlock + 1;
+
+    return jlimit (1, 100, (int) ((double) samplesLeftInBlock * 500.0 / std::abs (rate)));
 }
 
-bool BufferingAudioReader::readNextBufferChunk()
+Array<int64> BufferingAudioReader::getBlocksToBuffer() const
 {
-    auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
-    auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
+    Array<int64> blockStarts;
 
-    OwnedArray<BufferedBlock> newBlocks;
+    auto addBlockContaining = [&] (int64 pos)
+    {
+        if (isPositiveAndBelow (pos, lengthInSamples))
+            blockStarts.addIfNotAlreadyThere ((pos / samplesPerBlock) * samplesPerBlock);
+    };
 
-    for (int i = blocks.size(); --i >= 0;)
-        if (blocks.getUnchecked (i)->range.intersects (Range<int64> (pos, endPos)))
-            newBlocks.add (blocks.getUnchecked (i));
+    // The blocks needed by the current read come first, then the rest of the window
+    // in the direction of playback..
+    auto pos = nextReadPosition.load();
+    auto step = playbackRate.load() < 0 ? -samplesPerBlock : samplesPerBlock;
 
-    if (newBlocks.size() == numBlocks)
-    {
-        newBlocks.clear (false);
-        return false;
-    }
+    for (auto p = pos; p < nextReadEnd.load() && blockStarts.size() < numBlocks; p = (p / samplesPerBlock + 1) * samplesPerBlock)
+        addBlockContaining (p);
+
+    for (int i = 0; i < numBlocks && blockStarts.size() < numBlocks; ++i)
+        addBlockContaining (pos + i * step);
 
-    for (auto p = pos; p < endPos; p += samplesPerBlock)
+    // ..followed by the prefetch hints, newest first
+    const ScopedLock sl (lock);
+    int numHintBlocks = 0;
+
+    for (int i = prefetchHints.size(); --i >= 0 && numHintBlocks < numBlocks;)
     {
-        if (getBlockContaining (p) == nullptr)
+        auto hint = prefetchHints.getReference (i);
+
+        for (auto p = (hint.getStart() / samplesPerBlock) * samplesPerBlock;
+             p < hint.getEnd() && numHintBlocks < numBlocks;
+             p += samplesPerBlock, ++numHintBlocks)
         {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
-            break; // just do one block
+            addBlockContaining (p);
         }
     }
 
+    return blockStarts;
+}
+
+bool BufferingAudioReader::readNextBufferChunk()
+{
+    auto blocksToBuffer = getBlocksToBuffer();
+
+    // First let go of the blocks that aren't wanted any more, so their memory can be reused..
+    OwnedArray<BufferedBlock> unwantedBlocks;
+
     {
         const ScopedLock sl (lock);
-        newBlocks.swapWith (blocks);
+
+        for (int i = blocks.size(); --i >= 0;)
+            if (! blocksToBuffer.contains (blocks.getUnchecked (i)->range.getStart()))
+                unwantedBlocks.add (blocks.removeAndReturn (i));
     }
 
-    for (int i = blocks.size(); --i >= 0;)
-        newBlocks.removeObject (blocks.getUnchecked (i), false);
+    auto hasChanged = ! unwantedBlocks.isEmpty();
+    unwantedBlocks.clear();
 
-    return true;
-}
+    // ..then read the most important block that's missing. The blocks that a pending read
+    // is waiting for are always allowed, but the others have to fit into the global budget.
+    const auto blockSizeInBytes = sizeof (float) * (size_t) numChannels * (size_t) samplesPerBlock;
+    const auto readStart = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
+    const auto readEnd = jmax (readStart + 1, nextReadEnd.load());
+
+    for (int i = 0; i < blocksToBuffer.size(); ++i)
+    {
+        auto pos = blocksToBuffer.getUnchecked (i);
+
+        if (getBlockContaining (pos) != nullptr)
+            continue;
+
+        if (! BufferingAudioReaderHelpers::reserveMemory (blockSizeInBytes, Range<int64> (readStart, readEnd).contains (pos)))
+            break;
+
+        auto* newBlock = new BufferedBlock (*source, pos, samplesPerBlock);
+
+        const ScopedLock sl (lock);
+        blocks.add (newBlock);
+        return true; // just do one block
+    }
 
+    return hasChanged;
+}
 
 //==============================================================================
 //==============================================================================
@@ -281,6 +495,7 @@ public:
             read (bufferingReader, readBuffer);
 
             expect (isSilent (readBuffer));
+            expectEquals (bufferingReader.getStatistics().numTimeouts, (int64) 1);
         }
 
         beginTest ("Read samples");
@@ -297,7 +512,156 @@ public:
                 read (bufferingReader, readBuffer);
 
                 expect (buffer == readBuffer);
+
+                auto stats = bufferingReader.getStatistics();
+                expectEquals (stats.numTimeouts, (int64) 0);
+                expectEquals (stats.numHits + stats.numMisses, (int64) ((buffer.getNumSamples() + 1023) / 1024));
+            }
+        }
+
+        beginTest ("Read samples backwards");
+        {
+            auto buffer = generateTestBuffer (1 << 16);
+
+            BufferingAudioReader bufferingReader (new TestAudioFormatReader (buffer), timeSlice, 1 << 16);
+            bufferingReader.setReadTimeout (-1);
+
+            AudioBuffer<float> readBuffer { buffer.getNumChannels(), buffer.getNumSamples() };
+
+            for (auto end = buffer.getNumSamples(); end > 0;)
+            {
+                auto start = jmax (0, end - 1000);
+                bufferingReader.read (&readBuffer, start, end - start, start, true, true);
+                end = start;
+            }
+
+            expect (buffer == readBuffer);
+        }
+
+        beginTest ("Prefetch hints");
+        {
+            constexpr int blockSize = 32768;
+            auto buffer = generateTestBuffer (blockSize * 10);
+
+            BufferingAudioReader bufferingReader (new TestAudioFormatReader (buffer), timeSlice, blockSize);
+
+            AudioBuffer<float> readBuffer { buffer.getNumChannels(), 1000 };
+            bufferingReader.setReadTimeout (-1);
+            bufferingReader.read (&readBuffer, 0, readBuffer.getNumSamples(), 0, true, true);
+
+            const Range<int64> hint (blockSize * 6 + 100, blockSize * 7 + 100);
+            expect (! bufferingReader.isBuffered (hint));
+
+            bufferingReader.prefetch (hint);
+
+            for (int i = 0; i < 500 && ! bufferingReader.isBuffered (hint); ++i)
+                Thread::sleep (10);
+
+            expect (bufferingReader.isBuffered (hint));
+
+            bufferingReader.resetStatistics();
+            bufferingReader.setReadTimeout (0);
+            bufferingReader.read (&readBuffer, 0, readBuffer.getNumSamples(), hint.getStart(), true, true);
+
+            expectEquals (bufferingReader.getStatistics().numHits, (int64) 1);
+
+            bool matches = true;
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < readBuffer.getNumSamples(); ++i)
+                    matches = matches && readBuffer.getSample (ch, i) == buffer.getSample (ch, (int) hint.getStart() + i);
+
+            expect (matches);
+        }
+
+        beginTest ("Global memory budget");
+        {
+            constexpr int blockSize = 32768;
+            const auto blockSizeInBytes = (size_t) (2 * blockSize) * sizeof (float);
+            const auto initialUsage = BufferingAudioReader::getGlobalMemoryUsage();
+
+            BufferingAudioReader::setGlobalMemoryBudget (initialUsage + blockSizeInBytes);
+
+            {
+                auto buffer = generateTestBuffer (blockSize * 10);
+
+                BufferingAudioReader reader1 (new TestAudioFormatReader (buffer), timeSlice, blockSize * 4);
+                BufferingAudioReader reader2 (new TestAudioFormatReader (buffer), timeSlice, blockSize * 4);
+                reader1.setReadTimeout (-1);
+                reader2.setReadTimeout (-1);
+
+                AudioBuffer<float> readBuffer1 { buffer.getNumChannels(), buffer.getNumSamples() },
+                                   readBuffer2 { buffer.getNumChannels(), buffer.getNumSamples() };
+
+                read (reader1, readBuffer1);
+                read (reader2, readBuffer2);
+                Thread::sleep (50);
+
+                // each reader can only hold on to the block it's reading from
+                expect (BufferingAudioReader::getGlobalMemoryUsage() <= initialUsage + 2 * blockSizeInBytes);
+                expect (buffer == readBuffer1);
+                expect (buffer == readBuffer2);
+            }
+
+            BufferingAudioReader::setGlobalMemoryBudget (0);
+            expectEquals ((int64) BufferingAudioReader::getGlobalMemoryUsage(), (int64) initialUsage);
+        }
+
+        beginTest ("Global memory budget with reads that cross a block boundary");
+        {
+            constexpr int blockSize = 32768;
+            const auto blockSizeInBytes = (size_t) (2 * blockSize) * sizeof (float);
+            const auto initialUsage = BufferingAudioReader::getGlobalMemoryUsage();
+
+            BufferingAudioReader::setGlobalMemoryBudget (initialUsage + blockSizeInBytes);
+
+            {
+                auto buffer = generateTestBuffer (blockSize * 4);
+
+                BufferingAudioReader reader1 (new TestAudioFormatReader (buffer), timeSlice, blockSize * 4);
+                BufferingAudioReader reader2 (new TestAudioFormatReader (buffer), timeSlice, blockSize * 4);
+
+                // the first reader uses up the whole budget..
+                AudioBuffer<float> readBuffer1 { buffer.getNumChannels(), 1000 };
+                reader1.setReadTimeout (-1);
+                reader1.read (&readBuffer1, 0, readBuffer1.getNumSamples(), 0, true, true);
+
+                // ..so the second one only gets the blocks that its reads are waiting for
+                for (auto start : { blockSize - 500, 3 * blockSize - 1 })
+                {
+                    AudioBuffer<float> readBuffer2 { buffer.getNumChannels(), 1000 };
+                    reader2.setReadTimeout (5000);
+                    reader2.read (&readBuffer2, 0, readBuffer2.getNumSamples(), start, true, true);
+
+                    bool matches = true;
+
+                    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                        for (int i = 0; i < readBuffer2.getNumSamples(); ++i)
+                            matches = matches && readBuffer2.getSample (ch, i) == buffer.getSample (ch, start + i);
+
+                    expect (matches);
+                }
+
+                expectEquals (reader2.getStatistics().numTimeouts, (int64) 0);
+
+                // and a read that's longer than the whole buffered window still finishes
+                BufferingAudioReader reader3 (new TestAudioFormatReader (buffer), timeSlice, blockSize);
+                AudioBuffer<float> longRead { buffer.getNumChannels(), blockSize * 4 };
+                reader3.setReadTimeout (5000);
+                reader3.read (&longRead, 0, longRead.getNumSamples(), 0, true, true);
+
+                bool matches = true;
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    for (int i = 0; i < longRead.getNumSamples(); ++i)
+                        matches = matches && longRead.getSample (ch, i) == buffer.getSample (ch, i);
+
+                expect (matches);
+                expectEquals (reader3.getStatistics().numTimeouts, (int64) 0);
             }
+
+            BufferingAudioReader::setGlobalMemoryBudget (0);
+            expectEquals ((int64) BufferingAudioReader::getGlobalMemoryUsage(), (int64) initialUsage);
         }
     }
 
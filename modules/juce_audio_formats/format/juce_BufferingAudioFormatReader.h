@@ -31,6 +31,15 @@ namespace juce
     An AudioFormatReader that uses a background thread to pre-read data from
     another reader.
 
+    The reader keeps a window of blocks buffered ahead of the last position that
+    was read, in whichever direction playback seems to be going, and refills it more
+    eagerly when the playback speed means that it'll run out sooner. You can also
+    give it hints about positions that are likely to be read soon, e.g. the start of
+    the next item in a playlist or a likely seek target, with prefetch().
+
+    The memory used by all the BufferingAudioReaders in a process can be limited with
+    setGlobalMemoryBudget().
+
     @see AudioFormatReader
 
     @tags{Audio}
@@ -62,6 +71,55 @@ public:
     */
     void setReadTimeout (int timeoutMilliseconds) noexcept;
 
+    //==============================================================================
+    /** Tells the reader that a range of samples is likely to be read soon.
+
+        The background thread will load this range once the blocks around the current
+        read position are buffered. Hints are forgotten once a read lands inside them,
+        and only the most recent few are kept. The blocks used for hints are limited to
+        the same number of samples as the read-ahead window.
+    */
+    void prefetch (Range<int64> samplesToPrefetch);
+
+    /** Discards any hints that were given with prefetch(). */
+    void clearPrefetchHints();
+
+    /** Returns true if all of the given range is currently buffered, so that reading it
+        won't have to wait for the background thread.
+    */
+    bool isBuffered (Range<int64> samples) const;
+
+    //==============================================================================
+    /** Counters describing how well the buffering has been keeping up with the reads. */
+    struct Statistics
+    {
+        int64 numHits = 0;              /**< Reads for which all the samples were already buffered. */
+        int64 numMisses = 0;            /**< Reads that had to wait for the background thread. */
+        int64 numTimeouts = 0;          /**< Reads that gave up waiting and returned silence. */
+        double totalStallTimeMs = 0;    /**< The total time that reads have spent waiting. */
+    };
+
+    /** Returns the statistics collected since the reader was created or resetStatistics() was called. */
+    Statistics getStatistics() const noexcept;
+
+    /** Resets the statistics returned by getStatistics(). */
+    void resetStatistics() noexcept;
+
+    //==============================================================================
+    /** Limits the total number of bytes of buffered audio held by all BufferingAudioReaders.
+
+        When the budget is used up, readers stop extending their read-ahead windows and
+        prefetched ranges, although each reader can always keep the block that it's
+        currently reading from. A value of 0 (the default) means no limit.
+    */
+    static void setGlobalMemoryBudget (size_t maxNumBytes) noexcept;
+
+    /** Returns the limit set with setGlobalMemoryBudget(). */
+    static size_t getGlobalMemoryBudget() noexcept;
+
+    /** Returns the number of bytes of buffered audio currently held by all BufferingAudioReaders. */
+    static size_t getGlobalMemoryUsage() noexcept;
+
     //==============================================================================
     bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override;
@@ -70,6 +128,9 @@ private:
     struct BufferedBlock
     {
         BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples);
+        ~BufferedBlock();
+
+        size_t getSizeInBytes() const noexcept;
 
         Range<int64> range;
         AudioBuffer<float> buffer;
@@ -77,18 +138,29 @@ private:
 
     int useTimeSlice() override;
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
+    Array<int64> getBlocksToBuffer() const;
     bool readNextBufferChunk();
+    void updatePlaybackRate (int64 startSample);
 
     static constexpr int samplesPerBlock = 32768;
+    static constexpr int maxNumPrefetchHints = 8;
 
     std::unique_ptr<AudioFormatReader> source;
     TimeSliceThread& thread;
-    std::atomic<int64> nextReadPosition { 0 };
+    std::atomic<int64> nextReadPosition { 0 }, nextReadEnd { 0 };
     const int numBlocks;
     int timeoutMs = 0;
 
+    // Signed, in samples per second, so negative when playing backwards
+    std::atomic<double> playbackRate { 0.0 };
+    int64 lastReadStart = -1;
+    double lastReadTime = 0;
+
+    std::atomic<int64> numHits { 0 }, numMisses { 0 }, numTimeouts { 0 }, stallTimeMicroseconds { 0 };
+
     CriticalSection lock;
     OwnedArray<BufferedBlock> blocks;
+    Array<Range<int64>> prefetchHints;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioReader)
 };
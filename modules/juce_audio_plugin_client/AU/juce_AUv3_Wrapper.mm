@@ -1469,6 +1469,12 @@ private:
     {
         ignoreUnused (numParams);
 
+        auto& processor = getAudioProcessor();
+        auto& eventQueue = processor.getParameterEventQueue();
+        const auto wantsEvents = processor.isParameterEventQueueEnabled();
+
+        eventQueue.clear();
+
         for (const AURenderEvent* event = realtimeEventListHead; event != nullptr; event = event->head.next)
         {
             switch (event->head.eventType)
@@ -1507,6 +1513,10 @@ private:
                     if (auto* p = getJuceParameterForAUAddress (paramEvent.parameterAddress))
                     {
                         auto normalisedValue = paramEvent.value / getMaximumParameterValue (p);
+
+                        if (wantsEvents)
+                            eventQueue.addEvent (*p, jmax (0, static_cast<int> (paramEvent.eventSampleTime - startTime)), normalisedValue);
+
                         setAudioProcessorParameter (p, normalisedValue);
                     }
                 }
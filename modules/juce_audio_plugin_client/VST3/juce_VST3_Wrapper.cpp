@@ -3072,6 +3072,9 @@ public:
     {
         jassert (pluginInstance != nullptr);
 
+        auto& eventQueue = pluginInstance->getParameterEventQueue();
+        const auto wantsEvents = pluginInstance->isParameterEventQueueEnabled();
+
         auto numParamsChanged = paramChanges.getParameterCount();
 
         for (Steinberg::int32 i = 0; i < numParamsChanged; ++i)
@@ -3094,7 +3097,21 @@ public:
                    #endif
                     {
                         if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                        {
+                            if (wantsEvents)
+                            {
+                                for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                                {
+                                    Steinberg::int32 pointOffset = 0;
+                                    double pointValue = 0.0;
+
+                                    if (paramQueue->getPoint (point, pointOffset, pointValue) == kResultTrue)
+                                        eventQueue.addEvent (*param, (int) pointOffset, (float) pointValue);
+                                }
+                            }
+
                             setValueAndNotifyIfChanged (*param, (float) value);
+                        }
                     }
                 }
             }
@@ -3145,6 +3162,7 @@ public:
         }
 
         midiBuffer.clear();
+        pluginInstance->getParameterEventQueue().clear();
 
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
@@ -1873,10 +1873,10 @@ struct VST3ComponentHolder
 };
 
 //==============================================================================
-/*  A queue which can store up to one element.
+/*  A queue which can store up to 16 sample-accurate points, without allocating.
 
-    This is more memory-efficient than storing large vectors of
-    parameter changes that we'll just throw away.
+    If the queue is full, each new point replaces the last one, so that the
+    value at the end of the block is still correct.
 */
 class ParamValueQueue : public Vst::IParamValueQueue
 {
@@ -1902,25 +1902,30 @@ public:
         if (! isPositiveAndBelow (index, size))
             return kResultFalse;
 
-        sampleOffset = 0;
-        value = cachedValue;
+        sampleOffset = points[(size_t) index].sampleOffset;
+        value = points[(size_t) index].value;
 
         return kResultTrue;
     }
 
-    tresult PLUGIN_API addPoint (Steinberg::int32,
+    tresult PLUGIN_API addPoint (Steinberg::int32 sampleOffset,
                                  Vst::ParamValue value,
                                  Steinberg::int32& index) override
     {
+        // If the queue is full, we overwrite the final point so that the
+        // value at the end of the block is still correct.
+        if (size == (Steinberg::int32) points.size())
+            --size;
+
+        points[(size_t) size] = { sampleOffset, (float) value };
         index = size++;
-        set ((float) value);
 
         return kResultTrue;
     }
 
     void set (float valueIn)
     {
-        cachedValue = valueIn;
+        points[0] = { 0, valueIn };
         size = 1;
     }
 
@@ -1929,13 +1934,19 @@ public:
     float get() const noexcept
     {
         jassert (size > 0);
-        return cachedValue;
+        return points[(size_t) size - 1].value;
     }
 
 private:
+    struct Point
+    {
+        Steinberg::int32 sampleOffset;
+        float value;
+    };
+
     const Vst::ParamID paramId;
     const Steinberg::int32 parameterIndex;
-    float cachedValue;
+    std::array<Point, 16> points;
     Steinberg::int32 size = 0;
     Atomic<int> refCount;
 };
@@ -2013,10 +2024,33 @@ public:
             queue->set (value);
     }
 
+    /*  Like set(), but leaves the queue alone if points have already been added to it
+        for this block, e.g. by addPoint().
+    */
+    void setIfEmpty (Vst::ParamID id, float value)
+    {
+        Steinberg::int32 indexOut = notInVector;
+
+        if (auto* queue = addParameterData (id, indexOut))
+            if (queue->getPointCount() == 0)
+                queue->set (value);
+    }
+
+    void addPoint (Vst::ParamID id, Steinberg::int32 sampleOffset, float value)
+    {
+        Steinberg::int32 indexOut = notInVector;
+
+        if (auto* queue = addParameterData (id, indexOut))
+            queue->addPoint (sampleOffset, value, indexOut);
+    }
+
     void clear()
     {
         for (auto* item : queues)
+        {
             item->index = notInVector;
+            item->ptr->clear();
+        }
 
         queues.clear();
     }
@@ -2571,9 +2605,13 @@ public:
         associateWith (data, buffer);
         associateWith (data, midiMessages);
 
+        for (const auto& event : getParameterEventQueue())
+            if (auto* param = dynamic_cast<VST3Parameter*> (event.parameter))
+                inputParameterChanges->addPoint (param->getParamID(), (Steinberg::int32) event.sampleOffset, event.value);
+
         cachedParamValues.ifSet ([&] (Steinberg::int32 index, float value)
         {
-            inputParameterChanges->set (cachedParamValues.getParamID (index), value);
+            inputParameterChanges->setIfEmpty (cachedParamValues.getParamID (index), value);
         });
 
         processor->process (data);
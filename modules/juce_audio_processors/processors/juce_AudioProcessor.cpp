@@ -503,6 +503,14 @@ void AudioProcessor::checkForDuplicateGroupIDs (const AudioProcessorParameterGro
 const Array<AudioProcessorParameter*>& AudioProcessor::getParameters() const   { return flatParameterList; }
 const AudioProcessorParameterGroup& AudioProcessor::getParameterTree() const   { return parameterTree; }
 
+void AudioProcessor::setParameterEventQueueEnabled (bool shouldBeEnabled)
+{
+    parameterEventQueueEnabled = shouldBeEnabled;
+
+    if (shouldBeEnabled)
+        parameterEventQueue.ensureSize (1024);
+}
+
 void AudioProcessor::addParameter (AudioProcessorParameter* param)
 {
     jassert (param != nullptr);
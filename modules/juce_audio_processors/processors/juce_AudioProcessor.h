@@ -1036,6 +1036,46 @@ public:
     /** Returns a flat list of the parameters in the current tree. */
     const Array<AudioProcessorParameter*>& getParameters() const;
 
+    //==============================================================================
+    /** Enables or disables the sample-accurate parameter event queue.
+
+        By default, the plugin wrappers only set each parameter to the last value that
+        the host sent for a block, and any automation points in between are dropped.
+        If you enable the queue (ideally in your constructor), the wrappers that support
+        it will also place every timestamped change into the queue returned by
+        getParameterEventQueue() before each call to processBlock().
+
+        When processBlock() is called, the parameters will already have been set to their
+        final values for the block, so your processor should keep track of its own
+        current values and apply the queued events in order, e.g. by using
+        AudioProcessorParameterEventQueue::splitBlock().
+
+        Hosts can also fill the queue of a hosted AudioPluginInstance before calling
+        its processBlock() method, in which case formats that support sample-accurate
+        automation will pass the events on to the plugin. The AudioProcessorGraph
+        clears the queue of each node after it has been processed.
+
+        @see getParameterEventQueue, AudioProcessorParameterEventQueue
+    */
+    void setParameterEventQueueEnabled (bool shouldBeEnabled);
+
+    /** Returns true if the sample-accurate parameter event queue has been enabled.
+        @see setParameterEventQueueEnabled
+    */
+    bool isParameterEventQueueEnabled() const noexcept          { return parameterEventQueueEnabled; }
+
+    /** Returns the queue of timestamped parameter changes for the current block.
+
+        This should only be used from within processBlock(), or by a host just before
+        calling processBlock().
+
+        @see setParameterEventQueueEnabled
+    */
+    AudioProcessorParameterEventQueue& getParameterEventQueue() noexcept              { return parameterEventQueue; }
+
+    /** Returns the queue of timestamped parameter changes for the current block. */
+    const AudioProcessorParameterEventQueue& getParameterEventQueue() const noexcept  { return parameterEventQueue; }
+
     //==============================================================================
     /** Returns the number of preset programs the processor supports.
 
@@ -1480,6 +1520,9 @@ private:
     AudioProcessorParameterGroup parameterTree;
     Array<AudioProcessorParameter*> flatParameterList;
 
+    AudioProcessorParameterEventQueue parameterEventQueue;
+    bool parameterEventQueueEnabled = false;
+
     AudioProcessorParameter* getParamChecked (int) const;
 
   #if JUCE_DEBUG
@@ -45,9 +45,11 @@ struct GraphRenderSequence
         MidiBuffer* midiBuffers;
         AudioPlayHead* audioPlayHead;
         int numSamples;
+        AudioProcessorGraphProfiler* profiler; // null unless profiling is enabled
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead,
+                  AudioProcessorGraphProfiler* profiler)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
@@ -64,7 +66,7 @@ struct GraphRenderSequence
                 midiChunk.clear();
                 midiChunk.addEvents (midiMessages, chunkStartSample, chunkSize, -chunkStartSample);
 
-                perform (audioChunk, midiChunk, audioPlayHead);
+                perform (audioChunk, midiChunk, audioPlayHead, profiler);
 
                 chunkStartSample += maxSamples;
             }
@@ -72,6 +74,13 @@ struct GraphRenderSequence
             return;
         }
 
+        // Each chunk is profiled as a block of its own, but only if all of its timings will
+        // fit in the profiler's FIFO, so that a full FIFO drops whole blocks
+        if (profiler != nullptr && ! profiler->beginBlock (numProcessOps))
+            profiler = nullptr;
+
+        const auto startTicks = profiler != nullptr ? Time::getHighResolutionTicks() : 0;
+
         currentAudioInputBuffer = &buffer;
         currentAudioOutputBuffer.setSize (jmax (1, buffer.getNumChannels()), numSamples);
         currentAudioOutputBuffer.clear();
@@ -79,7 +88,7 @@ struct GraphRenderSequence
         currentMidiOutputBuffer.clear();
 
         {
-            const Context context { renderingBuffer.getArrayOfWritePointers(), midiBuffers.begin(), audioPlayHead, numSamples };
+            const Context context { renderingBuffer.getArrayOfWritePointers(), midiBuffers.begin(), audioPlayHead, numSamples, profiler };
 
             for (auto* op : renderOps)
                 op->perform (context);
@@ -91,6 +100,9 @@ struct GraphRenderSequence
         midiMessages.clear();
         midiMessages.addEvents (currentMidiOutputBuffer, 0, buffer.getNumSamples(), 0);
         currentAudioInputBuffer = nullptr;
+
+        if (profiler != nullptr)
+            profiler->recordBlock (startTicks, Time::getHighResolutionTicks(), numSamples);
     }
 
     void addClearChannelOp (int index)
@@ -130,13 +142,16 @@ struct GraphRenderSequence
 
     void addDelayChannelOp (int chan, int delaySize)
     {
-        renderOps.add (new DelayChannelOp (chan, delaySize));
+        delayOps.add (new DelayChannelOp (chan, delaySize));
+        renderOps.add (delayOps.getLast());
+        totalDelaySamples += (size_t) delaySize;
     }
 
     void addProcessOp (const AudioProcessorGraph::Node::Ptr& node,
                        const Array<int>& audioChannelsUsed, int totalNumChans, int midiBuffer)
     {
         renderOps.add (new ProcessOp (node, audioChannelsUsed, totalNumChans, midiBuffer));
+        ++numProcessOps;
     }
 
     void prepareBuffers (int blockSize)
@@ -159,19 +174,24 @@ struct GraphRenderSequence
 
         for (auto&& m : midiBuffers)
             m.ensureSize (defaultMIDIBufferSize);
+
+        // All the delay lines share one allocation, preceded by a block-sized scratch area
+        delayStorage.calloc (totalDelaySamples + (size_t) blockSize);
+        auto* nextDelayLine = delayStorage.get() + blockSize;
+
+        for (auto* op : delayOps)
+        {
+            op->setStorage (nextDelayLine, delayStorage.get());
+            nextDelayLine += op->delaySize;
+        }
     }
 
-    void releaseBuffers()
+    size_t getLatencyCompensationMemoryUsage() const noexcept
     {
-        renderingBuffer.setSize (1, 1);
-        currentAudioOutputBuffer.setSize (1, 1);
-        currentAudioInputBuffer = nullptr;
-        currentMidiInputBuffer = nullptr;
-        currentMidiOutputBuffer.clear();
-        midiBuffers.clear();
+        return totalDelaySamples * sizeof (FloatType);
     }
 
-    int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
+    int numBuffersNeeded = 0, numMidiBuffersNeeded = 0, numProcessOps = 0;
 
     AudioBuffer<FloatType> renderingBuffer, currentAudioOutputBuffer;
     AudioBuffer<FloatType>* currentAudioInputBuffer = nullptr;
@@ -214,35 +234,54 @@ private:
     //==============================================================================
     struct DelayChannelOp  : public RenderingOp
     {
-        DelayChannelOp (int chan, int delaySize)
-            : channel (chan),
-              bufferSize (delaySize + 1),
-              writeIndex (delaySize)
+        DelayChannelOp (int chan, int size)
+            : channel (chan), delaySize (size)
+        {
+            jassert (delaySize > 0);
+        }
+
+        void setStorage (FloatType* delayLine, FloatType* scratchSpace) noexcept
         {
-            buffer.calloc ((size_t) bufferSize);
+            buffer = delayLine;
+            scratch = scratchSpace;
+            position = 0;
         }
 
         void perform (const Context& c) override
         {
+            // The delay line holds the last delaySize samples, oldest first from position,
+            // so swapping each contiguous run with the incoming block delays it by delaySize.
             auto* data = c.audioBuffers[channel];
 
-            for (int i = c.numSamples; --i >= 0;)
+            for (int done = 0; done < c.numSamples;)
             {
-                buffer[writeIndex] = *data;
-                *data++ = buffer[readIndex];
+                auto num = jmin (c.numSamples - done, delaySize - position);
+                auto* delayed = buffer + position;
 
-                if (++readIndex  >= bufferSize) readIndex = 0;
-                if (++writeIndex >= bufferSize) writeIndex = 0;
+                FloatVectorOperations::copy (scratch, delayed, num);
+                FloatVectorOperations::copy (delayed, data + done, num);
+                FloatVectorOperations::copy (data + done, scratch, num);
+
+                done += num;
+                position += num;
+
+                if (position == delaySize)
+                    position = 0;
             }
         }
 
-        HeapBlock<FloatType> buffer;
-        const int channel, bufferSize;
-        int readIndex = 0, writeIndex;
+        const int channel, delaySize;
+        FloatType* buffer = nullptr;
+        FloatType* scratch = nullptr;
+        int position = 0;
 
         JUCE_DECLARE_NON_COPYABLE (DelayChannelOp)
     };
 
+    Array<DelayChannelOp*> delayOps;
+    HeapBlock<FloatType> delayStorage;
+    size_t totalDelaySamples = 0;
+
     //==============================================================================
     struct ProcessOp   : public RenderingOp
     {
@@ -263,6 +302,8 @@ private:
 
         void perform (const Context& c) override
         {
+            const auto startTicks = c.profiler != nullptr ? Time::getHighResolutionTicks() : 0;
+
             processor.setPlayHead (c.audioPlayHead);
 
             for (int i = 0; i < totalChans; ++i)
@@ -274,6 +315,12 @@ private:
                 buffer.clear();
             else
                 callProcess (buffer, c.midiBuffers[midiBufferToUse]);
+
+            // Any events that the host queued for this node only apply to this block
+            processor.getParameterEventQueue().clear();
+
+            if (c.profiler != nullptr)
+                c.profiler->recordNode (node->nodeID, startTicks, Time::getHighResolutionTicks());
         }
 
         void callProcess (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
@@ -532,12 +579,6 @@ struct RenderSequenceBuilder
                 // we've found one of our input chans that can be re-used..
                 reusableInputIndex = i;
                 bufIndex = sourceBufIndex;
-
-                auto nodeDelay = getNodeDelay (src.nodeID);
-
-                if (nodeDelay < maxLatency)
-                    sequence.addDelayChannelOp (bufIndex, maxLatency - nodeDelay);
-
                 break;
             }
         }
@@ -558,12 +599,16 @@ struct RenderSequenceBuilder
                 sequence.addCopyChannelOp (srcIndex, bufIndex);
 
             reusableInputIndex = 0;
-            auto nodeDelay = getNodeDelay (sources.getFirst().nodeID);
-
-            if (nodeDelay < maxLatency)
-                sequence.addDelayChannelOp (bufIndex, maxLatency - nodeDelay);
         }
 
+        // Sources that need the same amount of compensation are summed before
+        // being delayed, so each distinct latency only needs a single delay line.
+        auto getCompensation = [&] (AudioProcessorGraph::NodeAndChannel src)  { return maxLatency - getNodeDelay (src.nodeID); };
+
+        const auto outputCompensation = getCompensation (sources.getReference (reusableInputIndex));
+        std::map<int, int> bufferForCompensation;
+        Array<int> temporaryBuffers;
+
         for (int i = 0; i < sources.size(); ++i)
         {
             if (i != reusableInputIndex)
@@ -573,28 +618,50 @@ struct RenderSequenceBuilder
 
                 if (srcIndex >= 0)
                 {
-                    auto nodeDelay = getNodeDelay (src.nodeID);
+                    auto compensation = getCompensation (src);
 
-                    if (nodeDelay < maxLatency)
+                    if (compensation == outputCompensation)
                     {
-                        if (! isBufferNeededLater (ourRenderingIndex, inputChan, src))
-                        {
-                            sequence.addDelayChannelOp (srcIndex, maxLatency - nodeDelay);
-                        }
-                        else // buffer is reused elsewhere, can't be delayed
-                        {
-                            auto bufferToDelay = getFreeBuffer (audioBuffers);
-                            sequence.addCopyChannelOp (srcIndex, bufferToDelay);
-                            sequence.addDelayChannelOp (bufferToDelay, maxLatency - nodeDelay);
-                            srcIndex = bufferToDelay;
-                        }
+                        sequence.addAddChannelOp (srcIndex, bufIndex);
+                        continue;
                     }
 
-                    sequence.addAddChannelOp (srcIndex, bufIndex);
+                    auto existing = bufferForCompensation.find (compensation);
+
+                    if (existing != bufferForCompensation.end())
+                    {
+                        sequence.addAddChannelOp (srcIndex, existing->second);
+                    }
+                    else if (! isBufferNeededLater (ourRenderingIndex, inputChan, src))
+                    {
+                        bufferForCompensation[compensation] = srcIndex;
+                    }
+                    else // buffer is reused elsewhere, can't be delayed
+                    {
+                        auto bufferToDelay = getFreeBuffer (audioBuffers);
+                        audioBuffers.getReference (bufferToDelay).setAssignedToNonExistentNode();
+                        sequence.addCopyChannelOp (srcIndex, bufferToDelay);
+                        bufferForCompensation[compensation] = bufferToDelay;
+                        temporaryBuffers.add (bufferToDelay);
+                    }
                 }
             }
         }
 
+        if (outputCompensation > 0)
+            sequence.addDelayChannelOp (bufIndex, outputCompensation);
+
+        for (auto& group : bufferForCompensation)
+        {
+            if (group.first > 0)
+                sequence.addDelayChannelOp (group.second, group.first);
+
+            sequence.addAddChannelOp (group.second, bufIndex);
+        }
+
+        for (auto index : temporaryBuffers)
+            audioBuffers.getReference (index).setFree();
+
         return bufIndex;
     }
 
@@ -922,8 +989,119 @@ void AudioProcessorGraph::Node::setBypassed (bool shouldBeBypassed) noexcept
 struct AudioProcessorGraph::RenderSequenceFloat   : public GraphRenderSequence<float> {};
 struct AudioProcessorGraph::RenderSequenceDouble  : public GraphRenderSequence<double> {};
 
+struct AudioProcessorGraph::RenderSequences
+{
+    GraphRenderSequence<float>&  getSequence (float)  noexcept  { return floatSequence; }
+    GraphRenderSequence<double>& getSequence (double) noexcept  { return doubleSequence; }
+
+    RenderSequenceFloat floatSequence;
+    RenderSequenceDouble doubleSequence;
+};
+
+//==============================================================================
+/*  Hands newly-built render sequences over to the audio thread without locking.
+
+    The audio thread publishes the sequence it is about to render in a hazard
+    pointer, so the message thread can swap in a new sequence at any time, and
+    only deletes a retired sequence once the audio thread has let go of it. A
+    sequence that's still in use when it's retired is deleted later by a timer,
+    rather than lingering until the next sequence is published. This relies on
+    processBlock not being called from several threads at once, which the
+    AudioProcessor contract already guarantees.
+*/
+class AudioProcessorGraph::RenderSequenceExchange  : private Timer
+{
+public:
+    RenderSequenceExchange() = default;
+
+    ~RenderSequenceExchange() override
+    {
+        stopTimer();
+        delete current.exchange (nullptr);
+        jassert (inUse.load() == nullptr);
+    }
+
+    /** Called by the audio thread before rendering. Returns nullptr if nothing has been published. */
+    RenderSequences* acquire() noexcept
+    {
+        auto* sequences = current.load();
+
+        for (;;)
+        {
+            inUse.store (sequences);
+            auto* latest = current.load();
+
+            if (latest == sequences)
+                return sequences;
+
+            sequences = latest;
+        }
+    }
+
+    /** Called by the audio thread once it has finished with the acquired sequence. */
+    void release() noexcept                             { inUse.store (nullptr); }
+
+    /** Returns the sequence being rendered, if called from within the render callback. */
+    RenderSequences* getSequenceInUse() const noexcept  { return inUse.load(); }
+
+    /** Replaces the current sequence. The old one will be deleted once the audio thread is done with it. */
+    void publish (std::unique_ptr<RenderSequences> newSequences)
+    {
+        const ScopedLock sl (retiredLock);
+
+        if (auto* old = current.exchange (newSequences.release()))
+            retired.emplace_back (old);
+
+        collectGarbage();
+    }
+
+    /** Unpublishes the current sequence, and blocks until the audio thread isn't using any old sequence.
+
+        This must never be called while holding a lock that the render callback might be waiting on.
+    */
+    void clearAndWait()
+    {
+        publish (nullptr);
+
+        while (inUse.load() != nullptr)
+            Thread::yield();
+
+        const ScopedLock sl (retiredLock);
+        collectGarbage();
+    }
+
+private:
+    void timerCallback() override
+    {
+        const ScopedLock sl (retiredLock);
+        collectGarbage();
+    }
+
+    void collectGarbage()
+    {
+        auto* sequenceInUse = inUse.load();
+
+        retired.erase (std::remove_if (retired.begin(), retired.end(),
+                                       [sequenceInUse] (const std::unique_ptr<RenderSequences>& s) { return s.get() != sequenceInUse; }),
+                       retired.end());
+
+        if (retired.empty())
+            stopTimer();
+        else if (! isTimerRunning())
+            startTimer (100);
+    }
+
+    std::atomic<RenderSequences*> current { nullptr }, inUse { nullptr };
+    CriticalSection retiredLock;
+    std::vector<std::unique_ptr<RenderSequences>> retired;
+
+    JUCE_DECLARE_NON_COPYABLE (RenderSequenceExchange)
+};
+
 //==============================================================================
 AudioProcessorGraph::AudioProcessorGraph()
+    : renderSequenceExchange (std::make_unique<RenderSequenceExchange>()),
+      profiler (new AudioProcessorGraphProfiler (*this))
 {
 }
 
@@ -950,12 +1128,15 @@ void AudioProcessorGraph::topologyChanged()
 
 void AudioProcessorGraph::clear()
 {
-    const ScopedLock sl (getCallbackLock());
+    {
+        const ScopedLock sl (nodesLock);
 
-    if (nodes.isEmpty())
-        return;
+        if (nodes.isEmpty())
+            return;
+
+        nodes.clear();
+    }
 
-    nodes.clear();
     topologyChanged();
 }
 
@@ -996,7 +1177,7 @@ AudioProcessorGraph::Node::Ptr AudioProcessorGraph::addNode (std::unique_ptr<Aud
     Node::Ptr n (new Node (nodeID, std::move (newProcessor)));
 
     {
-        const ScopedLock sl (getCallbackLock());
+        const ScopedLock sl (nodesLock);
         nodes.add (n.get());
     }
 
@@ -1007,20 +1188,26 @@ AudioProcessorGraph::Node::Ptr AudioProcessorGraph::addNode (std::unique_ptr<Aud
 
 AudioProcessorGraph::Node::Ptr AudioProcessorGraph::removeNode (NodeID nodeId)
 {
-    const ScopedLock sl (getCallbackLock());
+    Node::Ptr node;
 
-    for (int i = nodes.size(); --i >= 0;)
     {
-        if (nodes.getUnchecked (i)->nodeID == nodeId)
+        const ScopedLock sl (nodesLock);
+
+        for (int i = nodes.size(); --i >= 0;)
         {
-            disconnectNode (nodeId);
-            auto node = nodes.removeAndReturn (i);
-            topologyChanged();
-            return node;
+            if (nodes.getUnchecked (i)->nodeID == nodeId)
+            {
+                disconnectNode (nodeId);
+                node = nodes.removeAndReturn (i);
+                break;
+            }
         }
     }
 
-    return {};
+    if (node != nullptr)
+        topologyChanged();
+
+    return node;
 }
 
 AudioProcessorGraph::Node::Ptr AudioProcessorGraph::removeNode (Node* node)
@@ -1243,14 +1430,7 @@ bool AudioProcessorGraph::removeIllegalConnections()
 //==============================================================================
 void AudioProcessorGraph::clearRenderingSequence()
 {
-    std::unique_ptr<RenderSequenceFloat> oldSequenceF;
-    std::unique_ptr<RenderSequenceDouble> oldSequenceD;
-
-    {
-        const ScopedLock sl (getCallbackLock());
-        std::swap (renderSequenceFloat, oldSequenceF);
-        std::swap (renderSequenceDouble, oldSequenceD);
-    }
+    renderSequenceExchange->clearAndWait();
 }
 
 bool AudioProcessorGraph::anyNodesNeedPreparing() const noexcept
@@ -1264,31 +1444,33 @@ bool AudioProcessorGraph::anyNodesNeedPreparing() const noexcept
 
 void AudioProcessorGraph::buildRenderingSequence()
 {
-    auto newSequenceF = std::make_unique<RenderSequenceFloat>();
-    auto newSequenceD = std::make_unique<RenderSequenceDouble>();
-
-    RenderSequenceBuilder<RenderSequenceFloat>  builderF (*this, *newSequenceF);
-    RenderSequenceBuilder<RenderSequenceDouble> builderD (*this, *newSequenceD);
-
-    const ScopedLock sl (getCallbackLock());
-
+    // The new sequence is built and prepared entirely on this thread while the old
+    // one keeps rendering. Nodes that still need preparing can't be part of the
+    // current sequence: either they've only just been added, or prepareToPlay() or
+    // releaseResources() cleared the sequence before unpreparing them. So they're
+    // safe to prepare here.
+    auto newSequences = std::make_unique<RenderSequences>();
     const auto currentBlockSize = getBlockSize();
-    newSequenceF->prepareBuffers (currentBlockSize);
-    newSequenceD->prepareBuffers (currentBlockSize);
 
-    if (anyNodesNeedPreparing())
     {
-        renderSequenceFloat.reset();
-        renderSequenceDouble.reset();
+        const ScopedLock sl (nodesLock);
 
-        for (auto* node : nodes)
-            node->prepare (getSampleRate(), currentBlockSize, this, getProcessingPrecision());
+        RenderSequenceBuilder<RenderSequenceFloat>  builderF (*this, newSequences->floatSequence);
+        RenderSequenceBuilder<RenderSequenceDouble> builderD (*this, newSequences->doubleSequence);
+
+        if (anyNodesNeedPreparing())
+            for (auto* node : nodes)
+                node->prepare (getSampleRate(), currentBlockSize, this, getProcessingPrecision());
     }
 
+    newSequences->floatSequence.prepareBuffers (currentBlockSize);
+    newSequences->doubleSequence.prepareBuffers (currentBlockSize);
+
+    latencyCompensationMemory = newSequences->floatSequence.getLatencyCompensationMemoryUsage()
+                                  + newSequences->doubleSequence.getLatencyCompensationMemoryUsage();
     isPrepared = 1;
 
-    std::swap (renderSequenceFloat,  newSequenceF);
-    std::swap (renderSequenceDouble, newSequenceD);
+    renderSequenceExchange->publish (std::move (newSequences));
 }
 
 void AudioProcessorGraph::handleAsyncUpdate()
@@ -1299,6 +1481,8 @@ void AudioProcessorGraph::handleAsyncUpdate()
 //==============================================================================
 void AudioProcessorGraph::prepareToPlay (double sampleRate, int estimatedSamplesPerBlock)
 {
+    clearRenderingSequence();
+
     {
         const ScopedLock sl (getCallbackLock());
         setRateAndBufferSizeDetails (sampleRate, estimatedSamplesPerBlock);
@@ -1320,8 +1504,6 @@ void AudioProcessorGraph::prepareToPlay (double sampleRate, int estimatedSamples
         }
     }
 
-    clearRenderingSequence();
-
     updateOnMessageThread (*this);
 }
 
@@ -1336,28 +1518,25 @@ void AudioProcessorGraph::unprepare()
 
     isPrepared = 0;
 
+    const ScopedLock sl (nodesLock);
+
     for (auto* n : nodes)
         n->unprepare();
 }
 
 void AudioProcessorGraph::releaseResources()
 {
-    const ScopedLock sl (getCallbackLock());
-
     cancelPendingUpdate();
+    clearRenderingSequence();
 
+    const ScopedLock sl (getCallbackLock());
     unprepare();
-
-    if (renderSequenceFloat != nullptr)
-        renderSequenceFloat->releaseBuffers();
-
-    if (renderSequenceDouble != nullptr)
-        renderSequenceDouble->releaseBuffers();
 }
 
 void AudioProcessorGraph::reset()
 {
     const ScopedLock sl (getCallbackLock());
+    const ScopedLock nl (nodesLock);
 
     for (auto* n : nodes)
         n->getProcessor()->reset();
@@ -1369,6 +1548,8 @@ void AudioProcessorGraph::setNonRealtime (bool isProcessingNonRealtime) noexcept
 
     AudioProcessor::setNonRealtime (isProcessingNonRealtime);
 
+    const ScopedLock nl (nodesLock);
+
     for (auto* n : nodes)
         n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
 }
@@ -1379,37 +1560,31 @@ bool AudioProcessorGraph::producesMidi() const                      { return tru
 void AudioProcessorGraph::getStateInformation (MemoryBlock&)        {}
 void AudioProcessorGraph::setStateInformation (const void*, int)    {}
 
-template <typename FloatType, typename SequenceType>
+template <typename FloatType, typename ExchangeType>
 static void processBlockForBuffer (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages,
                                    AudioProcessorGraph& graph,
-                                   std::unique_ptr<SequenceType>& renderSequence,
+                                   ExchangeType& exchange,
                                    std::atomic<bool>& isPrepared)
 {
     if (graph.isNonRealtime())
     {
         while (! isPrepared)
             Thread::sleep (1);
-
-        const ScopedLock sl (graph.getCallbackLock());
-
-        if (renderSequence != nullptr)
-            renderSequence->perform (buffer, midiMessages, graph.getPlayHead());
     }
-    else
+    else if (! isPrepared)
     {
-        const ScopedLock sl (graph.getCallbackLock());
+        buffer.clear();
+        midiMessages.clear();
+        return;
+    }
 
-        if (isPrepared)
-        {
-            if (renderSequence != nullptr)
-                renderSequence->perform (buffer, midiMessages, graph.getPlayHead());
-        }
-        else
-        {
-            buffer.clear();
-            midiMessages.clear();
-        }
+    if (auto* sequences = exchange.acquire())
+    {
+        auto* profiler = graph.getProfiler().isEnabled() ? &graph.getProfiler() : nullptr;
+        sequences->getSequence (FloatType()).perform (buffer, midiMessages, graph.getPlayHead(), profiler);
     }
+
+    exchange.release();
 }
 
 void AudioProcessorGraph::processBlock (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
@@ -1417,7 +1592,7 @@ void AudioProcessorGraph::processBlock (AudioBuffer<float>& buffer, MidiBuffer&
     if ((! isPrepared) && MessageManager::getInstance()->isThisTheMessageThread())
         handleAsyncUpdate();
 
-    processBlockForBuffer<float> (buffer, midiMessages, *this, renderSequenceFloat, isPrepared);
+    processBlockForBuffer<float> (buffer, midiMessages, *this, *renderSequenceExchange, isPrepared);
 }
 
 void AudioProcessorGraph::processBlock (AudioBuffer<double>& buffer, MidiBuffer& midiMessages)
@@ -1425,7 +1600,7 @@ void AudioProcessorGraph::processBlock (AudioBuffer<double>& buffer, MidiBuffer&
     if ((! isPrepared) && MessageManager::getInstance()->isThisTheMessageThread())
         handleAsyncUpdate();
 
-    processBlockForBuffer<double> (buffer, midiMessages, *this, renderSequenceDouble, isPrepared);
+    processBlockForBuffer<double> (buffer, midiMessages, *this, *renderSequenceExchange, isPrepared);
 }
 
 //==============================================================================
@@ -1530,13 +1705,17 @@ static void processIOBlock (AudioProcessorGraph::AudioGraphIOProcessor& io, Sequ
 void AudioProcessorGraph::AudioGraphIOProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
 {
     jassert (graph != nullptr);
-    processIOBlock (*this, *graph->renderSequenceFloat, buffer, midiMessages);
+
+    if (auto* sequences = graph->renderSequenceExchange->getSequenceInUse())
+        processIOBlock (*this, sequences->floatSequence, buffer, midiMessages);
 }
 
 void AudioProcessorGraph::AudioGraphIOProcessor::processBlock (AudioBuffer<double>& buffer, MidiBuffer& midiMessages)
 {
     jassert (graph != nullptr);
-    processIOBlock (*this, *graph->renderSequenceDouble, buffer, midiMessages);
+
+    if (auto* sequences = graph->renderSequenceExchange->getSequenceInUse())
+        processIOBlock (*this, sequences->doubleSequence, buffer, midiMessages);
 }
 
 double AudioProcessorGraph::AudioGraphIOProcessor::getTailLengthSeconds() const
@@ -1585,4 +1764,172 @@ void AudioProcessorGraph::AudioGraphIOProcessor::setParentGraph (AudioProcessorG
     }
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorGraphLatencyCompensationTests  : public UnitTest
+{
+public:
+    AudioProcessorGraphLatencyCompensationTests()
+        : UnitTest ("AudioProcessorGraph latency compensation", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser_gui;
+
+        beginTest ("Parallel paths with mixed latencies are aligned, with one delay line per distinct latency");
+        {
+            // Compensations are 200, 200, 136, 136, 100 and 0, so three delay lines are needed
+            runParallelTest ({ 0, 0, 64, 64, 100, 200 }, 200 + 136 + 100);
+        }
+
+        beginTest ("Paths that all need the same compensation share a single delay line");
+        {
+            runParallelTest ({ 0, 0, 0, 50 }, 50);
+        }
+
+        beginTest ("Paths with equal latencies need no compensation");
+        {
+            runParallelTest ({ 32, 32, 32 }, 0);
+        }
+
+        beginTest ("Latencies accumulate along serial paths before being compensated");
+        {
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (1, 1, sampleRate, blockSize);
+
+            auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode));
+            auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode));
+
+            auto first  = graph.addNode (std::make_unique<DelayProcessor> (64));
+            auto second = graph.addNode (std::make_unique<DelayProcessor> (36));
+            auto single = graph.addNode (std::make_unique<DelayProcessor> (100));
+
+            connect (graph, input, first);
+            connect (graph, first, second);
+            connect (graph, second, output);
+            connect (graph, input, single);
+            connect (graph, single, output);
+            connect (graph, input, output);
+
+            graph.prepareToPlay (sampleRate, blockSize);
+
+            expectEquals (graph.getLatencySamples(), 100);
+            expectEquals ((int) graph.getLatencyCompensationMemoryUsage(), 100 * bytesPerSample);
+            expectImpulseAt (graph, 100, 3.0f);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int blockSize = 48, numBlocks = 10, impulsePosition = 5;
+    static constexpr int bytesPerSample = (int) (sizeof (float) + sizeof (double)); // a float and a double sequence are built
+
+    void runParallelTest (std::initializer_list<int> latencies, int expectedDelaySamples)
+    {
+        AudioProcessorGraph graph;
+        graph.setPlayConfigDetails (1, 1, sampleRate, blockSize);
+
+        auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode));
+        auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode));
+
+        for (auto latency : latencies)
+        {
+            auto node = graph.addNode (std::make_unique<DelayProcessor> (latency));
+            connect (graph, input, node);
+            connect (graph, node, output);
+        }
+
+        graph.prepareToPlay (sampleRate, blockSize);
+
+        const auto maxLatency = std::max (latencies);
+        expectEquals (graph.getLatencySamples(), maxLatency);
+        expectEquals ((int) graph.getLatencyCompensationMemoryUsage(), expectedDelaySamples * bytesPerSample);
+        expectImpulseAt (graph, maxLatency, (float) latencies.size());
+    }
+
+    void connect (AudioProcessorGraph& graph, const AudioProcessorGraph::Node::Ptr& source, const AudioProcessorGraph::Node::Ptr& dest)
+    {
+        expect (graph.addConnection ({ { source->nodeID, 0 }, { dest->nodeID, 0 } }));
+    }
+
+    // Feeds an impulse through the graph, and checks that every path's copy of it arrives at the same time
+    void expectImpulseAt (AudioProcessorGraph& graph, int latency, float expectedLevel)
+    {
+        AudioBuffer<float> buffer (1, blockSize);
+        MidiBuffer midi;
+        std::vector<float> output;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            buffer.clear();
+
+            if (block == 0)
+                buffer.setSample (0, impulsePosition, 1.0f);
+
+            graph.processBlock (buffer, midi);
+            output.insert (output.end(), buffer.getReadPointer (0), buffer.getReadPointer (0) + blockSize);
+        }
+
+        for (int i = 0; i < (int) output.size(); ++i)
+            expectWithinAbsoluteError (output[(size_t) i], i == impulsePosition + latency ? expectedLevel : 0.0f, 1.0e-6f);
+    }
+
+    // A mono processor that delays its input by exactly the latency it reports
+    class DelayProcessor  : public AudioProcessor
+    {
+    public:
+        explicit DelayProcessor (int latency)
+            : AudioProcessor (BusesProperties().withInput  ("Input",  AudioChannelSet::mono())
+                                               .withOutput ("Output", AudioChannelSet::mono())),
+              delayLine ((size_t) latency)
+        {
+            setLatencySamples (latency);
+        }
+
+        const String getName() const override                   { return "Delay"; }
+        void prepareToPlay (double, int) override               { std::fill (delayLine.begin(), delayLine.end(), 0.0f); position = 0; }
+        void releaseResources() override                        {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            if (delayLine.empty())
+                return;
+
+            auto* data = buffer.getWritePointer (0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                std::swap (data[i], delayLine[position]);
+                position = (position + 1) % delayLine.size();
+            }
+        }
+
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override            { return {}; }
+        bool acceptsMidi() const override                       { return {}; }
+        bool producesMidi() const override                      { return {}; }
+        AudioProcessorEditor* createEditor() override           { return {}; }
+        bool hasEditor() const override                         { return {}; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return {}; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+    private:
+        std::vector<float> delayLine;
+        size_t position = 0;
+    };
+};
+
+static AudioProcessorGraphLatencyCompensationTests audioProcessorGraphLatencyCompensationTests;
+
+#endif
+
 } // namespace juce
@@ -26,6 +26,8 @@
 namespace juce
 {
 
+class AudioProcessorGraphProfiler;
+
 //==============================================================================
 /**
     A type of AudioProcessor which plays back a graph of other AudioProcessors.
@@ -293,6 +295,22 @@ public:
     */
     bool removeIllegalConnections();
 
+    /** Returns the number of bytes currently allocated for the delay lines that
+        compensate for the latencies of the nodes in the graph.
+
+        Inputs that need the same amount of compensation share a delay line, so this
+        grows with the number of distinct latencies feeding each input rather than
+        with the number of connections.
+    */
+    size_t getLatencyCompensationMemoryUsage() const noexcept       { return latencyCompensationMemory; }
+
+    /** Returns the profiler that can measure how long each of the graph's nodes
+        takes to process. It's disabled until you call its setEnabled() method.
+
+        @see AudioProcessorGraphProfiler
+    */
+    AudioProcessorGraphProfiler& getProfiler() noexcept             { return *profiler; }
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -427,16 +445,22 @@ private:
     ReferenceCountedArray<Node> nodes;
     NodeID lastNodeID = {};
 
+    CriticalSection nodesLock;
+
     struct RenderSequenceFloat;
     struct RenderSequenceDouble;
-    std::unique_ptr<RenderSequenceFloat> renderSequenceFloat;
-    std::unique_ptr<RenderSequenceDouble> renderSequenceDouble;
+    struct RenderSequences;
+    class RenderSequenceExchange;
+    std::unique_ptr<RenderSequenceExchange> renderSequenceExchange;
 
     PrepareSettings prepareSettings;
 
     friend class AudioGraphIOProcessor;
 
     std::atomic<bool> isPrepared { false };
+    std::atomic<size_t> latencyCompensationMemory { 0 };
+
+    std::unique_ptr<AudioProcessorGraphProfiler> profiler;
 
     void topologyChanged();
     void unprepare();
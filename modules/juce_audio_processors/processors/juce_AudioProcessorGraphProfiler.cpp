@@ -0,0 +1,449 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+constexpr int AudioProcessorGraphProfiler::numHistogramBins;
+
+AudioProcessorGraphProfiler::AudioProcessorGraphProfiler (AudioProcessorGraph& g)  : graph (g) {}
+AudioProcessorGraphProfiler::~AudioProcessorGraphProfiler() {}
+
+//==============================================================================
+void AudioProcessorGraphProfiler::setEnabled (bool shouldBeEnabled)
+{
+    // The storage is never released while the graph exists, so the audio thread
+    // can't be left writing into it after the profiler is disabled.
+    if (shouldBeEnabled && fifoEvents.empty())
+    {
+        constexpr int fifoSize = 16384;
+        fifoEvents.resize ((size_t) fifoSize);
+        fifo.setTotalSize (fifoSize);
+    }
+
+    enabled.store (shouldBeEnabled, std::memory_order_release);
+}
+
+bool AudioProcessorGraphProfiler::beginBlock (int numNodes) noexcept
+{
+    // Only the audio thread writes to the FIFO, so the space can't shrink before the
+    // block's timings are pushed. Dropping whole blocks keeps each block's nodes together.
+    if (fifo.getFreeSpace() > numNodes)
+        return true;
+
+    ++numDroppedBlocks;
+    return false;
+}
+
+void AudioProcessorGraphProfiler::recordNode (AudioProcessorGraph::NodeID nodeID, int64 startTicks, int64 endTicks) noexcept
+{
+    push ({ startTicks, endTicks, nodeID.uid, 0 });
+}
+
+void AudioProcessorGraphProfiler::recordBlock (int64 startTicks, int64 endTicks, int numSamples) noexcept
+{
+    push ({ startTicks, endTicks, 0, numSamples });
+}
+
+void AudioProcessorGraphProfiler::push (const Event& e) noexcept
+{
+    const auto scope = fifo.write (1);
+
+    // (beginBlock() should have made sure that there was room for this)
+    jassert (scope.blockSize1 + scope.blockSize2 == 1);
+    scope.forEach ([&] (int index) { fifoEvents[(size_t) index] = e; });
+}
+
+//==============================================================================
+void AudioProcessorGraphProfiler::update()
+{
+    if (fifoEvents.empty())
+        return;
+
+    const auto scope = fifo.read (fifo.getNumReady());
+
+    scope.forEach ([this] (int index)
+    {
+        const auto& e = fifoEvents[(size_t) index];
+
+        if (traceEvents.size() < maxNumTraceEvents)
+        {
+            traceEvents.push_back (e);
+        }
+        else if (! traceEvents.empty())
+        {
+            traceEvents[nextTraceIndex] = e;
+            nextTraceIndex = (nextTraceIndex + 1) % traceEvents.size();
+        }
+
+        // A block's nodes are always recorded before the block itself
+        if (e.nodeID == 0)
+            processBlockEvent (e);
+        else
+            currentBlockNodes.push_back (e);
+    });
+}
+
+void AudioProcessorGraphProfiler::processBlockEvent (const Event& blockEvent)
+{
+    auto toMs = [] (const Event& e) { return 1000.0 * Time::highResolutionTicksToSeconds (e.endTicks - e.startTicks); };
+
+    const auto sampleRate = graph.getSampleRate();
+    const auto blockDurationMs = sampleRate > 0 ? 1000.0 * blockEvent.numSamples / sampleRate : 0.0;
+    auto toLoad = [blockDurationMs] (double ms) { return blockDurationMs > 0 ? ms / blockDurationMs : 0.0; };
+
+    const auto graphLoad = toLoad (toMs (blockEvent));
+    const auto missedDeadline = graphLoad > 1.0;
+
+    ++graphStats.numBlocks;
+    totalLoad += graphLoad;
+    graphStats.averageLoad = totalLoad / graphStats.numBlocks;
+    graphStats.worstLoad = jmax (graphStats.worstLoad, graphLoad);
+
+    if (missedDeadline)
+        ++graphStats.numDeadlineMisses;
+
+    NodeAccumulator* slowestNode = nullptr;
+    double slowestTimeMs = -1.0;
+
+    for (const auto& e : currentBlockNodes)
+    {
+        auto& node = nodes[e.nodeID];
+
+        if (node.stats.name.isEmpty())
+        {
+            node.stats.nodeID = AudioProcessorGraph::NodeID (e.nodeID);
+
+            if (auto* n = graph.getNodeForId (node.stats.nodeID))
+                node.stats.name = n->getProcessor()->getName();
+        }
+
+        const auto timeMs = toMs (e);
+        const auto load = toLoad (timeMs);
+
+        auto& stats = node.stats;
+        ++stats.numBlocks;
+        node.totalTimeMs += timeMs;
+        stats.averageTimeMs = node.totalTimeMs / stats.numBlocks;
+        stats.worstTimeMs = jmax (stats.worstTimeMs, timeMs);
+        stats.worstLoad = jmax (stats.worstLoad, load);
+        ++stats.loadHistogram[(size_t) jlimit (0, numHistogramBins - 1, (int) (load * numHistogramBins))];
+
+        if (timeMs > slowestTimeMs)
+        {
+            slowestTimeMs = timeMs;
+            slowestNode = &node;
+        }
+    }
+
+    if (missedDeadline && slowestNode != nullptr)
+        ++slowestNode->stats.numDeadlineMisses;
+
+    currentBlockNodes.clear();
+}
+
+void AudioProcessorGraphProfiler::reset()
+{
+    update();
+
+    nodes.clear();
+    currentBlockNodes.clear();
+    graphStats = {};
+    totalLoad = 0;
+    traceEvents.clear();
+    nextTraceIndex = 0;
+    numDroppedBlocks = 0;
+}
+
+Array<AudioProcessorGraphProfiler::NodeStatistics> AudioProcessorGraphProfiler::getNodeStatistics() const
+{
+    Array<NodeStatistics> result;
+
+    for (const auto& n : nodes)
+        result.add (n.second.stats);
+
+    return result;
+}
+
+//==============================================================================
+void AudioProcessorGraphProfiler::setMaxNumTraceEvents (int maxNumEvents)
+{
+    jassert (maxNumEvents >= 0);
+    maxNumTraceEvents = (size_t) jmax (0, maxNumEvents);
+
+    if (traceEvents.size() > maxNumTraceEvents)
+    {
+        std::rotate (traceEvents.begin(), traceEvents.begin() + (std::ptrdiff_t) nextTraceIndex, traceEvents.end());
+        traceEvents.erase (traceEvents.begin(), traceEvents.end() - (std::ptrdiff_t) maxNumTraceEvents);
+        nextTraceIndex = 0;
+    }
+}
+
+void AudioProcessorGraphProfiler::writeChromeTrace (OutputStream& out) const
+{
+    const auto numEvents = traceEvents.size();
+    auto getEvent = [&] (size_t i) -> const Event& { return traceEvents[(nextTraceIndex + i) % numEvents]; };
+
+    const auto firstTicks = numEvents > 0 ? getEvent (0).startTicks : 0;
+    auto ticksToMicroseconds = [] (int64 ticks) { return String (1.0e6 * Time::highResolutionTicksToSeconds (ticks), 3); };
+
+    out << "{\"traceEvents\":[";
+
+    for (size_t i = 0; i < numEvents; ++i)
+    {
+        const auto& e = getEvent (i);
+
+        String name ("Graph"), category ("block");
+
+        if (e.nodeID != 0)
+        {
+            const auto node = nodes.find (e.nodeID);
+            name = node != nodes.end() && node->second.stats.name.isNotEmpty() ? node->second.stats.name
+                                                                                : "Node " + String (e.nodeID);
+            category = "node";
+        }
+
+        out << (i > 0 ? ",\n" : "\n")
+            << "{\"name\":" << JSON::toString (name)
+            << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+            << ",\"ts\":" << ticksToMicroseconds (e.startTicks - firstTicks)
+            << ",\"dur\":" << ticksToMicroseconds (e.endTicks - e.startTicks);
+
+        if (e.nodeID == 0)
+            out << ",\"args\":{\"numSamples\":" << e.numSamples << "}";
+        else
+            out << ",\"args\":{\"nodeID\":" << (int64) e.nodeID << "}";
+
+        out << "}";
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorGraphProfilerTests  : public UnitTest
+{
+public:
+    AudioProcessorGraphProfilerTests()
+        : UnitTest ("AudioProcessorGraphProfiler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser_gui;
+
+        constexpr int numBlocks = 4, blockSize = 64;
+        constexpr double sampleRate = 44100.0;
+
+        AudioProcessorGraph graph;
+        auto fast = graph.addNode (std::make_unique<TestProcessor> ("Fast", 0));
+        auto slow = graph.addNode (std::make_unique<TestProcessor> ("Slow", 5)); // longer than a block
+        graph.prepareToPlay (sampleRate, blockSize);
+
+        AudioBuffer<float> buffer (2, blockSize);
+        MidiBuffer midi;
+
+        auto& profiler = graph.getProfiler();
+
+        beginTest ("Nothing is recorded while disabled");
+        {
+            for (int i = 0; i < numBlocks; ++i)
+                graph.processBlock (buffer, midi);
+
+            profiler.update();
+            expectEquals (profiler.getGraphStatistics().numBlocks, 0);
+            expect (profiler.getNodeStatistics().isEmpty());
+        }
+
+        beginTest ("Blocks and nodes are profiled while enabled");
+        {
+            profiler.setEnabled (true);
+
+            for (int i = 0; i < numBlocks; ++i)
+                graph.processBlock (buffer, midi);
+
+            profiler.setEnabled (false);
+            graph.processBlock (buffer, midi);
+            profiler.update();
+
+            const auto graphStats = profiler.getGraphStatistics();
+            expectEquals (graphStats.numBlocks, numBlocks);
+            expectEquals (graphStats.numDeadlineMisses, numBlocks);
+            expectGreaterThan (graphStats.worstLoad, 1.0);
+
+            const auto nodeStats = profiler.getNodeStatistics();
+            expectEquals (nodeStats.size(), 2);
+
+            for (const auto& stats : nodeStats)
+            {
+                const auto isSlow = stats.nodeID == slow->nodeID;
+                expect (isSlow || stats.nodeID == fast->nodeID);
+                expectEquals (stats.name, String (isSlow ? "Slow" : "Fast"));
+                expectEquals (stats.numBlocks, numBlocks);
+                expectEquals (std::accumulate (stats.loadHistogram.begin(), stats.loadHistogram.end(), 0), numBlocks);
+                expectEquals (stats.numDeadlineMisses, isSlow ? numBlocks : 0);
+
+                if (isSlow)
+                    expectGreaterOrEqual (stats.worstTimeMs, 5.0);
+            }
+
+            expectEquals (profiler.getNumDroppedBlocks(), 0);
+        }
+
+        beginTest ("Chrome trace contains every event");
+        {
+            MemoryOutputStream out;
+            profiler.writeChromeTrace (out);
+
+            const auto trace = JSON::parse (out.toString());
+            const auto* events = trace["traceEvents"].getArray();
+
+            expect (events != nullptr);
+
+            if (events != nullptr)
+            {
+                expectEquals (events->size(), numBlocks * 3);
+                const auto firstName = (*events)[0]["name"].toString();
+                expect (firstName == "Fast" || firstName == "Slow");
+                expectEquals ((*events)[2]["name"].toString(), String ("Graph"));
+                expectEquals ((int) (*events)[2]["args"]["numSamples"], blockSize);
+            }
+        }
+
+        beginTest ("The trace keeps only the most recent events");
+        {
+            profiler.setMaxNumTraceEvents (4);
+
+            MemoryOutputStream out;
+            profiler.writeChromeTrace (out);
+
+            const auto trace = JSON::parse (out.toString());
+
+            if (const auto* events = trace["traceEvents"].getArray())
+            {
+                expectEquals (events->size(), 4);
+                expectEquals ((*events)[3]["name"].toString(), String ("Graph"));
+            }
+            else
+            {
+                expect (false);
+            }
+
+            profiler.reset();
+            expectEquals (profiler.getGraphStatistics().numBlocks, 0);
+        }
+
+        beginTest ("Blocks that are bigger than the graph's block size are profiled in chunks");
+        {
+            AudioBuffer<float> bigBuffer (2, blockSize * 3 + 10);
+
+            profiler.setEnabled (true);
+            graph.processBlock (bigBuffer, midi);
+            profiler.setEnabled (false);
+            profiler.update();
+
+            const auto graphStats = profiler.getGraphStatistics();
+            expectEquals (graphStats.numBlocks, 4);
+            expectEquals (graphStats.numDeadlineMisses, 4);
+
+            for (const auto& stats : profiler.getNodeStatistics())
+                expectEquals (stats.numBlocks, 4);
+
+            profiler.reset();
+        }
+
+        beginTest ("A full FIFO drops whole blocks");
+        {
+            AudioProcessorGraph fastGraph;
+
+            for (int i = 0; i < 3; ++i)
+                fastGraph.addNode (std::make_unique<TestProcessor> ("Fast " + String (i), 0));
+
+            fastGraph.prepareToPlay (sampleRate, blockSize);
+
+            auto& fastProfiler = fastGraph.getProfiler();
+            fastProfiler.setEnabled (true);
+
+            // each block pushes four timings, which won't divide into the size of the FIFO
+            constexpr int numFastBlocks = 5000;
+
+            for (int i = 0; i < numFastBlocks; ++i)
+                fastGraph.processBlock (buffer, midi);
+
+            fastProfiler.update();
+            fastGraph.processBlock (buffer, midi);
+            fastProfiler.update();
+
+            const auto graphStats = fastProfiler.getGraphStatistics();
+            expectGreaterThan (fastProfiler.getNumDroppedBlocks(), 0);
+            expectEquals (graphStats.numBlocks + fastProfiler.getNumDroppedBlocks(), numFastBlocks + 1);
+
+            const auto nodeStats = fastProfiler.getNodeStatistics();
+            expectEquals (nodeStats.size(), 3);
+
+            for (const auto& stats : nodeStats)
+                expectEquals (stats.numBlocks, graphStats.numBlocks);
+        }
+    }
+
+private:
+    class TestProcessor  : public AudioProcessor
+    {
+    public:
+        TestProcessor (const String& nameToUse, int millisecondsToSleep)
+            : name (nameToUse), sleepMs (millisecondsToSleep) {}
+
+        const String getName() const override                   { return name; }
+        void prepareToPlay (double, int) override               {}
+        void releaseResources() override                        {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override   { if (sleepMs > 0) Thread::sleep (sleepMs); }
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override            { return {}; }
+        bool acceptsMidi() const override                       { return {}; }
+        bool producesMidi() const override                      { return {}; }
+        AudioProcessorEditor* createEditor() override           { return {}; }
+        bool hasEditor() const override                         { return {}; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return {}; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+    private:
+        const String name;
+        const int sleepMs;
+    };
+};
+
+static AudioProcessorGraphProfilerTests audioProcessorGraphProfilerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Measures how long each node of an AudioProcessorGraph takes to process.
+
+    Every AudioProcessorGraph owns one of these, which you can get with
+    AudioProcessorGraph::getProfiler(). While it's enabled, the audio thread times
+    the whole graph and each of its nodes on every block, and pushes the timings
+    into a preallocated lock-free FIFO. Calling update() on the message thread (e.g.
+    from a Timer) drains the FIFO and accumulates per-node statistics: a histogram
+    of how much of the block's duration each node used, its average and worst-case
+    times, and the number of blocks that overran in which it was the slowest node.
+
+    A block counts as having overrun when the graph took longer than the block's
+    duration at the graph's sample rate. The audio device may also be doing other
+    work in its callback, so this is a lower bound on the number of real xruns.
+
+    If the host passes in more samples than the graph was prepared for, the graph
+    processes them in several chunks, and each chunk is profiled as a separate block.
+
+    When the profiler is disabled, the audio thread's only overhead is checking a
+    flag once per block.
+
+    @see AudioProcessorGraph::getProfiler, AudioProcessLoadMeasurer
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorGraphProfiler
+{
+public:
+    //==============================================================================
+    /** The number of bins in each node's load histogram. */
+    static constexpr int numHistogramBins = 20;
+
+    /** Statistics for a single node. */
+    struct NodeStatistics
+    {
+        /** The node that these statistics describe. */
+        AudioProcessorGraph::NodeID nodeID;
+
+        /** The name of the node's processor. */
+        String name;
+
+        /** The number of blocks that the node has processed. */
+        int numBlocks = 0;
+
+        /** The mean and longest times taken to process a block, in milliseconds. */
+        double averageTimeMs = 0, worstTimeMs = 0;
+
+        /** The largest fraction of a block's duration that the node has used. */
+        double worstLoad = 0;
+
+        /** The number of overrunning blocks in which this was the slowest node. */
+        int numDeadlineMisses = 0;
+
+        /** The number of blocks in which the node used each fraction of the block's
+            duration. Bin i counts loads from i / numHistogramBins up to
+            (i + 1) / numHistogramBins, and the last bin also counts any load above 1.
+        */
+        std::array<int, numHistogramBins> loadHistogram {};
+    };
+
+    /** Statistics for the graph as a whole. */
+    struct GraphStatistics
+    {
+        /** The number of blocks that the graph has processed. */
+        int numBlocks = 0;
+
+        /** The number of blocks that took longer to process than their duration. */
+        int numDeadlineMisses = 0;
+
+        /** The mean and largest fractions of a block's duration that the graph has used. */
+        double averageLoad = 0, worstLoad = 0;
+    };
+
+    //==============================================================================
+    /** Destructor. */
+    ~AudioProcessorGraphProfiler();
+
+    /** Starts or stops profiling.
+
+        The first time the profiler is enabled, this allocates its FIFO, so it should
+        be called on the message thread.
+    */
+    void setEnabled (bool shouldBeEnabled);
+
+    /** Returns true if the profiler is recording. */
+    bool isEnabled() const noexcept                     { return enabled.load (std::memory_order_acquire); }
+
+    /** Collects the timings that the audio thread has recorded since the last call.
+
+        Call this regularly while profiling, from the message thread, so that the FIFO
+        doesn't fill up. If it does, the timings of whole blocks are dropped (see
+        getNumDroppedBlocks()).
+    */
+    void update();
+
+    /** Discards all the statistics and trace events collected so far. */
+    void reset();
+
+    /** Returns the statistics for each node that has been profiled, as of the last update(). */
+    Array<NodeStatistics> getNodeStatistics() const;
+
+    /** Returns the statistics for the whole graph, as of the last update(). */
+    GraphStatistics getGraphStatistics() const noexcept  { return graphStats; }
+
+    /** Returns the number of blocks that weren't profiled because the FIFO was full. */
+    int getNumDroppedBlocks() const noexcept            { return numDroppedBlocks.load(); }
+
+    //==============================================================================
+    /** Sets how many of the most recent timings are kept for writeChromeTrace().
+        The default is 100000.
+    */
+    void setMaxNumTraceEvents (int maxNumEvents);
+
+    /** Writes the most recent timings as a Chrome trace event file.
+
+        The result is a JSON object that can be loaded into chrome://tracing or
+        Perfetto, showing each block of the graph with its nodes' processing inside it.
+    */
+    void writeChromeTrace (OutputStream& output) const;
+
+    //==============================================================================
+    /** @internal */
+    bool beginBlock (int numNodes) noexcept;
+    /** @internal */
+    void recordNode (AudioProcessorGraph::NodeID, int64 startTicks, int64 endTicks) noexcept;
+    /** @internal */
+    void recordBlock (int64 startTicks, int64 endTicks, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    friend class AudioProcessorGraph;
+    explicit AudioProcessorGraphProfiler (AudioProcessorGraph&);
+
+    struct Event
+    {
+        int64 startTicks, endTicks;
+        uint32 nodeID;      // zero for a whole block
+        int numSamples;
+    };
+
+    struct NodeAccumulator
+    {
+        NodeStatistics stats;
+        double totalTimeMs = 0;
+    };
+
+    void push (const Event&) noexcept;
+    void processBlockEvent (const Event&);
+
+    AudioProcessorGraph& graph;
+    std::atomic<bool> enabled { false };
+    std::atomic<int> numDroppedBlocks { 0 };
+
+    AbstractFifo fifo { 1 };
+    std::vector<Event> fifoEvents;
+
+    std::map<uint32, NodeAccumulator> nodes;
+    std::vector<Event> currentBlockNodes;
+    GraphStatistics graphStats;
+    double totalLoad = 0;
+
+    std::vector<Event> traceEvents;     // used as a ring buffer once it's full
+    size_t maxNumTraceEvents = 100000, nextTraceIndex = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorGraphProfiler)
+};
+
+} // namespace juce
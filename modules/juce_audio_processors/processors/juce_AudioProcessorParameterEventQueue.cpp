@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+void AudioProcessorParameterEventQueue::ensureSize (int numEventsToAllocate)
+{
+    events.reserve ((size_t) jmax (0, numEventsToAllocate));
+}
+
+void AudioProcessorParameterEventQueue::addEvent (AudioProcessorParameter& parameter, int sampleOffset, float newValue)
+{
+    // Events usually arrive in order, so we search backwards for the insertion point
+    auto insertPoint = events.end();
+
+    while (insertPoint != events.begin() && std::prev (insertPoint)->sampleOffset > sampleOffset)
+        --insertPoint;
+
+    events.insert (insertPoint, { &parameter, sampleOffset, newValue });
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorParameterEventQueueTests  : public UnitTest
+{
+public:
+    AudioProcessorParameterEventQueueTests()
+        : UnitTest ("AudioProcessorParameterEventQueue", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        AudioParameterFloat a ("a", "A", 0.0f, 1.0f, 0.0f);
+        AudioParameterFloat b ("b", "B", 0.0f, 1.0f, 0.0f);
+
+        beginTest ("Events are sorted by sample position");
+        {
+            AudioProcessorParameterEventQueue queue;
+            queue.addEvent (a, 10, 0.1f);
+            queue.addEvent (b, 5, 0.2f);
+            queue.addEvent (a, 10, 0.3f);
+            queue.addEvent (b, 0, 0.4f);
+
+            expectEquals (queue.getNumEvents(), 4);
+
+            Array<float> values;
+
+            for (const auto& e : queue)
+                values.add (e.value);
+
+            expect (values == Array<float> { 0.4f, 0.2f, 0.1f, 0.3f });
+
+            queue.clear();
+            expect (queue.isEmpty());
+        }
+
+        beginTest ("Blocks are split at event positions");
+        {
+            AudioProcessorParameterEventQueue queue;
+            queue.addEvent (a, 0, 0.5f);
+            queue.addEvent (b, 16, 0.5f);
+            queue.addEvent (a, 40, 0.5f);
+            queue.addEvent (b, 100, 0.5f);
+
+            Array<int> ranges;
+            int numEvents = 0;
+
+            queue.splitBlock (64,
+                              [&] (const AudioProcessorParameterEventQueue::Event&) { ++numEvents; },
+                              [&] (int start, int num) { ranges.add (start, num); });
+
+            expectEquals (numEvents, 4);
+            expect (ranges == Array<int> { 0, 16, 16, 24, 40, 24 });
+        }
+    }
+};
+
+static AudioProcessorParameterEventQueueTests audioProcessorParameterEventQueueTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AudioProcessorParameter;
+
+//==============================================================================
+/**
+    Holds a list of timestamped parameter changes for a single block of audio.
+
+    An AudioProcessor that has called AudioProcessor::setParameterEventQueueEnabled()
+    will find every automation point that the host sent for the current block in
+    its queue when its processBlock() method is called. The events are ordered by
+    their sample position within the block, so that the processor can split its
+    processing at the exact points where parameters change, or ramp between them,
+    instead of smoothing towards a single per-block value.
+
+    @see AudioProcessor::getParameterEventQueue
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorParameterEventQueue
+{
+public:
+    //==============================================================================
+    /** A single timestamped parameter change. */
+    struct Event
+    {
+        /** The parameter whose value is changing. */
+        AudioProcessorParameter* parameter;
+
+        /** The position of the change, in samples from the start of the block. */
+        int sampleOffset;
+
+        /** The new normalised value of the parameter, in the range 0 to 1. */
+        float value;
+    };
+
+    //==============================================================================
+    /** Creates an empty queue. */
+    AudioProcessorParameterEventQueue() = default;
+
+    /** Preallocates space for the given number of events.
+
+        Adding events never allocates unless the queue grows beyond this size, so
+        call this before processing starts.
+    */
+    void ensureSize (int numEventsToAllocate);
+
+    /** Removes all the events from the queue. */
+    void clear() noexcept                               { events.clear(); }
+
+    /** Adds a parameter change to the queue.
+
+        The queue is kept sorted by sample position. Events that are added with the
+        same sample position will keep the order in which they were added.
+    */
+    void addEvent (AudioProcessorParameter& parameter, int sampleOffset, float newValue);
+
+    /** Returns the number of events in the queue. */
+    int getNumEvents() const noexcept                   { return (int) events.size(); }
+
+    /** Returns true if the queue contains no events. */
+    bool isEmpty() const noexcept                       { return events.empty(); }
+
+    /** Returns a pointer to the first event in the queue. */
+    const Event* begin() const noexcept                 { return events.data(); }
+
+    /** Returns a pointer to the end of the queue. */
+    const Event* end() const noexcept                   { return events.data() + events.size(); }
+
+    //==============================================================================
+    /** Divides a block of samples at the positions of the events in the queue.
+
+        Walking through the block in order, the eventCallback is called for each event
+        as it is reached, and the rangeCallback is called for each span of samples
+        during which no parameter changes. This makes it easy to apply each change at
+        its exact position:
+
+        @code
+        queue.splitBlock (buffer.getNumSamples(),
+                          [&] (const Event& e)                 { applyParameter (*e.parameter, e.value); },
+                          [&] (int startSample, int numSamples) { renderSamples (buffer, startSample, numSamples); });
+        @endcode
+
+        Events positioned beyond the end of the block are applied after the last range.
+    */
+    template <typename EventCallback, typename RangeCallback>
+    void splitBlock (int numSamples, EventCallback&& eventCallback, RangeCallback&& rangeCallback) const
+    {
+        int position = 0;
+
+        for (const auto& event : events)
+        {
+            const auto eventPosition = jlimit (position, numSamples, event.sampleOffset);
+
+            if (eventPosition > position)
+                rangeCallback (position, eventPosition - position);
+
+            position = eventPosition;
+            eventCallback (event);
+        }
+
+        if (position < numSamples)
+            rangeCallback (position, numSamples - position);
+    }
+
+private:
+    //==============================================================================
+    std::vector<Event> events;
+
+    JUCE_LEAK_DETECTOR (AudioProcessorParameterEventQueue)
+};
+
+} // namespace juce
@@ -0,0 +1,662 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+// Collects a worker's reply to a single scan request
+class PluginScanReply
+{
+public:
+    enum class Result
+    {
+        loaded,
+        crashed,
+        timedOut,
+        cancelled
+    };
+
+    void reset()
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        gotResponse = false;
+        response = nullptr;
+    }
+
+    void setResponse (const MemoryBlock& mb)
+    {
+        auto xml = parseXML (mb.toString());
+
+        const std::lock_guard<std::mutex> lock (mutex);
+        response = std::move (xml);
+        gotResponse = true;
+        condvar.notify_one();
+    }
+
+    void setConnectionLost()
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        response = nullptr;
+        gotResponse = true;
+        connectionLost = true;
+        condvar.notify_one();
+    }
+
+    template <typename ShouldExitFn>
+    Result waitForResponse (OwnedArray<PluginDescription>& result, int timeoutMs, ShouldExitFn&& shouldExit)
+    {
+        const auto startTime = Time::getMillisecondCounter();
+
+        std::unique_lock<std::mutex> lock (mutex);
+
+        while (! condvar.wait_for (lock, std::chrono::milliseconds (50), [this] { return gotResponse; }))
+        {
+            if (shouldExit())
+                return Result::cancelled;
+
+            if (timeoutMs > 0 && Time::getMillisecondCounter() - startTime >= (uint32) timeoutMs)
+                return Result::timedOut;
+        }
+
+        if (connectionLost)
+            return Result::crashed;
+
+        if (response != nullptr)
+        {
+            for (const auto* item : response->getChildIterator())
+            {
+                auto desc = std::make_unique<PluginDescription>();
+
+                if (desc->loadFromXml (*item))
+                    result.add (std::move (desc));
+            }
+        }
+
+        return Result::loaded;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condvar;
+    std::unique_ptr<XmlElement> response;
+    bool gotResponse = false, connectionLost = false;
+};
+
+//==============================================================================
+class ChildProcessPluginScanner::WorkerConnection  : private ChildProcessCoordinator
+{
+public:
+    using Result = PluginScanReply::Result;
+
+    WorkerConnection() = default;
+
+    ~WorkerConnection() override
+    {
+        // Make sure the connection thread has stopped before our members are destroyed
+        killWorkerProcess();
+    }
+
+    bool launch (const File& executable, const String& processUID)
+    {
+        return launchWorkerProcess (executable, processUID, 0, 0);
+    }
+
+    template <typename ShouldExitFn>
+    Result scan (const String& formatName,
+                 const String& fileOrIdentifier,
+                 OwnedArray<PluginDescription>& result,
+                 int timeoutMs,
+                 ShouldExitFn&& shouldExit)
+    {
+        MemoryBlock block;
+
+        {
+            MemoryOutputStream stream { block, false };
+            stream.writeString (formatName);
+            stream.writeString (fileOrIdentifier);
+        }
+
+        reply.reset();
+
+        if (! sendMessageToWorker (block))
+            return Result::crashed;
+
+        return reply.waitForResponse (result, timeoutMs, std::forward<ShouldExitFn> (shouldExit));
+    }
+
+private:
+    void handleMessageFromWorker (const MemoryBlock& mb) override   { reply.setResponse (mb); }
+    void handleConnectionLost() override                            { reply.setConnectionLost(); }
+
+    PluginScanReply reply;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerConnection)
+};
+
+//==============================================================================
+ChildProcessPluginScanner::ChildProcessPluginScanner (const File& workerExecutable,
+                                                      const String& processUID,
+                                                      int maxNumWorkers,
+                                                      const File& cacheFileToUse)
+    : executable (workerExecutable),
+      uid (processUID),
+      maxWorkers (jmax (1, maxNumWorkers)),
+      cacheFile (cacheFileToUse)
+{
+    loadCache();
+}
+
+ChildProcessPluginScanner::~ChildProcessPluginScanner()
+{
+    killAllWorkers();
+    saveCache();
+}
+
+//==============================================================================
+bool ChildProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& result,
+                                                    const String& fileOrIdentifier)
+{
+    // Only things that live on disk can be cached, e.g. AudioUnit identifiers can't
+    const auto file = File::isAbsolutePath (fileOrIdentifier) ? File (fileOrIdentifier) : File();
+    const auto canUseCache = cacheFile != File() && file.exists();
+    const auto key = getCacheKey (format, fileOrIdentifier);
+
+    bool crashed = false;
+
+    if (canUseCache && findCachedTypes (key, file, result, crashed))
+        return ! crashed;
+
+    auto worker = acquireWorker();
+
+    if (worker == nullptr)
+    {
+        if (! shouldExit())
+        {
+            // If you hit this, the worker process couldn't be launched. Make sure that your
+            // app calls Worker::initialiseFromCommandLine() with the same process UID in its
+            // startup code. The plugin will be scanned in-process instead.
+            jassertfalse;
+            format.findAllTypesForFile (result, fileOrIdentifier);
+        }
+
+        return true;
+    }
+
+    const auto outcome = worker->scan (format.getName(), fileOrIdentifier, result,
+                                       scanTimeoutMs.load(), [this] { return shouldExit(); });
+
+    // A worker that crashed or is still busy with a cancelled or hung scan can't be reused
+    releaseWorker (outcome == WorkerConnection::Result::loaded ? std::move (worker) : nullptr);
+
+    if (outcome == WorkerConnection::Result::cancelled)
+    {
+        result.clear();
+        return true;
+    }
+
+    // A plugin that hangs is blacklisted in the same way as one that crashes
+    crashed = (outcome == WorkerConnection::Result::crashed
+                || outcome == WorkerConnection::Result::timedOut);
+
+    if (canUseCache)
+        addToCache (key, file, result, crashed);
+
+    return ! crashed;
+}
+
+void ChildProcessPluginScanner::scanFinished()
+{
+    killAllWorkers();
+    saveCache();
+}
+
+void ChildProcessPluginScanner::setScanTimeout (int milliseconds) noexcept
+{
+    scanTimeoutMs = jmax (0, milliseconds);
+}
+
+//==============================================================================
+std::unique_ptr<ChildProcessPluginScanner::WorkerConnection> ChildProcessPluginScanner::acquireWorker()
+{
+    {
+        std::unique_lock<std::mutex> lock (workerMutex);
+
+        while (! workerAvailable.wait_for (lock, std::chrono::milliseconds (50),
+                                           [this] { return ! idleWorkers.empty() || numWorkersInUse < maxWorkers; }))
+        {
+            if (shouldExit())
+                return nullptr;
+        }
+
+        ++numWorkersInUse;
+
+        if (! idleWorkers.empty())
+        {
+            auto worker = std::move (idleWorkers.back());
+            idleWorkers.pop_back();
+            return worker;
+        }
+    }
+
+    auto worker = std::make_unique<WorkerConnection>();
+
+    if (worker->launch (executable, uid))
+        return worker;
+
+    releaseWorker (nullptr);
+    return nullptr;
+}
+
+void ChildProcessPluginScanner::releaseWorker (std::unique_ptr<WorkerConnection> worker)
+{
+    {
+        const std::lock_guard<std::mutex> lock (workerMutex);
+        --numWorkersInUse;
+
+        if (worker != nullptr)
+            idleWorkers.push_back (std::move (worker));
+    }
+
+    workerAvailable.notify_one();
+}
+
+void ChildProcessPluginScanner::killAllWorkers()
+{
+    std::vector<std::unique_ptr<WorkerConnection>> workersToKill;
+
+    {
+        const std::lock_guard<std::mutex> lock (workerMutex);
+        std::swap (workersToKill, idleWorkers);
+    }
+}
+
+//==============================================================================
+String ChildProcessPluginScanner::getCacheKey (const AudioPluginFormat& format, const String& fileOrIdentifier)
+{
+    return format.getName() + ":" + fileOrIdentifier;
+}
+
+bool ChildProcessPluginScanner::findCachedTypes (const String& key, const File& file,
+                                                 OwnedArray<PluginDescription>& result, bool& crashed)
+{
+    const ScopedLock sl (cacheLock);
+
+    const auto it = cache.find (key);
+
+    if (it == cache.end())
+        return false;
+
+    const auto& entry = it->second;
+
+    if (entry.modificationTime != file.getLastModificationTime() || entry.fileSize != file.getSize())
+        return false;
+
+    for (const auto& desc : entry.types)
+        result.add (new PluginDescription (desc));
+
+    crashed = entry.crashed;
+    return true;
+}
+
+void ChildProcessPluginScanner::addToCache (const String& key, const File& file,
+                                            const OwnedArray<PluginDescription>& types, bool crashed)
+{
+    CacheEntry entry;
+    entry.modificationTime = file.getLastModificationTime();
+    entry.fileSize = file.getSize();
+    entry.crashed = crashed;
+
+    for (const auto* desc : types)
+        entry.types.add (*desc);
+
+    const ScopedLock sl (cacheLock);
+    cache[key] = std::move (entry);
+    cacheNeedsSaving = true;
+}
+
+void ChildProcessPluginScanner::clearCache()
+{
+    const ScopedLock sl (cacheLock);
+    cache.clear();
+    cacheNeedsSaving = true;
+}
+
+void ChildProcessPluginScanner::loadCache()
+{
+    if (cacheFile == File())
+        return;
+
+    if (auto xml = parseXMLIfTagMatches (cacheFile, "PLUGINSCANCACHE"))
+    {
+        const ScopedLock sl (cacheLock);
+
+        for (const auto* e : xml->getChildWithTagNameIterator ("ENTRY"))
+        {
+            CacheEntry entry;
+            entry.modificationTime = Time (e->getStringAttribute ("modified").getLargeIntValue());
+            entry.fileSize = e->getStringAttribute ("size").getLargeIntValue();
+            entry.crashed = e->getBoolAttribute ("crashed");
+
+            for (const auto* p : e->getChildIterator())
+            {
+                PluginDescription desc;
+
+                if (desc.loadFromXml (*p))
+                    entry.types.add (desc);
+            }
+
+            cache[e->getStringAttribute ("key")] = std::move (entry);
+        }
+    }
+}
+
+void ChildProcessPluginScanner::saveCache()
+{
+    const ScopedLock sl (cacheLock);
+
+    if (cacheFile == File() || ! cacheNeedsSaving)
+        return;
+
+    XmlElement xml ("PLUGINSCANCACHE");
+
+    for (const auto& item : cache)
+    {
+        auto* e = xml.createNewChildElement ("ENTRY");
+        e->setAttribute ("key", item.first);
+        e->setAttribute ("modified", String (item.second.modificationTime.toMilliseconds()));
+        e->setAttribute ("size", String (item.second.fileSize));
+        e->setAttribute ("crashed", item.second.crashed);
+
+        for (const auto& desc : item.second.types)
+            e->addChildElement (desc.createXml().release());
+    }
+
+    if (xml.writeTo (cacheFile))
+        cacheNeedsSaving = false;
+}
+
+//==============================================================================
+ChildProcessPluginScanner::Worker::Worker()  : Thread ("Plugin scanner worker") {}
+
+ChildProcessPluginScanner::Worker::~Worker()
+{
+    cancelPendingUpdate();
+    stopThread (-1);
+}
+
+bool ChildProcessPluginScanner::Worker::initialiseFromCommandLine (const String& commandLine, const String& processUID)
+{
+    if (! ChildProcessWorker::initialiseFromCommandLine (commandLine, processUID))
+        return false;
+
+    startThread();
+    return true;
+}
+
+static MemoryBlock popScanRequest (std::mutex& mutex, std::queue<MemoryBlock>& queue)
+{
+    const std::lock_guard<std::mutex> lock (mutex);
+
+    if (queue.empty())
+        return {};
+
+    auto out = std::move (queue.front());
+    queue.pop();
+    return out;
+}
+
+void ChildProcessPluginScanner::Worker::handleMessageFromCoordinator (const MemoryBlock& mb)
+{
+    if (mb.isEmpty())
+        return;
+
+    // The scan happens on our own thread, so that this connection thread stays free to
+    // answer the coordinator's pings while a slow plugin is loading
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        incomingBlocks.emplace (mb);
+    }
+
+    notify();
+}
+
+void ChildProcessPluginScanner::Worker::handleConnectionLost()
+{
+    // If a scan is still running, the coordinator has given up on it, so the plugin has
+    // probably hung and may never return control to us
+    if (numScansInProgress.load() > 0)
+        Process::terminate();
+
+    JUCEApplicationBase::quit();
+}
+
+void ChildProcessPluginScanner::Worker::run()
+{
+    while (! threadShouldExit())
+    {
+        const auto block = popScanRequest (mutex, incomingBlocks);
+
+        if (block.isEmpty())
+        {
+            wait (-1);
+            continue;
+        }
+
+        // Some formats need to be created on the message thread, so we'll defer those
+        if (! doScan (block))
+        {
+            {
+                const std::lock_guard<std::mutex> lock (mutex);
+                messageThreadBlocks.emplace (block);
+            }
+
+            triggerAsyncUpdate();
+        }
+    }
+}
+
+void ChildProcessPluginScanner::Worker::handleAsyncUpdate()
+{
+    for (;;)
+    {
+        const auto block = popScanRequest (mutex, messageThreadBlocks);
+
+        if (block.isEmpty())
+            return;
+
+        doScan (block);
+    }
+}
+
+bool ChildProcessPluginScanner::Worker::doScan (const MemoryBlock& block)
+{
+    AudioPluginFormatManager formatManager;
+    formatManager.addDefaultFormats();
+
+    MemoryInputStream stream { block, false };
+    const auto formatName = stream.readString();
+    const auto identifier = stream.readString();
+
+    PluginDescription pd;
+    pd.fileOrIdentifier = identifier;
+    pd.uniqueId = pd.deprecatedUid = 0;
+
+    const auto matchingFormat = [&]() -> AudioPluginFormat*
+    {
+        for (auto* format : formatManager.getFormats())
+            if (format->getName() == formatName)
+                return format;
+
+        return nullptr;
+    }();
+
+    if (matchingFormat != nullptr
+        && ! MessageManager::getInstance()->isThisTheMessageThread()
+        && matchingFormat->requiresUnblockedMessageThreadDuringCreation (pd))
+    {
+        return false;
+    }
+
+    OwnedArray<PluginDescription> results;
+
+    if (matchingFormat != nullptr)
+    {
+        ++numScansInProgress;
+        matchingFormat->findAllTypesForFile (results, identifier);
+        --numScansInProgress;
+    }
+
+    XmlElement xml ("LIST");
+
+    for (const auto* desc : results)
+        xml.addChildElement (desc->createXml().release());
+
+    const auto str = xml.toString();
+    sendMessageToCoordinator ({ str.toRawUTF8(), str.getNumBytesAsUTF8() });
+    return true;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ChildProcessPluginScannerTests  : public UnitTest
+{
+public:
+    ChildProcessPluginScannerTests()
+        : UnitTest ("ChildProcessPluginScanner", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        const auto neverExit = [] { return false; };
+
+        beginTest ("A worker's reply is returned when the scan succeeds");
+        {
+            PluginScanReply reply;
+            reply.reset();
+
+            PluginDescription desc;
+            desc.name = "Test Plugin";
+            desc.pluginFormatName = "VST3";
+            desc.fileOrIdentifier = "/plugins/Test.vst3";
+
+            XmlElement xml ("LIST");
+            xml.addChildElement (desc.createXml().release());
+            const auto str = xml.toString();
+
+            DelayedCall worker (100, [&] { reply.setResponse ({ str.toRawUTF8(), str.getNumBytesAsUTF8() }); });
+
+            OwnedArray<PluginDescription> result;
+            expect (reply.waitForResponse (result, 10000, neverExit) == PluginScanReply::Result::loaded);
+
+            expectEquals (result.size(), 1);
+
+            if (result.size() == 1)
+                expect (result[0]->isDuplicateOf (desc) && result[0]->name == desc.name);
+        }
+
+        beginTest ("A lost connection is reported as a crash");
+        {
+            PluginScanReply reply;
+            reply.reset();
+
+            DelayedCall worker (100, [&] { reply.setConnectionLost(); });
+
+            OwnedArray<PluginDescription> result;
+            expect (reply.waitForResponse (result, 10000, neverExit) == PluginScanReply::Result::crashed);
+
+            expect (result.isEmpty());
+
+            // Once the connection has gone, later scans can't succeed either
+            reply.reset();
+            reply.setResponse ({});
+            expect (reply.waitForResponse (result, 10000, neverExit) == PluginScanReply::Result::crashed);
+        }
+
+        beginTest ("A scan that takes longer than the timeout is reported as hung");
+        {
+            PluginScanReply reply;
+            reply.reset();
+
+            OwnedArray<PluginDescription> result;
+            const auto startTime = Time::getMillisecondCounter();
+            expect (reply.waitForResponse (result, 200, neverExit) == PluginScanReply::Result::timedOut);
+            expectGreaterOrEqual ((int) (Time::getMillisecondCounter() - startTime), 200);
+            expect (result.isEmpty());
+        }
+
+        beginTest ("A slow scan succeeds when there's no timeout");
+        {
+            PluginScanReply reply;
+            reply.reset();
+
+            DelayedCall worker (300, [&] { reply.setResponse ({ "<LIST/>", 7 }); });
+
+            OwnedArray<PluginDescription> result;
+            expect (reply.waitForResponse (result, 0, neverExit) == PluginScanReply::Result::loaded);
+        }
+
+        beginTest ("Waiting for a reply can be cancelled");
+        {
+            PluginScanReply reply;
+            reply.reset();
+
+            OwnedArray<PluginDescription> result;
+            expect (reply.waitForResponse (result, 0, [] { return true; }) == PluginScanReply::Result::cancelled);
+        }
+    }
+
+private:
+    // Stands in for a worker process, by replying from another thread after a delay
+    struct DelayedCall  : public Thread
+    {
+        DelayedCall (int delay, std::function<void()> fn)
+            : Thread ("Delayed scan reply"), delayMs (delay), callback (std::move (fn))
+        {
+            startThread();
+        }
+
+        ~DelayedCall() override     { stopThread (-1); }
+
+        void run() override
+        {
+            sleep (delayMs);
+            callback();
+        }
+
+        const int delayMs;
+        std::function<void()> callback;
+    };
+};
+
+static ChildProcessPluginScannerTests childProcessPluginScannerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A KnownPluginList::CustomScanner that scans plugins in a pool of child processes.
+
+    Each plugin is loaded by a worker process rather than by the host, so a plugin that
+    crashes during scanning will only take down its worker, and will be blacklisted
+    instead of killing your app. The scanner can run several workers at once, so if
+    you also call PluginListComponent::setNumberOfThreadsForScanning() (or scan with
+    several threads yourself), plugins will be scanned in parallel.
+
+    The results can also be kept in a persistent cache file. Entries are keyed on the
+    plugin file's path, modification time and size, so that a rescan only needs to
+    load the binaries that have changed since they were last scanned.
+
+    To use this class, your app must also act as the worker process. The workers are
+    launched by running your executable with a special command line, so in your app's
+    startup code you need to create a ChildProcessPluginScanner::Worker and check
+    whether it should take over:
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<ChildProcessPluginScanner::Worker>();
+
+        if (worker->initialiseFromCommandLine (commandLine, "myScannerUID"))
+        {
+            scannerWorker = std::move (worker);
+            return; // this instance of the app is a scanner worker, so don't create any windows
+        }
+
+        knownPluginList.setCustomScanner (std::make_unique<ChildProcessPluginScanner> (
+            File::getSpecialLocation (File::currentExecutableFile), "myScannerUID",
+            SystemStats::getNumCpus(), appDataDir.getChildFile ("PluginScanCache.xml")));
+        ...
+    }
+    @endcode
+
+    @tags{Audio}
+*/
+class JUCE_API  ChildProcessPluginScanner  : public KnownPluginList::CustomScanner
+{
+public:
+    //==============================================================================
+    /** Creates a scanner.
+
+        @param workerExecutable     the executable to launch for each worker process. This
+                                    will normally be your own app.
+        @param processUID           a short alphanumeric string which identifies your app's
+                                    worker processes. This must match the string passed to
+                                    Worker::initialiseFromCommandLine().
+        @param maxNumWorkers        the maximum number of worker processes that may run
+                                    at the same time
+        @param cacheFile            if this isn't File(), the scan results will be loaded
+                                    from and saved to this file
+    */
+    ChildProcessPluginScanner (const File& workerExecutable,
+                               const String& processUID,
+                               int maxNumWorkers,
+                               const File& cacheFile = {});
+
+    /** Destructor. */
+    ~ChildProcessPluginScanner() override;
+
+    //==============================================================================
+    /** Removes all the entries from the cache. */
+    void clearCache();
+
+    /** Writes the cache to the cache file, if it has changed. */
+    void saveCache();
+
+    //==============================================================================
+    /** Sets how long a worker may spend scanning a single plugin before it's assumed to
+        have hung.
+
+        A plugin that takes longer than this is treated as if it had crashed: its worker
+        is shut down and the plugin is blacklisted. This is independent of the pings that
+        check whether the worker process is still alive, so a plugin that's just slow to
+        load won't be blacklisted unless it exceeds this limit.
+
+        Pass 0 to wait for as long as the plugin takes. The default is 60 seconds.
+    */
+    void setScanTimeout (int milliseconds) noexcept;
+
+    //==============================================================================
+    /** @internal */
+    bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void scanFinished() override;
+
+    //==============================================================================
+    /**
+        Handles the scan requests in a worker process.
+
+        @see ChildProcessPluginScanner
+    */
+    class JUCE_API  Worker  : private ChildProcessWorker,
+                              private AsyncUpdater,
+                              private Thread
+    {
+    public:
+        /** Creates a worker. The worker uses an AudioPluginFormatManager with the
+            default formats to load the plugins.
+        */
+        Worker();
+
+        /** Destructor. */
+        ~Worker() override;
+
+        /** Call this in your app's startup code to check whether this process has been
+            launched as a scanner worker.
+
+            If it returns true, you should keep this object alive and avoid creating any
+            other UI or doing any other work. The app will be quit automatically when
+            the scanner disconnects.
+        */
+        bool initialiseFromCommandLine (const String& commandLine, const String& processUID);
+
+    private:
+        void handleMessageFromCoordinator (const MemoryBlock&) override;
+        void handleConnectionLost() override;
+        void handleAsyncUpdate() override;
+        void run() override;
+        bool doScan (const MemoryBlock&);
+
+        std::mutex mutex;
+        std::queue<MemoryBlock> incomingBlocks, messageThreadBlocks;
+        std::atomic<int> numScansInProgress { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+    };
+
+private:
+    //==============================================================================
+    class WorkerConnection;
+
+    struct CacheEntry
+    {
+        Time modificationTime;
+        int64 fileSize = 0;
+        bool crashed = false;
+        Array<PluginDescription> types;
+    };
+
+    std::unique_ptr<WorkerConnection> acquireWorker();
+    void releaseWorker (std::unique_ptr<WorkerConnection>);
+    void killAllWorkers();
+
+    static String getCacheKey (const AudioPluginFormat&, const String&);
+    bool findCachedTypes (const String& key, const File&, OwnedArray<PluginDescription>&, bool& crashed);
+    void addToCache (const String& key, const File&, const OwnedArray<PluginDescription>&, bool crashed);
+    void loadCache();
+
+    const File executable;
+    const String uid;
+    const int maxWorkers;
+    std::atomic<int> scanTimeoutMs { 60000 };
+
+    std::mutex workerMutex;
+    std::condition_variable workerAvailable;
+    std::vector<std::unique_ptr<WorkerConnection>> idleWorkers;
+    int numWorkersInUse = 0;
+
+    const File cacheFile;
+    CriticalSection cacheLock;
+    std::map<String, CacheEntry> cache;
+    bool cacheNeedsSaving = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessPluginScanner)
+};
+
+} // namespace juce
@@ -75,6 +75,62 @@ void AudioProcessorValueTreeState::Parameter::valueChanged (float newValue)
         onValueChanged();
 }
 
+//==============================================================================
+/*  Keeps track of which parameters have been modified since the last flush to the
+    state tree.
+
+    Changing parameters may happen on the audio thread, so this just sets a bit in
+    an atomic flag word. The message thread can then visit only the modified
+    parameters, rather than polling every parameter on each timer callback.
+*/
+class AudioProcessorValueTreeState::ParameterChangeSet
+{
+    using FlagType = uint32_t;
+
+public:
+    /*  All adapters must be added before any parameter changes can happen on other
+        threads, i.e. before the state tree is assigned.
+    */
+    size_t add (ParameterAdapter& adapter)
+    {
+        const auto index = adapters.size();
+
+        if (index % numFlagBits == 0)
+            flags.emplace_back (0);
+
+        adapters.push_back (&adapter);
+        return index;
+    }
+
+    void markDirty (size_t index) noexcept
+    {
+        jassert (index < adapters.size());
+        flags[index / numFlagBits].fetch_or ((FlagType) 1 << (index % numFlagBits), std::memory_order_acq_rel);
+    }
+
+    /*  Calls the supplied callback for each adapter that has been marked as dirty
+        since the last call to this function.
+    */
+    template <typename Callback>
+    void forEachDirty (Callback&& callback)
+    {
+        for (size_t flagIndex = 0; flagIndex < flags.size(); ++flagIndex)
+        {
+            auto dirty = flags[flagIndex].exchange (0, std::memory_order_acq_rel);
+
+            for (size_t bit = 0; dirty != 0; ++bit, dirty >>= 1)
+                if ((dirty & 1) != 0)
+                    callback (*adapters[(flagIndex * numFlagBits) + bit]);
+        }
+    }
+
+private:
+    static constexpr size_t numFlagBits = 8 * sizeof (FlagType);
+
+    std::vector<ParameterAdapter*> adapters;
+    std::deque<std::atomic<FlagType>> flags;
+};
+
 //==============================================================================
 class AudioProcessorValueTreeState::ParameterAdapter   : private AudioProcessorParameter::Listener
 {
@@ -126,6 +182,15 @@ public:
     float getDenormalisedValue() const                { return unnormalisedValue; }
     std::atomic<float>& getRawDenormalisedValue()     { return unnormalisedValue; }
 
+    void attachToChangeSet (ParameterChangeSet& set)
+    {
+        changeSetIndex = set.add (*this);
+        changeSet = &set;
+
+        if (needsUpdate)
+            changeSet->markDirty (changeSetIndex);
+    }
+
     bool flushToTree (const Identifier& key, UndoManager* um)
     {
         auto needsUpdateTestValue = true;
@@ -165,6 +230,9 @@ private:
         listeners.call ([this] (Listener& l) { l.parameterChanged (parameter.paramID, unnormalisedValue); });
         listenersNeedCalling = false;
         needsUpdate = true;
+
+        if (changeSet != nullptr)
+            changeSet->markDirty (changeSetIndex);
     }
 
     float denormalise (float normalised) const
@@ -217,6 +285,8 @@ private:
     std::atomic<float> unnormalisedValue { 0.0f };
     std::atomic<bool> needsUpdate { true }, listenersNeedCalling { true };
     bool ignoreParameterChangedCallbacks { false };
+    ParameterChangeSet* changeSet = nullptr;
+    size_t changeSetIndex = 0;
 };
 
 //==============================================================================
@@ -278,7 +348,7 @@ AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& proc
 }
 
 AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& p, UndoManager* um)
-    : processor (p), undoManager (um)
+    : processor (p), undoManager (um), changeSet (std::make_unique<ParameterChangeSet>())
 {
     startTimerHz (10);
     state.addListener (this);
@@ -338,7 +408,10 @@ RangedAudioParameter* AudioProcessorValueTreeState::createAndAddParameter (std::
 //==============================================================================
 void AudioProcessorValueTreeState::addParameterAdapter (RangedAudioParameter& param)
 {
-    adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+    const auto result = adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+
+    if (result.second)
+        result.first->second->attachToChangeSet (*changeSet);
 }
 
 AudioProcessorValueTreeState::ParameterAdapter* AudioProcessorValueTreeState::getParameterAdapter (StringRef paramID) const
@@ -467,12 +540,32 @@ bool AudioProcessorValueTreeState::flushParameterValuesToValueTree()
 {
     ScopedLock lock (valueTreeChanging);
 
-    bool anyUpdated = false;
+    const auto startTicks = Time::getHighResolutionTicks();
+    int numUpdated = 0;
 
-    for (auto& p : adapterTable)
-        anyUpdated |= p.second->flushToTree (valuePropertyID, undoManager);
+    changeSet->forEachDirty ([&] (ParameterAdapter& adapter)
+    {
+        if (adapter.flushToTree (valuePropertyID, undoManager))
+            ++numUpdated;
+    });
+
+    if (numUpdated == 0)
+        return false;
 
-    return anyUpdated;
+    const auto elapsedMs = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks) * 1000.0;
+
+    ++flushStatistics.numFlushes;
+    flushStatistics.numParametersInLastFlush = numUpdated;
+    flushStatistics.lastFlushMilliseconds = elapsedMs;
+    flushStatistics.maxFlushMilliseconds = jmax (flushStatistics.maxFlushMilliseconds, elapsedMs);
+
+    return true;
+}
+
+AudioProcessorValueTreeState::FlushStatistics AudioProcessorValueTreeState::getFlushStatistics() const
+{
+    ScopedLock lock (valueTreeChanging);
+    return flushStatistics;
 }
 
 void AudioProcessorValueTreeState::timerCallback()
@@ -811,6 +904,28 @@ public:
             expectEquals (proc.state.getRawParameterValue (key)->load(), value);
         }
 
+        beginTest ("Flushing the state only writes parameters that have changed");
+        {
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float>(), 0.0f),
+                                       std::make_unique<AudioParameterFloat> ("b", "", NormalisableRange<float>(), 0.0f),
+                                       std::make_unique<AudioParameterFloat> ("c", "", NormalisableRange<float>(), 0.0f) });
+
+            proc.state.copyState();
+            const auto initialFlushes = proc.state.getFlushStatistics().numFlushes;
+
+            proc.state.copyState();
+            expectEquals (proc.state.getFlushStatistics().numFlushes, initialFlushes);
+
+            proc.state.getParameter ("b")->setValueNotifyingHost (0.25f);
+            const auto valueTree = proc.state.copyState();
+
+            const auto stats = proc.state.getFlushStatistics();
+            expectEquals (stats.numFlushes, initialFlushes + 1);
+            expectEquals (stats.numParametersInLastFlush, 1);
+            expect (stats.maxFlushMilliseconds >= stats.lastFlushMilliseconds);
+            expectEquals ((float) valueTree.getChildWithProperty ("id", "b").getProperty ("value"), 0.25f);
+        }
+
         beginTest ("After adding an APVTS::Parameter, its value is the default value");
         {
             TestAudioProcessor proc;
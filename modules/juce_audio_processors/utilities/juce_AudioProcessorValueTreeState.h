@@ -346,6 +346,39 @@ public:
     */
     void replaceState (const ValueTree& newState);
 
+    //==============================================================================
+    /** Holds timing information about the flushes of audio parameter values to the
+        state ValueTree.
+
+        Parameter changes made on the audio thread only mark the changed parameters as
+        dirty, and the message thread then writes just the dirty parameters into the
+        tree in a single pass. These numbers can be used to check how long that pass
+        takes for large parameter sets.
+
+        @see getFlushStatistics
+    */
+    struct FlushStatistics
+    {
+        /** The number of flushes that have written at least one parameter to the tree. */
+        int64 numFlushes = 0;
+
+        /** The number of parameters that were written by the most recent flush. */
+        int numParametersInLastFlush = 0;
+
+        /** The time taken by the most recent flush, in milliseconds. */
+        double lastFlushMilliseconds = 0.0;
+
+        /** The longest time taken by any flush so far, in milliseconds. */
+        double maxFlushMilliseconds = 0.0;
+    };
+
+    /** Returns timing information about the flushes of parameter values to the state tree.
+
+        Note: This method uses locks to synchronise thread access, so don't call it from
+        within your audio processing code!
+    */
+    FlushStatistics getFlushStatistics() const;
+
     //==============================================================================
     /** A reference to the processor with which this state is associated. */
     AudioProcessor& processor;
@@ -365,6 +398,7 @@ public:
 private:
     //==============================================================================
     class ParameterAdapter;
+    class ParameterChangeSet;
 
 public:
     //==============================================================================
@@ -553,9 +587,11 @@ private:
         bool operator() (StringRef a, StringRef b) const noexcept { return a.text.compare (b.text) < 0; }
     };
 
+    std::unique_ptr<ParameterChangeSet> changeSet;
     std::map<StringRef, std::unique_ptr<ParameterAdapter>, StringRefLessThan> adapterTable;
 
     CriticalSection valueTreeChanging;
+    FlushStatistics flushStatistics;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorValueTreeState)
 };
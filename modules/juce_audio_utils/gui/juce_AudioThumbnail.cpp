@@ -43,6 +43,13 @@ struct AudioThumbnail::MinMaxValue
     inline int8 getMinValue() const noexcept        { return values[0]; }
     inline int8 getMaxValue() const noexcept        { return values[1]; }
 
+    static MinMaxValue merge (const MinMaxValue& a, const MinMaxValue& b) noexcept
+    {
+        MinMaxValue result;
+        result.set (jmin (a.values[0], b.values[0]), jmax (a.values[1], b.values[1]));
+        return result;
+    }
+
     inline void setFloat (Range<float> newRange) noexcept
     {
         // Workaround for an ndk armeabi compiler bug which crashes on signed saturation
@@ -88,18 +95,18 @@ class AudioThumbnail::LevelDataSource   : public TimeSliceClient
 {
 public:
     LevelDataSource (AudioThumbnail& thumb, AudioFormatReader* newReader, int64 hash)
-        : hashCode (hash), owner (thumb), reader (newReader)
+        : hashCode (hash), owner (thumb), thread (thumb.cache.getLeastBusyTimeSliceThread()), reader (newReader)
     {
     }
 
     LevelDataSource (AudioThumbnail& thumb, InputSource* src)
-        : hashCode (src->hashCode()), owner (thumb), source (src)
+        : hashCode (src->hashCode()), owner (thumb), thread (thumb.cache.getLeastBusyTimeSliceThread()), source (src)
     {
     }
 
     ~LevelDataSource() override
     {
-        owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
+        thread.removeTimeSliceClient (this);
     }
 
     enum { timeBeforeDeletingReader = 3000 };
@@ -121,7 +128,7 @@ public:
             if (lengthInSamples <= 0 || isFullyLoaded())
                 reader.reset();
             else
-                owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+                thread.addTimeSliceClient (this);
         }
     }
 
@@ -136,7 +143,7 @@ public:
             if (reader != nullptr)
             {
                 lastReaderUseTime = Time::getMillisecondCounter();
-                owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+                thread.addTimeSliceClient (this);
             }
         }
 
@@ -155,6 +162,18 @@ public:
     {
         const ScopedLock sl (readerLock);
         reader.reset();
+        readBuffer.setSize (0, 0);
+    }
+
+    /** Called when the thumbnail is drawn, so that it gets priority while it's still loading. */
+    void markAsVisible()
+    {
+        if (! isFullyLoaded())
+        {
+            lastVisibleTime = Time::getMillisecondCounter();
+            owner.cache.notifyVisibleThumbnailIsLoading (thread);
+            thread.moveToFrontOfQueue (this);
+        }
     }
 
     int useTimeSlice() override
@@ -172,6 +191,10 @@ public:
             return -1;
         }
 
+        // give way to any thumbnails on this thread that are being drawn
+        if (! isVisible() && owner.cache.isVisibleThumbnailLoading (thread))
+            return 20;
+
         bool justFinished = false;
 
         {
@@ -210,10 +233,18 @@ public:
 
 private:
     AudioThumbnail& owner;
+    TimeSliceThread& thread;
     std::unique_ptr<InputSource> source;
     std::unique_ptr<AudioFormatReader> reader;
+    AudioBuffer<float> readBuffer;
     CriticalSection readerLock;
-    std::atomic<uint32> lastReaderUseTime { 0 };
+    std::atomic<uint32> lastReaderUseTime { 0 }, lastVisibleTime { 0 };
+
+    bool isVisible() const noexcept
+    {
+        auto lastTime = lastVisibleTime.load();
+        return lastTime != 0 && Time::getMillisecondCounter() - lastTime < 500;
+    }
 
     void createReader()
     {
@@ -244,15 +275,44 @@ private:
                 for (int i = 0; i < (int) numChannels; ++i)
                     levels[i] = levelData + i * numThumbSamps;
 
-                HeapBlock<Range<float>> levelsRead (numChannels);
+                if (dynamic_cast<MemoryMappedAudioFormatReader*> (reader.get()) != nullptr)
+                {
+                    // A mapped reader can find the levels directly from the file's data
+                    HeapBlock<Range<float>> levelsRead (numChannels);
 
-                for (int i = 0; i < numThumbSamps; ++i)
+                    for (int i = 0; i < numThumbSamps; ++i)
+                    {
+                        reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
+                                               owner.samplesPerThumbSample, levelsRead, (int) numChannels);
+
+                        for (int j = 0; j < (int) numChannels; ++j)
+                            levels[j][i].setFloat (levelsRead[j]);
+                    }
+                }
+                else
                 {
-                    reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
-                                           owner.samplesPerThumbSample, levelsRead, (int) numChannels);
+                    // Otherwise, decode the whole block in one go rather than making a separate
+                    // readMaxLevels() call (and allocation) for every thumbnail sample
+                    auto firstSample = firstThumbIndex * (int64) owner.samplesPerThumbSample;
+                    auto numSamplesToRead = (int) jmin ((int64) numThumbSamps * owner.samplesPerThumbSample,
+                                                        lengthInSamples - firstSample);
+
+                    readBuffer.setSize ((int) numChannels, numSamplesToRead, false, false, true);
+                    reader->read (&readBuffer, 0, numSamplesToRead, firstSample, true, true);
 
                     for (int j = 0; j < (int) numChannels; ++j)
-                        levels[j][i].setFloat (levelsRead[j]);
+                    {
+                        auto* channelData = readBuffer.getReadPointer (j);
+
+                        for (int i = 0; i < numThumbSamps; ++i)
+                        {
+                            auto start = i * owner.samplesPerThumbSample;
+                            auto num = jmin (owner.samplesPerThumbSample, numSamplesToRead - start);
+
+                            levels[j][i].setFloat (num > 0 ? FloatVectorOperations::findMinAndMax (channelData + start, num)
+                                                           : Range<float>());
+                        }
+                    }
                 }
 
                 {
@@ -270,6 +330,13 @@ private:
 };
 
 //==============================================================================
+/*  Holds the level data for one channel, along with a pyramid of coarser levels where
+    each entry covers two entries of the level below. This lets getMinMax() find the
+    extremes of any range by combining O (log n) entries, so drawing a zoomed-out view
+    costs the same however much audio each pixel covers. Writes only update the parts
+    of the pyramid above the entries that changed, so it's cheap to keep it up to date
+    while recording.
+*/
 class AudioThumbnail::ThumbData
 {
 public:
@@ -295,22 +362,30 @@ public:
         {
             endSample = jmin (endSample, data.size() - 1);
 
-            int8 mx = -128;
-            int8 mn = 127;
-
-            while (startSample <= endSample)
+            if (startSample <= endSample)
             {
-                auto& v = data.getReference (startSample);
+                MinMaxValue total;
+                total.set (127, -128);
 
-                if (v.getMinValue() < mn)  mn = v.getMinValue();
-                if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+                auto start = startSample;
+                auto end = endSample + 1;
+                auto* level = data.begin();
 
-                ++startSample;
-            }
+                for (size_t levelIndex = 0;; ++levelIndex)
+                {
+                    if ((start & 1) != 0)   total = MinMaxValue::merge (total, level[start++]);
+                    if ((end & 1) != 0)     total = MinMaxValue::merge (total, level[--end]);
 
-            if (mn <= mx)
-            {
-                result.set (mn, mx);
+                    start >>= 1;
+                    end >>= 1;
+
+                    if (start >= end || levelIndex >= pyramid.size())
+                        break;
+
+                    level = pyramid[levelIndex].data();
+                }
+
+                result = total;
                 return;
             }
         }
@@ -320,8 +395,6 @@ public:
 
     void write (const MinMaxValue* values, int startIndex, int numValues)
     {
-        resetPeak();
-
         if (startIndex + numValues > data.size())
             ensureSize (startIndex + numValues);
 
@@ -329,39 +402,81 @@ public:
 
         for (int i = 0; i < numValues; ++i)
             dest[i] = values[i];
+
+        updatePyramid (startIndex, startIndex + numValues);
     }
 
-    void resetPeak() noexcept
+    /** Must be called after writing to the level data directly with getData(). */
+    void rebuildPyramid()
     {
-        peakLevel = -1;
+        updatePyramid (0, data.size());
     }
 
-    int getPeak() noexcept
+    int getPeak() const noexcept
     {
-        if (peakLevel < 0)
+        // The top of the pyramid covers everything, and the largest absolute value in a set
+        // of ranges must be at one end of their union
+        if (pyramid.empty())
         {
+            int peak = 0;
+
             for (auto& s : data)
-            {
-                auto peak = s.getPeak();
+                peak = jmax (peak, s.getPeak());
 
-                if (peak > peakLevel)
-                    peakLevel = peak;
-            }
+            return peak;
         }
 
-        return peakLevel;
+        return pyramid.back().front().getPeak();
     }
 
 private:
     Array<MinMaxValue> data;
-    int peakLevel = -1;
+    std::vector<std::vector<MinMaxValue>> pyramid;
 
     void ensureSize (int thumbSamples)
     {
-        auto extraNeeded = thumbSamples - data.size();
+        auto oldSize = data.size();
+        auto extraNeeded = thumbSamples - oldSize;
 
         if (extraNeeded > 0)
+        {
             data.insertMultiple (-1, MinMaxValue(), extraNeeded);
+
+            for (auto levelSize = (size_t) thumbSamples, levelIndex = (size_t) 0; levelSize > 1; ++levelIndex)
+            {
+                levelSize = (levelSize + 1) / 2;
+
+                if (levelIndex >= pyramid.size())
+                    pyramid.emplace_back();
+
+                pyramid[levelIndex].resize (levelSize);
+            }
+
+            // the last entry of each level may have gained a new child
+            updatePyramid (jmax (0, oldSize - 1), thumbSamples);
+        }
+    }
+
+    void updatePyramid (int start, int end)
+    {
+        auto* below = data.begin();
+        auto belowSize = (size_t) data.size();
+
+        for (auto& level : pyramid)
+        {
+            start /= 2;
+            end = (end + 1) / 2;
+
+            for (auto i = (size_t) start; i < (size_t) end; ++i)
+            {
+                auto child = i * 2;
+                level[i] = child + 1 < belowSize ? MinMaxValue::merge (below[child], below[child + 1])
+                                                 : below[child];
+            }
+
+            below = level.data();
+            belowSize = level.size();
+        }
     }
 };
 
@@ -614,6 +729,9 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
         for (int chan = 0; chan < numChannels; ++chan)
             channels.getUnchecked(chan)->getData(i)->read (input);
 
+    for (auto* channel : channels)
+        channel->rebuildPyramid();
+
     return true;
 }
 
@@ -811,6 +929,9 @@ void AudioThumbnail::drawChannel (Graphics& g, const Rectangle<int>& area, doubl
 {
     const ScopedLock sl (lock);
 
+    if (source != nullptr)
+        source->markAsVisible();
+
     window->drawChannel (g, area, startTime, endTime, channelNum, verticalZoomFactor,
                          sampleRate, numChannels, samplesPerThumbSample, source.get(), channels);
 }
@@ -828,4 +949,233 @@ void AudioThumbnail::drawChannels (Graphics& g, const Rectangle<int>& area, doub
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioThumbnailTests  : public UnitTest
+{
+public:
+    AudioThumbnailTests()
+        : UnitTest ("AudioThumbnail", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Min and max levels of arbitrary ranges match the source data");
+        {
+            constexpr int samplesPerThumbSample = 16;
+            constexpr int numSamples = 100000;
+
+            AudioFormatManager formatManager;
+            AudioThumbnailCache cache (1);
+            AudioThumbnail thumbnail (samplesPerThumbSample, formatManager, cache);
+
+            auto random = getRandom();
+            AudioBuffer<float> buffer (1, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (0, i, (random.nextFloat() * 2.0f - 1.0f) * (float) std::sin (i * 0.0001));
+
+            thumbnail.reset (1, 1000.0, numSamples);
+
+            // add the data in uneven blocks, as a recording would
+            for (int start = 0; start < numSamples;)
+            {
+                auto num = jmin (numSamples - start, samplesPerThumbSample * (1 + random.nextInt (300)));
+                thumbnail.addBlock (start, buffer, start, num);
+                start += num;
+            }
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto firstThumbSample = random.nextInt (numSamples / samplesPerThumbSample);
+                auto numThumbSamples = 1 + random.nextInt (numSamples / samplesPerThumbSample - firstThumbSample);
+
+                auto startSample = firstThumbSample * samplesPerThumbSample;
+                auto numSamplesInRange = jmin (numSamples - startSample, numThumbSamples * samplesPerThumbSample);
+                auto expected = FloatVectorOperations::findMinAndMax (buffer.getReadPointer (0, startSample), numSamplesInRange);
+
+                // getApproximateMinMax() rounds the end time up to a whole thumbnail sample and
+                // includes that sample, so the end time passed is the start of the last thumbnail
+                // sample in the range (both times are nudged in by half a sample to avoid rounding
+                // errors pulling in the neighbouring thumbnail samples)
+                auto lastThumbStart = startSample + numSamplesInRange - samplesPerThumbSample;
+
+                float minValue, maxValue;
+                thumbnail.getApproximateMinMax ((startSample + 0.5) / 1000.0, (lastThumbStart + 0.5) / 1000.0,
+                                                0, minValue, maxValue);
+
+                expectWithinAbsoluteError (minValue, expected.getStart(), 0.02f);
+                expectWithinAbsoluteError (maxValue, expected.getEnd(), 0.02f);
+            }
+
+            expectWithinAbsoluteError (thumbnail.getApproximatePeak(), buffer.getMagnitude (0, numSamples), 0.02f);
+        }
+
+        beginTest ("New thumbnails are spread across the cache's scanning threads");
+        {
+            constexpr int numThreads = 3, numThumbnails = 6;
+
+            AudioFormatManager formatManager;
+            AudioThumbnailCache cache (numThumbnails, numThreads);
+            WaitableEvent gate (true);
+
+            OwnedArray<AudioThumbnail> thumbnails;
+            Array<TimeSliceThread*> threadsUsed;
+
+            for (int i = 0; i < numThumbnails; ++i)
+            {
+                threadsUsed.add (&cache.getLeastBusyTimeSliceThread());
+                thumbnails.add (new AudioThumbnail (16, formatManager, cache))
+                    ->setReader (new TestReader (100000, (float) (i + 1) / numThumbnails, &gate), 1000 + i);
+            }
+
+            for (int i = 0; i < numThreads; ++i)
+            {
+                // each thread gets one thumbnail before any of them gets a second
+                expect (threadsUsed[i] == threadsUsed[i + numThreads]);
+                expect (threadsUsed.indexOf (threadsUsed[i]) == i);
+                expectEquals (threadsUsed[i]->getNumClients(), numThumbnails / numThreads);
+            }
+
+            gate.signal();
+
+            for (int i = 0; i < numThumbnails; ++i)
+            {
+                expect (waitUntilLoaded (*thumbnails[i]));
+                expectWithinAbsoluteError (thumbnails[i]->getApproximatePeak(), (float) (i + 1) / numThumbnails, 0.02f);
+            }
+        }
+
+        beginTest ("Drawing a thumbnail that's still loading only affects its own thread");
+        {
+            AudioFormatManager formatManager;
+            AudioThumbnailCache cache (2, 2);
+            WaitableEvent gate (true);
+
+            auto& firstThread = cache.getLeastBusyTimeSliceThread();
+            AudioThumbnail first (16, formatManager, cache);
+            first.setReader (new TestReader (100000, 0.5f, &gate), 1);
+
+            auto& secondThread = cache.getLeastBusyTimeSliceThread();
+            AudioThumbnail second (16, formatManager, cache);
+            second.setReader (new TestReader (100000, 0.5f, &gate), 2);
+
+            expect (&firstThread != &secondThread);
+            expect (! cache.isVisibleThumbnailLoading (firstThread));
+
+            draw (first);
+
+            expect (cache.isVisibleThumbnailLoading (firstThread));
+            expect (! cache.isVisibleThumbnailLoading (secondThread));
+
+            // the priority lapses if the thumbnail stops being drawn
+            Thread::sleep (600);
+            expect (! cache.isVisibleThumbnailLoading (firstThread));
+
+            gate.signal();
+            expect (waitUntilLoaded (first) && waitUntilLoaded (second));
+
+            // once it's loaded, drawing it doesn't hold anything else up
+            draw (first);
+            expect (! cache.isVisibleThumbnailLoading (firstThread));
+        }
+
+        beginTest ("A thumbnail that's being drawn is loaded before others on the same thread");
+        {
+            AudioFormatManager formatManager;
+            AudioThumbnailCache cache (2, 1);
+
+            // each block of 256 thumbnail samples takes at least 5ms to read, so each thumbnail takes 200ms or more
+            constexpr int64 length = 256 * 16 * 40;
+
+            AudioThumbnail hidden (16, formatManager, cache);
+            hidden.setReader (new TestReader (length, 0.5f, nullptr, 5), 1);
+
+            AudioThumbnail visible (16, formatManager, cache);
+            visible.setReader (new TestReader (length, 0.5f, nullptr, 5), 2);
+
+            const auto timeout = Time::getMillisecondCounter() + 10000;
+
+            while (! visible.isFullyLoaded() && Time::getMillisecondCounter() < timeout)
+            {
+                draw (visible);
+                Thread::sleep (10);
+            }
+
+            expect (visible.isFullyLoaded());
+            expect (! hidden.isFullyLoaded());
+
+            expect (waitUntilLoaded (hidden));
+        }
+    }
+
+private:
+    // Produces a square wave with a fixed peak level, optionally waiting for a gate to open
+    // or sleeping before each read, to simulate a file that's slow to decode
+    class TestReader  : public AudioFormatReader
+    {
+    public:
+        TestReader (int64 length, float peakLevel, WaitableEvent* gateToWaitFor = nullptr, int delayPerReadMs = 0)
+            : AudioFormatReader (nullptr, "Test"),
+              level (peakLevel), gate (gateToWaitFor), delayMs (delayPerReadMs)
+        {
+            sampleRate = 1000.0;
+            bitsPerSample = 32;
+            lengthInSamples = length;
+            numChannels = 1;
+            usesFloatingPointData = true;
+        }
+
+        bool readSamples (int** destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            if (gate != nullptr)
+                gate->wait();
+
+            if (delayMs > 0)
+                Thread::sleep (delayMs);
+
+            for (int chan = 0; chan < numDestChannels; ++chan)
+                if (auto* dest = reinterpret_cast<float*> (destChannels[chan]))
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = ((startSampleInFile + i) & 1) != 0 ? level : -level;
+
+            return true;
+        }
+
+    private:
+        const float level;
+        WaitableEvent* const gate;
+        const int delayMs;
+    };
+
+    static void draw (AudioThumbnail& thumbnail)
+    {
+        Image image (Image::RGB, 100, 20, true);
+        Graphics g (image);
+        thumbnail.drawChannel (g, image.getBounds(), 0.0, thumbnail.getTotalLength(), 0, 1.0f);
+    }
+
+    static bool waitUntilLoaded (const AudioThumbnail& thumbnail)
+    {
+        const auto timeout = Time::getMillisecondCounter() + 10000;
+
+        while (! thumbnail.isFullyLoaded())
+        {
+            if (Time::getMillisecondCounter() > timeout)
+                return false;
+
+            Thread::sleep (5);
+        }
+
+        return true;
+    }
+};
+
+static AudioThumbnailTests audioThumbnailTests;
+
+#endif
+
 } // namespace juce
@@ -59,18 +59,65 @@ private:
 };
 
 //==============================================================================
-AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs)
-    : thread ("thumb cache"),
-      maxNumThumbsToStore (maxNumThumbs)
+class AudioThumbnailCache::ScanningThread  : public TimeSliceThread
+{
+public:
+    ScanningThread()  : TimeSliceThread ("thumb cache") {}
+
+    std::atomic<uint32> lastVisibleLoadingTime { 0 };
+
+    enum { visiblePriorityTimeoutMs = 500 };
+};
+
+//==============================================================================
+AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs, const int numScanningThreads)
+    : maxNumThumbsToStore (maxNumThumbs)
 {
     jassert (maxNumThumbsToStore > 0);
-    thread.startThread (2);
+
+    for (int i = jmax (1, numScanningThreads); --i >= 0;)
+        threads.add (new ScanningThread())->startThread (2);
 }
 
 AudioThumbnailCache::~AudioThumbnailCache()
 {
 }
 
+TimeSliceThread& AudioThumbnailCache::getTimeSliceThread() noexcept
+{
+    return *threads.getUnchecked (0);
+}
+
+TimeSliceThread& AudioThumbnailCache::getLeastBusyTimeSliceThread() noexcept
+{
+    auto* best = threads.getUnchecked (0);
+
+    for (auto* t : threads)
+        if (t->getNumClients() < best->getNumClients())
+            best = t;
+
+    return *best;
+}
+
+void AudioThumbnailCache::notifyVisibleThumbnailIsLoading (TimeSliceThread& thread) noexcept
+{
+    for (auto* t : threads)
+        if (t == &thread)
+            t->lastVisibleLoadingTime = Time::getMillisecondCounter();
+}
+
+bool AudioThumbnailCache::isVisibleThumbnailLoading (TimeSliceThread& thread) const noexcept
+{
+    for (auto* t : threads)
+        if (t == &thread)
+        {
+            auto lastTime = t->lastVisibleLoadingTime.load();
+            return lastTime != 0 && Time::getMillisecondCounter() - lastTime < (uint32) ScanningThread::visiblePriorityTimeoutMs;
+        }
+
+    return false;
+}
+
 AudioThumbnailCache::ThumbnailCacheEntry* AudioThumbnailCache::findThumbFor (const int64 hash) const
 {
     for (int i = thumbs.size(); --i >= 0;)
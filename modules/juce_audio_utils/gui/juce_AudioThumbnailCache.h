@@ -30,10 +30,14 @@ namespace juce
 /**
     An instance of this class is used to manage multiple AudioThumbnail objects.
 
-    The cache runs a single background thread that is shared by all the thumbnails
-    that need it, and it maintains a set of low-res previews in memory, to avoid
+    The cache runs one or more background threads that are shared by all the thumbnails
+    that need them, and it maintains a set of low-res previews in memory, to avoid
     having to re-scan audio files too often.
 
+    When a thumbnail that is still being scanned is drawn, other thumbnails scanning
+    on the same thread give way to it, so the files that are on screen are finished
+    first.
+
     @see AudioThumbnail
 
     @tags{Audio}
@@ -46,8 +50,11 @@ public:
 
         The maxNumThumbsToStore parameter lets you specify how many previews should
         be kept in memory at once.
+
+        New thumbnails are spread across numScanningThreads background threads, so
+        using more than one lets the files in a large session be scanned in parallel.
     */
-    explicit AudioThumbnailCache (int maxNumThumbsToStore);
+    explicit AudioThumbnailCache (int maxNumThumbsToStore, int numScanningThreads = 1);
 
     /** Destructor. */
     virtual ~AudioThumbnailCache();
@@ -87,7 +94,21 @@ public:
     void writeToStream (OutputStream& stream);
 
     /** Returns the thread that client thumbnails can use. */
-    TimeSliceThread& getTimeSliceThread() noexcept      { return thread; }
+    TimeSliceThread& getTimeSliceThread() noexcept;
+
+    /** Returns whichever of the cache's scanning threads currently has the fewest clients. */
+    TimeSliceThread& getLeastBusyTimeSliceThread() noexcept;
+
+    /** Tells the cache that a thumbnail which is being scanned on the given thread is on screen.
+
+        For the next half a second, isVisibleThumbnailLoading() will return true for that thread.
+        This is called automatically by the AudioThumbnail class, so you shouldn't normally need
+        to call it directly.
+    */
+    void notifyVisibleThumbnailIsLoading (TimeSliceThread&) noexcept;
+
+    /** Returns true if a thumbnail being scanned on the given thread has been drawn recently. */
+    bool isVisibleThumbnailLoading (TimeSliceThread&) const noexcept;
 
 protected:
     /** This can be overridden to provide a custom callback for saving thumbnails
@@ -102,7 +123,8 @@ protected:
 
 private:
     //==============================================================================
-    TimeSliceThread thread;
+    class ScanningThread;
+    OwnedArray<ScanningThread> threads;
 
     class ThumbnailCacheEntry;
     OwnedArray<ThumbnailCacheEntry> thumbs;
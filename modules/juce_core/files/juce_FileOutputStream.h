@@ -96,6 +96,21 @@ public:
     */
     Result truncate();
 
+    /** Asks the operating system to reserve enough disk space for the file to grow
+        to the given total length.
+
+        If you know roughly how much data you're going to write, reserving the space up
+        front lets the filesystem allocate it in one go, which avoids fragmenting the disk
+        when writing long files a bit at a time. The file's length isn't changed by this
+        call on most systems, but some filesystems will extend the file to cover the space,
+        so if you write less than this you may want to truncate() the file when you've
+        finished.
+
+        If the OS or filesystem can't do this, it'll return a failure, but the stream can
+        still be used as normal.
+    */
+    Result preallocate (int64 totalLength);
+
     //==============================================================================
     void flush() override;
     int64 getPosition() override;
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class JSONBenchmark  : public Benchmark
+{
+public:
+    JSONBenchmark()
+        : Benchmark ("JSON", UnitTestCategories::json)
+    {}
+
+    void runBenchmark() override
+    {
+        const auto document = createDocument (500);
+        const auto compactText = JSON::toString (document, true);
+        const auto formattedText = JSON::toString (document, false);
+
+        const auto compactSize = (int64) compactText.getNumBytesAsUTF8();
+        const auto formattedSize = (int64) formattedText.getNumBytesAsUTF8();
+
+        measure ("parse compact", [&]
+        {
+            doNotOptimise (JSON::parse (compactText));
+        }, compactSize);
+
+        measure ("parse formatted", [&]
+        {
+            doNotOptimise (JSON::parse (formattedText));
+        }, formattedSize);
+
+        measure ("toString compact", [&]
+        {
+            doNotOptimise (JSON::toString (document, true));
+        }, compactSize);
+
+        measure ("toString formatted", [&]
+        {
+            doNotOptimise (JSON::toString (document, false));
+        }, formattedSize);
+
+        measure ("writeToStream", [&]
+        {
+            MemoryOutputStream out;
+            JSON::writeToStream (out, document, true);
+            doNotOptimise (out.getDataSize());
+        }, compactSize);
+    }
+
+    // An array of records with the kinds of values that a typical settings or
+    // preset file contains.
+    static var createDocument (int numRecords)
+    {
+        Random random (1);
+        Array<var> records;
+
+        for (int i = 0; i < numRecords; ++i)
+        {
+            DynamicObject::Ptr record (new DynamicObject());
+            record->setProperty ("id", i);
+            record->setProperty ("name", "Record \"" + String (i) + "\"\t\\");
+            record->setProperty ("value", random.nextDouble() * 1000.0);
+            record->setProperty ("enabled", random.nextBool());
+
+            Array<var> values;
+
+            for (int j = 0; j < 8; ++j)
+                values.add (random.nextInt (10000));
+
+            record->setProperty ("values", values);
+
+            DynamicObject::Ptr nested (new DynamicObject());
+            nested->setProperty ("path", "/presets/bank" + String (i % 16) + "/preset" + String (i));
+            nested->setProperty ("gain", random.nextFloat());
+            record->setProperty ("nested", var (nested.get()));
+
+            records.add (var (record.get()));
+        }
+
+        return records;
+    }
+};
+
+static JSONBenchmark jsonBenchmark;
+
+} // namespace juce
@@ -179,7 +179,9 @@
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
+#include "time/juce_Tracer.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
+#include "unit_tests/juce_Benchmark.cpp"
 #include "containers/juce_Variant.cpp"
 #include "javascript/juce_JSON.cpp"
 #include "javascript/juce_Javascript.cpp"
@@ -263,6 +265,10 @@
  #include "containers/juce_HashMap_test.cpp"
 #endif
 
+#if JUCE_BENCHMARKS
+ #include "javascript/juce_JSON_benchmark.cpp"
+#endif
+
 //==============================================================================
 namespace juce
 {
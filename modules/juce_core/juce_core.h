@@ -186,6 +186,15 @@
  #define JUCE_ENABLE_ALLOCATION_HOOKS 0
 #endif
 
+/** Config: JUCE_ENABLE_TRACING
+    If enabled, the framework records spans for message dispatch, ThreadPool jobs, Timer
+    callbacks, component painting and audio device callbacks, which can be captured with
+    the Tracer class. Nothing is recorded until Tracer::setEnabled() is called.
+*/
+#ifndef JUCE_ENABLE_TRACING
+ #define JUCE_ENABLE_TRACING 0
+#endif
+
 #ifndef JUCE_STRING_UTF_TYPE
  #define JUCE_STRING_UTF_TYPE 8
 #endif
@@ -312,12 +321,12 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "misc/juce_WindowsRegistry.h"
 #include "threads/juce_ChildProcess.h"
 #include "threads/juce_DynamicLibrary.h"
-#include "threads/juce_HighResolutionTimer.h"
 #include "threads/juce_InterProcessLock.h"
 #include "threads/juce_Process.h"
 #include "threads/juce_SpinLock.h"
 #include "threads/juce_WaitableEvent.h"
 #include "threads/juce_Thread.h"
+#include "threads/juce_HighResolutionTimer.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
 #include "threads/juce_TimeSliceThread.h"
@@ -332,7 +341,9 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "network/juce_WebInputStream.h"
 #include "streams/juce_URLInputSource.h"
 #include "time/juce_PerformanceCounter.h"
+#include "time/juce_Tracer.h"
 #include "unit_tests/juce_UnitTest.h"
+#include "unit_tests/juce_Benchmark.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
@@ -356,7 +367,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
  #include "native/juce_android_JNIHelpers.h"
 #endif
 
-#if JUCE_UNIT_TESTS
+#if JUCE_UNIT_TESTS || JUCE_BENCHMARKS
  #include "unit_tests/juce_UnitTestCategories.h"
 #endif
 
@@ -540,6 +540,41 @@ Result FileOutputStream::truncate()
     return getResultForReturnValue (ftruncate (getFD (fileHandle), (off_t) currentPosition));
 }
 
+Result FileOutputStream::preallocate (int64 totalLength)
+{
+    if (fileHandle == nullptr)
+        return status;
+
+    auto fd = getFD (fileHandle);
+
+   #if JUCE_LINUX
+    return getResultForReturnValue (fallocate (fd, FALLOC_FL_KEEP_SIZE, 0, (off_t) totalLength));
+   #elif JUCE_BSD
+    auto error = posix_fallocate (fd, 0, (off_t) totalLength);
+    return error == 0 ? Result::ok() : Result::fail (String (strerror (error)));
+   #elif JUCE_MAC || JUCE_IOS
+    juce_statStruct info;
+
+    if (fstat (fd, &info) != 0)
+        return getResultForErrno();
+
+    if (totalLength <= (int64) info.st_size)
+        return Result::ok();
+
+    // try for a contiguous block first, and fall back to any blocks that are free
+    fstore_t store { F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, (off_t) (totalLength - (int64) info.st_size), 0 };
+
+    if (fcntl (fd, F_PREALLOCATE, &store) != -1)
+        return Result::ok();
+
+    store.fst_flags = F_ALLOCATEALL;
+    return getResultForReturnValue (fcntl (fd, F_PREALLOCATE, &store));
+   #else
+    ignoreUnused (fd, totalLength);
+    return Result::fail ("Preallocation isn't supported on this platform");
+   #endif
+}
+
 //==============================================================================
 String SystemStats::getEnvironmentVariable (const String& name, const String& defaultValue)
 {
@@ -1042,6 +1077,114 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (uint32 affinityMask)
    #endif
 }
 
+//==============================================================================
+#if JUCE_LINUX && defined (SYS_sched_setattr)
+static bool setCurrentThreadDeadlineScheduling (const Thread::RealtimeOptions& options)
+{
+    // glibc doesn't wrap sched_setattr, so this mirrors the kernel's struct sched_attr
+    struct SchedAttr
+    {
+        uint32 size, policy;
+        uint64 flags;
+        int32 nice;
+        uint32 priority;
+        uint64 runtime, deadline, period;
+    };
+
+    if (options.budgetMs <= 0 || options.periodMs < options.budgetMs)
+    {
+        jassertfalse; // the deadline policy needs a budget that fits inside the period
+        return false;
+    }
+
+    auto toNanoseconds = [] (double ms) { return (uint64) (ms * 1.0e6); };
+
+    SchedAttr attr {};
+    attr.size     = (uint32) sizeof (attr);
+    attr.policy   = 6; // SCHED_DEADLINE
+    attr.runtime  = toNanoseconds (options.budgetMs);
+    attr.period   = toNanoseconds (options.periodMs);
+    attr.deadline = toNanoseconds (options.deadlineMs > 0 ? jlimit (options.budgetMs, options.periodMs, options.deadlineMs)
+                                                          : options.periodMs);
+
+    return syscall (SYS_sched_setattr, 0, &attr, 0) == 0;
+}
+#endif
+
+#if JUCE_MAC || JUCE_IOS
+static bool setCurrentThreadTimeConstraint (double periodMs, double budgetMs)
+{
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info (&timebase);
+
+    const auto ticksPerMs = ((double) timebase.denom * 1000000.0) / (double) timebase.numer;
+    const auto toTicks = [ticksPerMs] (double ms) { return (uint32_t) jmin ((double) std::numeric_limits<uint32_t>::max(), ms * ticksPerMs); };
+
+    thread_time_constraint_policy_data_t policy;
+    policy.period      = toTicks (periodMs);
+    policy.computation = jmin (budgetMs > 0 ? toTicks (budgetMs) : (uint32_t) 50000, policy.period);
+    policy.constraint  = policy.period;
+    policy.preemptible = true;
+
+    return thread_policy_set (pthread_mach_thread_np (pthread_self()),
+                              THREAD_TIME_CONSTRAINT_POLICY,
+                              (thread_policy_t) &policy,
+                              THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
+}
+#endif
+
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtime (const RealtimeOptions& options)
+{
+    bool ok = true;
+
+    if (options.affinityMask != 0)
+    {
+       #if SUPPORT_AFFINITIES && (JUCE_LINUX || JUCE_ANDROID)
+        cpu_set_t affinity;
+        CPU_ZERO (&affinity);
+
+        for (int i = 0; i < 64; ++i)
+            if ((options.affinityMask & ((uint64) 1 << i)) != 0)
+                CPU_SET ((size_t) i, &affinity);
+
+        #if JUCE_ANDROID
+         ok = sched_setaffinity (gettid(), sizeof (cpu_set_t), &affinity) == 0;
+        #else
+         ok = pthread_setaffinity_np (pthread_self(), sizeof (cpu_set_t), &affinity) == 0;
+        #endif
+       #else
+        ok = false;
+       #endif
+    }
+
+    if (options.lockMemory)
+        ok = (mlockall (MCL_CURRENT | MCL_FUTURE) == 0) && ok;
+
+    if (options.policy == RealtimeOptions::Policy::deadline)
+    {
+       #if JUCE_LINUX && defined (SYS_sched_setattr)
+        return setCurrentThreadDeadlineScheduling (options) && ok;
+       #else
+        return false;
+       #endif
+    }
+
+   #if JUCE_MAC || JUCE_IOS
+    if (options.periodMs > 0)
+        return setCurrentThreadTimeConstraint (options.periodMs, options.budgetMs) && ok;
+   #endif
+
+    const auto policy = options.policy == RealtimeOptions::Policy::fifo ? SCHED_FIFO : SCHED_RR;
+    const auto minPriority = sched_get_priority_min (policy);
+    const auto maxPriority = sched_get_priority_max (policy);
+
+    struct sched_param param;
+    param.sched_priority = options.priority > 0 ? jlimit (minPriority, maxPriority, options.priority)
+                                                : maxPriority;
+
+    return pthread_setschedparam (pthread_self(), policy, &param) == 0 && ok;
+}
+
 //==============================================================================
 #if ! JUCE_WASM
 bool DynamicLibrary::open (const String& name)
@@ -1284,9 +1427,10 @@ struct HighResolutionTimer::Pimpl
 
         periodMs = newPeriod;
 
-        thread = std::thread ([this, newPeriod]
+        // (the options are copied here, so the timer thread never reads the owner's copy)
+        thread = std::thread ([this, options = owner.getRealtimeOptions (newPeriod)]
         {
-            setThisThreadToRealtime ((uint64) newPeriod);
+            Thread::setCurrentThreadRealtime (options);
 
             auto lastPeriod = periodMs.load();
             Clock clock (lastPeriod);
@@ -1364,36 +1508,6 @@ private:
         std::chrono::steady_clock::duration delta;
     };
 
-    static bool setThisThreadToRealtime (uint64 periodMs)
-    {
-        const auto thread = pthread_self();
-
-       #if JUCE_MAC || JUCE_IOS
-        mach_timebase_info_data_t timebase;
-        mach_timebase_info (&timebase);
-
-        const auto ticksPerMs = ((double) timebase.denom * 1000000.0) / (double) timebase.numer;
-        const auto periodTicks = (uint32_t) jmin ((double) std::numeric_limits<uint32_t>::max(), periodMs * ticksPerMs);
-
-        thread_time_constraint_policy_data_t policy;
-        policy.period      = periodTicks;
-        policy.computation = jmin ((uint32_t) 50000, policy.period);
-        policy.constraint  = policy.period;
-        policy.preemptible = true;
-
-        return thread_policy_set (pthread_mach_thread_np (thread),
-                                  THREAD_TIME_CONSTRAINT_POLICY,
-                                  (thread_policy_t) &policy,
-                                  THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
-
-       #else
-        ignoreUnused (periodMs);
-        struct sched_param param;
-        param.sched_priority = sched_get_priority_max (SCHED_RR);
-        return pthread_setschedparam (thread, SCHED_RR, &param) == 0;
-       #endif
-    }
-
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
 
@@ -385,6 +385,19 @@ Result FileOutputStream::truncate()
                                               : WindowsFileHelpers::getResultForLastError();
 }
 
+Result FileOutputStream::preallocate (int64 totalLength)
+{
+    if (fileHandle == nullptr)
+        return status;
+
+    FILE_ALLOCATION_INFO info;
+    info.AllocationSize.QuadPart = totalLength;
+
+    return SetFileInformationByHandle ((HANDLE) fileHandle, FileAllocationInfo, &info, sizeof (info))
+               ? Result::ok()
+               : WindowsFileHelpers::getResultForLastError();
+}
+
 //==============================================================================
 void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exclusive)
 {
@@ -151,6 +151,20 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMa
     SetThreadAffinityMask (GetCurrentThread(), affinityMask);
 }
 
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtime (const RealtimeOptions& options)
+{
+    bool ok = true;
+
+    if (options.affinityMask != 0)
+        ok = SetThreadAffinityMask (GetCurrentThread(), (DWORD_PTR) options.affinityMask) != 0;
+
+    // Windows has no equivalent of mlockall or of deadline scheduling
+    if (options.lockMemory || options.policy == RealtimeOptions::Policy::deadline)
+        ok = false;
+
+    return SetThreadPriority (GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != FALSE && ok;
+}
+
 //==============================================================================
 struct SleepEvent
 {
@@ -32,4 +32,24 @@ void HighResolutionTimer::stopTimer()                         { pimpl->stop(); }
 bool HighResolutionTimer::isTimerRunning() const noexcept     { return pimpl->periodMs != 0; }
 int HighResolutionTimer::getTimerInterval() const noexcept    { return pimpl->periodMs; }
 
+void HighResolutionTimer::setRealtimeOptions (const Thread::RealtimeOptions& newOptions)
+{
+    const SpinLock::ScopedLockType sl (realtimeOptionsLock);
+    realtimeOptions = newOptions;
+}
+
+Thread::RealtimeOptions HighResolutionTimer::getRealtimeOptions (int periodMs) const
+{
+    auto options = [this]
+    {
+        const SpinLock::ScopedLockType sl (realtimeOptionsLock);
+        return realtimeOptions;
+    }();
+
+    if (options.periodMs <= 0)
+        options.periodMs = periodMs;
+
+    return options;
+}
+
 } // namespace juce
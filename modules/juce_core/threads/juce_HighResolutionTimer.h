@@ -92,9 +92,26 @@ public:
     */
     int getTimerInterval() const noexcept;
 
+    /** Sets the real-time scheduling that the timer's thread will be given.
+
+        This takes effect the next time the timer is started, or when its interval is
+        changed. If the options' periodMs is zero, the timer's interval is used. By
+        default, the thread gets the highest round-robin priority.
+
+        On Windows the callbacks are made by the system's multimedia timer thread, so
+        these options are ignored.
+
+        @see Thread::setCurrentThreadRealtime
+    */
+    void setRealtimeOptions (const Thread::RealtimeOptions& newOptions);
+
 private:
     struct Pimpl;
     std::unique_ptr<Pimpl> pimpl;
+    Thread::RealtimeOptions realtimeOptions;
+    SpinLock realtimeOptionsLock;
+
+    Thread::RealtimeOptions getRealtimeOptions (int periodMs) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HighResolutionTimer)
 };
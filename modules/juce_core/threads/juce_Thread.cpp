@@ -534,6 +534,164 @@ private:
 
 ThreadLocalValueUnitTest threadLocalValueUnitTest;
 
+//==============================================================================
+#if JUCE_LINUX
+class RealtimeOptionsUnitTest  : public UnitTest
+{
+public:
+    RealtimeOptionsUnitTest()
+        : UnitTest ("Thread::RealtimeOptions", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        using Policy = Thread::RealtimeOptions::Policy;
+
+        beginTest ("Priorities are mapped onto the range of the policy");
+        {
+            if (! applyOptions (makeOptions (Policy::fifo, 1)).applied)
+            {
+                logMessage ("Skipped, because this process isn't allowed to use real-time scheduling");
+                return;
+            }
+
+            for (auto policy : { Policy::roundRobin, Policy::fifo })
+            {
+                const auto nativePolicy = policy == Policy::fifo ? SCHED_FIFO : SCHED_RR;
+                const auto minPriority = sched_get_priority_min (nativePolicy);
+                const auto maxPriority = sched_get_priority_max (nativePolicy);
+
+                expectScheduling (makeOptions (policy, minPriority + 9), nativePolicy, minPriority + 9);
+
+                // zero asks for the highest priority, and anything above that is clipped
+                expectScheduling (makeOptions (policy, 0), nativePolicy, maxPriority);
+                expectScheduling (makeOptions (policy, maxPriority + 100), nativePolicy, maxPriority);
+            }
+        }
+
+        beginTest ("Affinity mask");
+        {
+            auto options = makeOptions (Policy::roundRobin, 1);
+            options.affinityMask = getLowestAvailableCpu();
+
+            const auto result = applyOptions (options);
+            expect (result.applied);
+            expectEquals ((int64) result.affinityMask, (int64) options.affinityMask);
+        }
+
+        beginTest ("HighResolutionTimer uses its options");
+        {
+            struct TestTimer  : public HighResolutionTimer
+            {
+                void hiResTimerCallback() override
+                {
+                    if (! hasBeenCalled.exchange (true))
+                    {
+                        result = getCurrentScheduling();
+                        called.signal();
+                    }
+                }
+
+                std::atomic<bool> hasBeenCalled { false };
+                Scheduling result;
+                WaitableEvent called;
+            };
+
+            auto options = makeOptions (Policy::fifo, sched_get_priority_min (SCHED_FIFO) + 6);
+            options.affinityMask = getLowestAvailableCpu();
+
+            TestTimer timer;
+            timer.setRealtimeOptions (options);
+            timer.startTimer (1);
+
+            expect (timer.called.wait (5000));
+            timer.stopTimer();
+
+            expectEquals (timer.result.policy, (int) SCHED_FIFO);
+            expectEquals (timer.result.priority, options.priority);
+            expectEquals ((int64) timer.result.affinityMask, (int64) options.affinityMask);
+        }
+    }
+
+private:
+    struct Scheduling
+    {
+        bool applied = false;
+        int policy = -1, priority = -1;
+        uint64 affinityMask = 0;
+    };
+
+    static Thread::RealtimeOptions makeOptions (Thread::RealtimeOptions::Policy policy, int priority)
+    {
+        Thread::RealtimeOptions options;
+        options.policy = policy;
+        options.priority = priority;
+        return options;
+    }
+
+    static Scheduling getCurrentScheduling()
+    {
+        Scheduling scheduling;
+        struct sched_param param;
+
+        if (pthread_getschedparam (pthread_self(), &scheduling.policy, &param) == 0)
+            scheduling.priority = param.sched_priority;
+
+        cpu_set_t affinity;
+        CPU_ZERO (&affinity);
+
+        if (pthread_getaffinity_np (pthread_self(), sizeof (cpu_set_t), &affinity) == 0)
+            for (int i = 0; i < 64; ++i)
+                if (CPU_ISSET ((size_t) i, &affinity))
+                    scheduling.affinityMask |= (uint64) 1 << i;
+
+        return scheduling;
+    }
+
+    static uint64 getLowestAvailableCpu()
+    {
+        const auto available = getCurrentScheduling().affinityMask;
+        return available & (~available + 1);
+    }
+
+    // Applies the options to a new thread, and reads back the scheduling that it ended up with
+    static Scheduling applyOptions (const Thread::RealtimeOptions& options)
+    {
+        struct TestThread  : public Thread
+        {
+            explicit TestThread (const Thread::RealtimeOptions& o)
+                : Thread ("RealtimeOptions test"), options (o) {}
+
+            void run() override
+            {
+                const auto applied = setCurrentThreadRealtime (options);
+                result = getCurrentScheduling();
+                result.applied = applied;
+            }
+
+            Thread::RealtimeOptions options;
+            Scheduling result;
+        };
+
+        TestThread thread (options);
+        thread.startThread();
+        thread.waitForThreadToExit (-1);
+        return thread.result;
+    }
+
+    void expectScheduling (const Thread::RealtimeOptions& options, int expectedPolicy, int expectedPriority)
+    {
+        const auto result = applyOptions (options);
+
+        expect (result.applied);
+        expectEquals (result.policy, expectedPolicy);
+        expectEquals (result.priority, expectedPriority);
+    }
+};
+
+static RealtimeOptionsUnitTest realtimeOptionsUnitTest;
+#endif
+
 #endif
 
 } // namespace juce
@@ -261,6 +261,67 @@ public:
     */
     static void JUCE_CALLTYPE setCurrentThreadAffinityMask (uint32 affinityMask);
 
+    //==============================================================================
+    /** Describes the real-time scheduling that a thread should be given.
+
+        @see setCurrentThreadRealtime
+    */
+    struct RealtimeOptions
+    {
+        /** The scheduling policies that can be requested. */
+        enum class Policy
+        {
+            roundRobin,     /**< Fixed priority, sharing time slices with threads of equal priority (SCHED_RR). */
+            fifo,           /**< Fixed priority, running until it blocks or yields (SCHED_FIFO). */
+            deadline        /**< Guaranteed a budget of time in every period (SCHED_DEADLINE, Linux only). */
+        };
+
+        Policy policy = Policy::roundRobin;
+
+        /** For the roundRobin and fifo policies, the native priority to use (1 to 99 on
+            Linux). Zero selects the highest priority that the policy allows.
+        */
+        int priority = 0;
+
+        /** The interval at which the thread needs to run. This is required by the deadline
+            policy, and on macOS and iOS a non-zero period requests a time-constraint thread.
+        */
+        double periodMs = 0;
+
+        /** For the deadline policy, the amount of processing time that the thread needs in
+            each period. On macOS and iOS, this is the computation time of a time-constraint
+            thread.
+        */
+        double budgetMs = 0;
+
+        /** For the deadline policy, the time after the start of each period by which the
+            budget must have been used. Zero means the end of the period.
+        */
+        double deadlineMs = 0;
+
+        /** If this isn't zero, the thread is restricted to the CPUs whose bits are set. */
+        uint64 affinityMask = 0;
+
+        /** If true, all of the process's current and future memory is locked into RAM, so
+            the thread can't stall on a page fault.
+        */
+        bool lockMemory = false;
+    };
+
+    /** Gives the calling thread real-time scheduling.
+
+        Returns false if any of the options couldn't be applied, which usually means that
+        the process doesn't have permission to use real-time scheduling or to lock memory
+        (on Linux, see RLIMIT_RTPRIO, RLIMIT_MEMLOCK and CAP_SYS_NICE). The options are
+        applied in the order affinity, memory locking, scheduling, so a failure of a later
+        one doesn't undo an earlier one.
+
+        Note that Linux will only admit a SCHED_DEADLINE thread whose affinity covers its
+        whole root domain, so to pin one to isolated cores, use a cpuset rather than the
+        affinityMask.
+    */
+    static bool JUCE_CALLTYPE setCurrentThreadRealtime (const RealtimeOptions& options);
+
     //==============================================================================
     /** Suspends the execution of the current thread until the specified timeout period
         has elapsed (note that this may not be exact).
@@ -141,6 +141,9 @@ void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
         {
             const ScopedLock sl (lock);
             jobs.add (job);
+
+            JUCE_TRACE_FLOW_START ("threads", "ThreadPool job", job);
+            JUCE_TRACE_COUNTER ("ThreadPool jobs", jobs.size());
         }
 
         for (auto* t : threads)
@@ -379,13 +382,18 @@ bool ThreadPool::runNextJob (ThreadPoolThread& thread)
         auto result = ThreadPoolJob::jobHasFinished;
         thread.currentJob = job;
 
-        try
-        {
-            result = job->runJob();
-        }
-        catch (...)
         {
-            jassertfalse; // Your runJob() method mustn't throw any exceptions!
+            JUCE_TRACE_SCOPE_IN_CATEGORY ("threads", "ThreadPoolJob::runJob");
+            JUCE_TRACE_FLOW_END ("threads", "ThreadPool job", job);
+
+            try
+            {
+                result = job->runJob();
+            }
+            catch (...)
+            {
+                jassertfalse; // Your runJob() method mustn't throw any exceptions!
+            }
         }
 
         thread.currentJob = nullptr;
@@ -0,0 +1,814 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct Tracer::Event
+{
+    const char* name;
+    const char* category;
+    int64 startTicks, endTicks;
+    double value;
+    uint64 id;
+    char phase;
+
+    void write (OutputStream& out, int threadIndex, int64 firstTicks) const
+    {
+        auto ticksToMicroseconds = [] (int64 ticks) { return String (1.0e6 * Time::highResolutionTicksToSeconds (ticks), 3); };
+
+        out << "{\"name\":" << JSON::toString (String (name))
+            << ",\"cat\":" << JSON::toString (String (category))
+            << ",\"ph\":\"" << String::charToString ((juce_wchar) phase) << "\""
+            << ",\"pid\":1,\"tid\":" << threadIndex
+            << ",\"ts\":" << ticksToMicroseconds (startTicks - firstTicks);
+
+        switch (phase)
+        {
+            case 'X':  out << ",\"dur\":" << ticksToMicroseconds (endTicks - startTicks); break;
+            case 'i':  out << ",\"s\":\"t\""; break;
+            case 'C':  out << ",\"args\":{" << JSON::toString (String (name)) << ":" << value << "}"; break;
+            case 's':  out << ",\"id\":" << (int64) id; break;
+            case 'f':  out << ",\"id\":" << (int64) id << ",\"bp\":\"e\""; break;
+            default:   jassertfalse; break;
+        }
+
+        out << "}";
+    }
+};
+
+//==============================================================================
+// Each buffer is only ever written by its own thread. Every slot has a sequence number,
+// which is odd while the slot is being written, and otherwise says which event the slot
+// holds. A reader can then copy events while they're being recorded, and throw away any
+// whose slot was rewritten while it was copying them.
+struct Tracer::ThreadBuffer
+{
+    explicit ThreadBuffer (int size)  : slots ((size_t) size) {}
+
+    void push (const Event& e) noexcept
+    {
+        const auto n = numWritten.load (std::memory_order_relaxed);
+        auto& slot = slots[(size_t) (n % slots.size())];
+
+        slot.sequence.store (2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        uint64 words[Slot::numWords] {};
+        memcpy (words, &e, sizeof (Event));
+
+        for (size_t i = 0; i < Slot::numWords; ++i)
+            slot.words[i].store (words[i], std::memory_order_relaxed);
+
+        slot.sequence.store (2 * n + 2, std::memory_order_release);
+        numWritten.store (n + 1, std::memory_order_release);
+    }
+
+    bool read (uint64 index, Event& e) const noexcept
+    {
+        const auto& slot = slots[(size_t) (index % slots.size())];
+        const auto expectedSequence = 2 * index + 2;
+
+        if (slot.sequence.load (std::memory_order_acquire) != expectedSequence)
+            return false;
+
+        uint64 words[Slot::numWords];
+
+        for (size_t i = 0; i < Slot::numWords; ++i)
+            words[i] = slot.words[i].load (std::memory_order_relaxed);
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        if (slot.sequence.load (std::memory_order_relaxed) != expectedSequence)
+            return false;
+
+        memcpy (&e, words, sizeof (Event));
+        return true;
+    }
+
+    uint64 getFirstAvailable (uint64 end) const noexcept
+    {
+        return jmax (firstValid.load (std::memory_order_relaxed),
+                     end > slots.size() ? end - (uint64) slots.size() : (uint64) 0);
+    }
+
+    bool hasEvents() const noexcept
+    {
+        const auto end = numWritten.load (std::memory_order_acquire);
+        return getFirstAvailable (end) < end;
+    }
+
+    std::vector<Event> readEvents() const
+    {
+        const auto end = numWritten.load (std::memory_order_acquire);
+        const auto start = getFirstAvailable (end);
+
+        std::vector<Event> result;
+        result.reserve ((size_t) (end - start));
+
+        for (auto i = start; i < end; ++i)
+        {
+            Event e;
+
+            if (read (i, e))
+                result.push_back (e);
+        }
+
+        return result;
+    }
+
+    struct Slot
+    {
+        static constexpr size_t numWords = (sizeof (Event) + sizeof (uint64) - 1) / sizeof (uint64);
+
+        std::atomic<uint64> sequence { 0 };
+        std::atomic<uint64> words[numWords];
+    };
+
+    static_assert (std::is_trivially_copyable<Event>::value, "Events are copied into their slots as raw words");
+
+    std::vector<Slot> slots;
+    std::atomic<uint64> numWritten { 0 }, firstValid { 0 };
+    std::atomic<bool> threadHasExited { false };
+    int threadIndex = 0;
+    String name;
+};
+
+//==============================================================================
+// The threads that record events don't take the lock. They only touch their own buffer,
+// and claim a table entry for it when they start. Everything else locks, and the buffers
+// of threads that have finished are only deleted while the lock is held.
+struct Tracer::Registry
+{
+    static Registry& getInstance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    ~Registry()
+    {
+        for (auto& b : buffers)
+            delete b.load();
+
+        delete spareBuffer.load();
+    }
+
+    bool addBuffer (ThreadBuffer* b) noexcept
+    {
+        for (auto& entry : buffers)
+        {
+            ThreadBuffer* empty = nullptr;
+
+            if (entry.compare_exchange_strong (empty, b, std::memory_order_release))
+                return true;
+        }
+
+        return false;
+    }
+
+    // Must be called with the lock held
+    void removeFinishedBuffers()
+    {
+        for (auto& entry : buffers)
+        {
+            auto* b = entry.load (std::memory_order_acquire);
+
+            if (b != nullptr && b->threadHasExited.load (std::memory_order_acquire) && ! b->hasEvents())
+            {
+                entry.store (nullptr, std::memory_order_relaxed);
+                delete b;
+            }
+        }
+    }
+
+    static constexpr int maxNumThreads = 1024;
+
+    SpinLock lock;
+    std::array<std::atomic<ThreadBuffer*>, maxNumThreads> buffers {};
+    std::atomic<ThreadBuffer*> spareBuffer { nullptr };
+    std::atomic<int> nextThreadIndex { 1 };
+    int bufferSize = 16384;
+
+    // Lets the registry know when a thread that has a buffer finishes. The buffer pointer
+    // and the finished flag are separate, trivially destructible thread_locals, so that
+    // events recorded after this has been destroyed (e.g. by the main thread's static
+    // destructors) can still see that they have to be dropped.
+    struct ThreadHandle
+    {
+        ~ThreadHandle()
+        {
+            if (auto* b = std::exchange (currentThreadBuffer, nullptr))
+            {
+                if (isInRegistry)
+                    b->threadHasExited.store (true, std::memory_order_release);
+                else
+                    delete b;
+            }
+
+            threadHasFinished = true;
+        }
+
+        String pendingName;
+        bool isInRegistry = false;
+    };
+
+    static std::atomic<bool> enabled;
+    static thread_local ThreadHandle currentThread;
+    static thread_local ThreadBuffer* currentThreadBuffer;
+    static thread_local bool threadHasFinished;
+};
+
+constexpr int Tracer::Registry::maxNumThreads;
+std::atomic<bool> Tracer::Registry::enabled { false };
+thread_local Tracer::Registry::ThreadHandle Tracer::Registry::currentThread;
+thread_local Tracer::ThreadBuffer* Tracer::Registry::currentThreadBuffer = nullptr;
+thread_local bool Tracer::Registry::threadHasFinished = false;
+
+//==============================================================================
+void Tracer::setEnabled (bool shouldBeEnabled) noexcept
+{
+    Registry::enabled.store (shouldBeEnabled, std::memory_order_relaxed);
+}
+
+bool Tracer::isEnabled() noexcept
+{
+    return Registry::enabled.load (std::memory_order_relaxed);
+}
+
+void Tracer::setBufferSize (int numEventsPerThread)
+{
+    jassert (numEventsPerThread > 0);
+
+    auto& registry = Registry::getInstance();
+    const SpinLock::ScopedLockType sl (registry.lock);
+    registry.bufferSize = jmax (1, numEventsPerThread);
+
+    // (a buffer that was made in advance would have the old size)
+    delete registry.spareBuffer.exchange (nullptr);
+}
+
+Tracer::ThreadBuffer* Tracer::getBufferForCurrentThread (bool canAllocate)
+{
+    if (auto* b = Registry::currentThreadBuffer)
+        return b;
+
+    if (Registry::threadHasFinished)
+        return nullptr;
+
+    auto& registry = Registry::getInstance();
+    std::unique_ptr<ThreadBuffer> b;
+
+    if (canAllocate)
+    {
+        int size = 0;
+
+        {
+            const SpinLock::ScopedLockType sl (registry.lock);
+            registry.removeFinishedBuffers();
+            size = registry.bufferSize;
+        }
+
+        b.reset (new ThreadBuffer (size));
+    }
+    else
+    {
+        // only the buffer made in advance by preallocateBuffer() can be taken without
+        // locking or allocating
+        b.reset (registry.spareBuffer.exchange (nullptr));
+
+        if (b == nullptr)
+            return nullptr;
+    }
+
+    // (the first use of this thread_local on a thread registers its destructor, which
+    // the runtime may need a few bytes for)
+    auto& handle = Registry::currentThread;
+
+    b->threadIndex = registry.nextThreadIndex++;
+
+    if (handle.pendingName.isNotEmpty())
+        b->name = handle.pendingName;
+    else if (auto* thread = Thread::getCurrentThread())
+        b->name = thread->getThreadName();
+
+    // If this fails, there are more threads recording events than the registry can hold,
+    // so this one's events won't appear in the trace
+    handle.isInRegistry = registry.addBuffer (b.get());
+    jassert (handle.isInRegistry);
+
+    Registry::currentThreadBuffer = b.release();
+    return Registry::currentThreadBuffer;
+}
+
+void Tracer::preallocateBuffer()
+{
+    if (! isEnabled())
+        return;
+
+    auto& registry = Registry::getInstance();
+
+    if (registry.spareBuffer.load() != nullptr)
+        return;
+
+    int size = 0;
+
+    {
+        const SpinLock::ScopedLockType sl (registry.lock);
+        registry.removeFinishedBuffers();
+        size = registry.bufferSize;
+    }
+
+    ThreadBuffer* empty = nullptr;
+    auto* b = new ThreadBuffer (size);
+
+    if (! registry.spareBuffer.compare_exchange_strong (empty, b))
+        delete b;
+}
+
+void Tracer::registerCurrentThread()
+{
+    getBufferForCurrentThread (true);
+}
+
+bool Tracer::registerCurrentThreadWithoutAllocating() noexcept
+{
+    return getBufferForCurrentThread (false) != nullptr;
+}
+
+void Tracer::setCurrentThreadName (const String& newName)
+{
+    if (Registry::threadHasFinished)
+        return;
+
+    if (auto* b = Registry::currentThreadBuffer)
+    {
+        const SpinLock::ScopedLockType sl (Registry::getInstance().lock);
+        b->name = newName;
+        return;
+    }
+
+    // the name is given to the thread's buffer when it gets one
+    Registry::currentThread.pendingName = newName;
+}
+
+void Tracer::addEvent (const Event& e) noexcept
+{
+    // The first event on a thread has to allocate its buffer - if this is a real-time
+    // thread, call registerCurrentThread() before it starts working, or use a
+    // ScopedSpan that's marked as being on a real-time thread!
+    if (auto* b = Registry::currentThreadBuffer)
+        b->push (e);
+    else if (auto* newBuffer = getBufferForCurrentThread (true))
+        newBuffer->push (e);
+}
+
+//==============================================================================
+void Tracer::addSpan (const char* name, const char* category, int64 startTicks, int64 endTicks) noexcept
+{
+    if (isEnabled())
+        addEvent ({ name, category, startTicks, endTicks, 0.0, 0, 'X' });
+}
+
+void Tracer::addInstantEvent (const char* name, const char* category) noexcept
+{
+    if (isEnabled())
+    {
+        const auto now = Time::getHighResolutionTicks();
+        addEvent ({ name, category, now, now, 0.0, 0, 'i' });
+    }
+}
+
+void Tracer::addCounter (const char* name, double value) noexcept
+{
+    if (isEnabled())
+    {
+        const auto now = Time::getHighResolutionTicks();
+        addEvent ({ name, defaultCategory, now, now, value, 0, 'C' });
+    }
+}
+
+void Tracer::addFlowStart (const char* name, uint64 flowID, const char* category) noexcept
+{
+    if (isEnabled())
+    {
+        const auto now = Time::getHighResolutionTicks();
+        addEvent ({ name, category, now, now, 0.0, flowID, 's' });
+    }
+}
+
+void Tracer::addFlowEnd (const char* name, uint64 flowID, const char* category) noexcept
+{
+    if (isEnabled())
+    {
+        const auto now = Time::getHighResolutionTicks();
+        addEvent ({ name, category, now, now, 0.0, flowID, 'f' });
+    }
+}
+
+//==============================================================================
+void Tracer::clear() noexcept
+{
+    auto& registry = Registry::getInstance();
+    const SpinLock::ScopedLockType sl (registry.lock);
+
+    for (auto& entry : registry.buffers)
+        if (auto* b = entry.load (std::memory_order_acquire))
+            b->firstValid.store (b->numWritten.load (std::memory_order_acquire), std::memory_order_relaxed);
+
+    registry.removeFinishedBuffers();
+}
+
+int Tracer::getNumThreadBuffers() noexcept
+{
+    auto& registry = Registry::getInstance();
+    const SpinLock::ScopedLockType sl (registry.lock);
+
+    return (int) std::count_if (registry.buffers.begin(), registry.buffers.end(),
+                                [] (const std::atomic<ThreadBuffer*>& entry) { return entry.load() != nullptr; });
+}
+
+int64 Tracer::getNumDroppedEvents() noexcept
+{
+    auto& registry = Registry::getInstance();
+    const SpinLock::ScopedLockType sl (registry.lock);
+
+    int64 numDropped = 0;
+
+    for (auto& entry : registry.buffers)
+    {
+        auto* b = entry.load (std::memory_order_acquire);
+
+        if (b == nullptr)
+            continue;
+
+        const auto end = b->numWritten.load (std::memory_order_acquire);
+        numDropped += (int64) (b->getFirstAvailable (end) - jmin (end, b->firstValid.load (std::memory_order_relaxed)));
+    }
+
+    return numDropped;
+}
+
+void Tracer::writeChromeTrace (OutputStream& out)
+{
+    struct ThreadEvents
+    {
+        int threadIndex;
+        String name;
+        std::vector<Event> events;
+    };
+
+    std::vector<ThreadEvents> threads;
+
+    {
+        auto& registry = Registry::getInstance();
+        const SpinLock::ScopedLockType sl (registry.lock);
+
+        for (auto& entry : registry.buffers)
+            if (auto* b = entry.load (std::memory_order_acquire))
+                threads.push_back ({ b->threadIndex,
+                                     b->name.isNotEmpty() ? b->name : "Thread " + String (b->threadIndex),
+                                     b->readEvents() });
+    }
+
+    auto firstTicks = std::numeric_limits<int64>::max();
+
+    for (auto& t : threads)
+        for (auto& e : t.events)
+            firstTicks = jmin (firstTicks, e.startTicks);
+
+    out << "{\"traceEvents\":[";
+
+    bool isFirst = true;
+
+    for (auto& t : threads)
+    {
+        if (t.events.empty())
+            continue;
+
+        out << (isFirst ? "\n" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t.threadIndex
+            << ",\"args\":{\"name\":" << JSON::toString (t.name) << "}}";
+
+        isFirst = false;
+
+        for (auto& e : t.events)
+        {
+            out << ",\n";
+            e.write (out, t.threadIndex, firstTicks);
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool Tracer::writeChromeTrace (const File& file)
+{
+    FileOutputStream out (file);
+
+    if (! out.openedOk())
+        return false;
+
+    out.setPosition (0);
+    out.truncate();
+    writeChromeTrace (out);
+    out.flush();
+
+    return out.getStatus().wasOk();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TracerTests  : public UnitTest
+{
+public:
+    TracerTests()
+        : UnitTest ("Tracer", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        Tracer::setEnabled (false);
+        Tracer::clear();
+
+        beginTest ("Nothing is recorded while tracing is disabled");
+        {
+            {
+                Tracer::ScopedSpan span ("TracerTests span");
+                Tracer::addCounter ("TracerTests counter", 1.0);
+            }
+
+            expect (getEvents ("TracerTests span").isEmpty());
+            expect (getEvents ("TracerTests counter").isEmpty());
+        }
+
+        Tracer::setEnabled (true);
+
+        beginTest ("Spans, counters, instants and flows are written in the Chrome trace format");
+        {
+            {
+                Tracer::ScopedSpan outer ("TracerTests span", "tests");
+                Tracer::addInstantEvent ("TracerTests instant");
+                Tracer::addCounter ("TracerTests counter", 42.0);
+                Tracer::addFlowStart ("TracerTests flow", 7);
+                Thread::sleep (2);
+            }
+
+            TestThread thread ([]
+            {
+                Tracer::ScopedSpan span ("TracerTests other thread");
+                Tracer::addFlowEnd ("TracerTests flow", 7);
+            });
+
+            thread.startThread();
+            thread.waitForThreadToExit (-1);
+
+            const auto spans = getEvents ("TracerTests span");
+            expectEquals (spans.size(), 1);
+            expectEquals (spans[0]["ph"].toString(), String ("X"));
+            expectEquals (spans[0]["cat"].toString(), String ("tests"));
+            expect ((double) spans[0]["dur"] >= 1000.0);
+
+            const auto counters = getEvents ("TracerTests counter");
+            expectEquals (counters.size(), 1);
+            expectEquals ((double) counters[0]["args"]["TracerTests counter"], 42.0);
+
+            expectEquals (getEvents ("TracerTests instant").size(), 1);
+
+            const auto flows = getEvents ("TracerTests flow");
+            expectEquals (flows.size(), 2);
+            expectEquals (flows[0]["ph"].toString() + flows[1]["ph"].toString(), String ("sf"));
+            expect ((int) flows[0]["tid"] != (int) flows[1]["tid"]);
+
+            const auto threadNames = getEvents ("thread_name");
+            expect (std::any_of (threadNames.begin(), threadNames.end(), [&] (const var& e)
+                                 {
+                                     return (int) e["tid"] == (int) flows[1]["tid"]
+                                              && e["args"]["name"].toString() == "TracerTests thread";
+                                 }));
+        }
+
+        beginTest ("clear() discards recorded events");
+        {
+            Tracer::clear();
+            expect (getEvents ("TracerTests span").isEmpty());
+            expect (getEvents ("TracerTests other thread").isEmpty());
+        }
+
+        beginTest ("A full buffer keeps the most recent events");
+        {
+            Tracer::setBufferSize (8);
+
+            TestThread thread ([]
+            {
+                Tracer::registerCurrentThread();
+
+                for (int i = 0; i < 20; ++i)
+                    Tracer::addCounter ("TracerTests overflow", (double) i);
+            });
+
+            thread.startThread();
+            thread.waitForThreadToExit (-1);
+            Tracer::setBufferSize (16384);
+
+            const auto events = getEvents ("TracerTests overflow");
+            expectEquals (events.size(), 8);
+            expectEquals ((int) events[0]["args"]["TracerTests overflow"], 12);
+            expectEquals ((int) events[7]["args"]["TracerTests overflow"], 19);
+            expect (Tracer::getNumDroppedEvents() >= 12);
+
+            Tracer::clear();
+            expectEquals (Tracer::getNumDroppedEvents(), (int64) 0);
+        }
+
+        beginTest ("Events that are being overwritten while the trace is written are left out");
+        {
+            Tracer::setBufferSize (64);
+
+            TestThread thread ([]
+            {
+                auto* thisThread = Thread::getCurrentThread();
+
+                for (int i = 0; ! thisThread->threadShouldExit(); ++i)
+                    Tracer::addCounter ((i & 1) != 0 ? "TracerTests odd" : "TracerTests even", (double) i);
+            });
+
+            thread.startThread();
+
+            for (int i = 0; i < 50; ++i)
+            {
+                MemoryOutputStream out;
+                Tracer::writeChromeTrace (out);
+
+                const auto trace = JSON::parse (out.toString());
+                auto lastValue = -1;
+                auto numEvents = 0;
+
+                if (auto* events = trace["traceEvents"].getArray())
+                {
+                    for (auto& e : *events)
+                    {
+                        const auto eventName = e["name"].toString();
+
+                        if (eventName != "TracerTests odd" && eventName != "TracerTests even")
+                            continue;
+
+                        const auto value = (int) e["args"][Identifier (eventName)];
+                        expect (((value & 1) != 0) == (eventName == "TracerTests odd"));
+                        expect (value > lastValue);
+
+                        lastValue = value;
+                        ++numEvents;
+                    }
+                }
+
+                expect (numEvents <= 64);
+            }
+
+            thread.stopThread (-1);
+            Tracer::setBufferSize (16384);
+            Tracer::clear();
+        }
+
+        beginTest ("A finished thread's buffer is deleted once its events have been cleared");
+        {
+            Tracer::clear();
+            const auto numBuffers = Tracer::getNumThreadBuffers();
+
+            TestThread thread ([] { Tracer::addInstantEvent ("TracerTests finished thread"); });
+            thread.startThread();
+            thread.waitForThreadToExit (-1);
+
+            expectEquals (Tracer::getNumThreadBuffers(), numBuffers + 1);
+            expectEquals (getEvents ("TracerTests finished thread").size(), 1);
+
+            // the thread's buffer is released as the OS thread exits, which can be
+            // slightly after waitForThreadToExit() returns
+            for (int i = 0; i < 100 && Tracer::getNumThreadBuffers() > numBuffers; ++i)
+            {
+                Thread::sleep (10);
+                Tracer::clear();
+            }
+
+            expectEquals (Tracer::getNumThreadBuffers(), numBuffers);
+            expect (getEvents ("TracerTests finished thread").isEmpty());
+        }
+
+        beginTest ("A preallocated buffer is only given to a real-time thread, and its spans are dropped if there isn't one");
+        {
+            const auto numBuffers = Tracer::getNumThreadBuffers();
+            Tracer::preallocateBuffer();
+            expectEquals (Tracer::getNumThreadBuffers(), numBuffers);
+
+            const auto runThread = [] (std::function<void()> f)
+            {
+                TestThread thread (std::move (f));
+                thread.startThread();
+                thread.waitForThreadToExit (-1);
+            };
+
+            // an ordinary thread allocates its own buffer, rather than taking the spare one
+            runThread ([] { Tracer::addInstantEvent ("TracerTests ordinary"); });
+            runThread ([] { Tracer::ScopedSpan span ("TracerTests realtime", "tests", true); });
+            runThread ([] { Tracer::ScopedSpan span ("TracerTests dropped", "tests", true); });
+
+            expectEquals (Tracer::getNumThreadBuffers(), numBuffers + 2);
+            expectEquals (getEvents ("TracerTests ordinary").size(), 1);
+            expectEquals (getEvents ("TracerTests realtime").size(), 1);
+            expect (getEvents ("TracerTests dropped").isEmpty());
+            Tracer::clear();
+        }
+
+        beginTest ("Naming a thread doesn't make its buffer until it records an event");
+        {
+            const auto numBuffers = Tracer::getNumThreadBuffers();
+            int numBuffersAfterNaming = -1;
+
+            TestThread thread ([&]
+            {
+                Tracer::setCurrentThreadName ("TracerTests renamed thread");
+                numBuffersAfterNaming = Tracer::getNumThreadBuffers();
+                Tracer::addInstantEvent ("TracerTests renamed");
+            });
+
+            thread.startThread();
+            thread.waitForThreadToExit (-1);
+
+            expectEquals (numBuffersAfterNaming, numBuffers);
+
+            const auto events = getEvents ("TracerTests renamed");
+            const auto threadNames = getEvents ("thread_name");
+            expectEquals (events.size(), 1);
+            expect (std::any_of (threadNames.begin(), threadNames.end(), [&] (const var& e)
+                                 {
+                                     return (int) e["tid"] == (int) events[0]["tid"]
+                                              && e["args"]["name"].toString() == "TracerTests renamed thread";
+                                 }));
+            Tracer::clear();
+        }
+
+        Tracer::setEnabled (false);
+
+        beginTest ("Nothing is preallocated while tracing is disabled");
+        {
+            Tracer::preallocateBuffer();
+
+            TestThread thread ([this] { expect (! Tracer::registerCurrentThreadWithoutAllocating()); });
+            thread.startThread();
+            thread.waitForThreadToExit (-1);
+        }
+    }
+
+private:
+    struct TestThread  : public Thread
+    {
+        explicit TestThread (std::function<void()> f)  : Thread ("TracerTests thread"), function (std::move (f)) {}
+        void run() override  { function(); }
+
+        std::function<void()> function;
+    };
+
+    static Array<var> getEvents (const String& name)
+    {
+        MemoryOutputStream out;
+        Tracer::writeChromeTrace (out);
+
+        const auto trace = JSON::parse (out.toString());
+        Array<var> result;
+
+        if (auto* events = trace["traceEvents"].getArray())
+            for (auto& e : *events)
+                if (e["name"].toString() == name)
+                    result.add (e);
+
+        return result;
+    }
+};
+
+static TracerTests tracerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,258 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records timeline events from any thread, and writes them out in the Chrome trace
+    event format so that they can be inspected in Perfetto (ui.perfetto.dev) or
+    chrome://tracing.
+
+    Every thread that records an event gets its own fixed-size ring buffer, so adding
+    an event never locks or allocates once that buffer exists. The buffer is created
+    the first time a thread records something, so a real-time thread should call
+    registerCurrentThread() before it starts its time-critical work. If that isn't
+    possible, e.g. because the thread belongs to the OS, call preallocateBuffer()
+    beforehand, and record the thread's spans with a ScopedSpan that's marked as being
+    on a real-time thread. When a buffer fills up, its oldest events are overwritten.
+
+    When a thread finishes, its buffer is kept until its events have been discarded
+    by clear(), and is then deleted.
+
+    Nothing is recorded until setEnabled (true) is called, and while tracing is
+    disabled each event costs one atomic load. The framework's own instrumentation
+    (message dispatch, ThreadPool jobs, Timer callbacks, component painting and audio
+    device callbacks) uses the JUCE_TRACE_ macros declared below, which compile to
+    nothing unless JUCE_ENABLE_TRACING is set.
+
+    Only the pointers to event names and categories are stored, so they must be string
+    literals, or otherwise remain valid until the trace has been written.
+
+    e.g. @code
+    void MyProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi)
+    {
+        JUCE_TRACE_SCOPE ("MyProcessor::processBlock");
+        ...
+        JUCE_TRACE_COUNTER ("Active voices", numActiveVoices);
+    }
+
+    Tracer::setEnabled (true);
+    ...
+    Tracer::writeChromeTrace (File::getSpecialLocation (File::userDesktopDirectory)
+                                  .getChildFile ("trace.json"));
+    @endcode
+
+    @tags{Core}
+*/
+class JUCE_API  Tracer
+{
+public:
+    //==============================================================================
+    /** Starts or stops recording events.
+        Events that have already been recorded are kept until clear() is called.
+    */
+    static void setEnabled (bool shouldBeEnabled) noexcept;
+
+    /** Returns true if events are currently being recorded. */
+    static bool isEnabled() noexcept;
+
+    /** Sets the number of events that each thread's ring buffer can hold.
+        This only affects threads that haven't recorded any events yet. The default
+        is 16384.
+    */
+    static void setBufferSize (int numEventsPerThread);
+
+    /** Creates the calling thread's event buffer, if it doesn't already exist.
+        Call this from a real-time thread before it starts its time-critical work, so
+        that its first event doesn't need to allocate.
+    */
+    static void registerCurrentThread();
+
+    /** Makes a buffer in advance, which the next thread to call
+        registerCurrentThreadWithoutAllocating() will be given.
+
+        Call this before starting a real-time thread that can't call
+        registerCurrentThread() itself before it begins its time-critical work, such as
+        an audio callback thread that belongs to the OS. Only one buffer is kept in
+        advance, and this does nothing while tracing is disabled.
+    */
+    static void preallocateBuffer();
+
+    /** Gives the calling thread the buffer made by preallocateBuffer(), if it doesn't
+        have a buffer already. This never locks or allocates, so it can be called from
+        a real-time thread.
+
+        @returns true if the thread has a buffer, and can record events without
+                 allocating
+    */
+    static bool registerCurrentThreadWithoutAllocating() noexcept;
+
+    /** Sets the name that the calling thread will be given in the trace.
+        By default, a Thread uses its own name, and any other thread is given a number.
+        This doesn't create the thread's buffer, but may allocate, so don't call it
+        from a real-time thread.
+    */
+    static void setCurrentThreadName (const String& newName);
+
+    //==============================================================================
+    /** Records an event that began at startTicks and ended at endTicks, where both
+        are values from Time::getHighResolutionTicks().
+        @see ScopedSpan
+    */
+    static void addSpan (const char* name, const char* category, int64 startTicks, int64 endTicks) noexcept;
+
+    /** Records an event that happens at a single moment. */
+    static void addInstantEvent (const char* name, const char* category = defaultCategory) noexcept;
+
+    /** Records the current value of a counter, which is drawn as a graph in the trace. */
+    static void addCounter (const char* name, double value) noexcept;
+
+    /** Records the start of a flow, which is drawn as an arrow from the enclosing span
+        to the span that encloses the matching call to addFlowEnd().
+
+        The flowID links the two ends together, so it must be unique among the flows
+        with this name that are in progress at the same time.
+    */
+    static void addFlowStart (const char* name, uint64 flowID, const char* category = defaultCategory) noexcept;
+
+    /** Records the end of a flow that was started with addFlowStart(). */
+    static void addFlowEnd (const char* name, uint64 flowID, const char* category = defaultCategory) noexcept;
+
+    //==============================================================================
+    /** Records a span lasting from its construction until its destruction.
+
+        If isOnRealtimeThread is true and the thread doesn't have a buffer yet, it's
+        given the one made by preallocateBuffer(), and the span is dropped if there
+        isn't one, rather than locking or allocating.
+
+        @see JUCE_TRACE_SCOPE, JUCE_TRACE_REALTIME_SCOPE_IN_CATEGORY
+    */
+    class JUCE_API  ScopedSpan
+    {
+    public:
+        explicit ScopedSpan (const char* name, const char* category = defaultCategory,
+                             bool isOnRealtimeThread = false) noexcept
+            : spanName (name), spanCategory (category),
+              startTicks (isEnabled() && (! isOnRealtimeThread || registerCurrentThreadWithoutAllocating())
+                            ? Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedSpan() noexcept
+        {
+            if (startTicks != 0)
+                addSpan (spanName, spanCategory, startTicks, Time::getHighResolutionTicks());
+        }
+
+    private:
+        const char* spanName;
+        const char* spanCategory;
+        int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedSpan)
+    };
+
+    //==============================================================================
+    /** Discards all the events that have been recorded so far. */
+    static void clear() noexcept;
+
+    /** Returns the number of events that have been overwritten because their thread's
+        buffer was full, since the last call to clear().
+    */
+    static int64 getNumDroppedEvents() noexcept;
+
+    /** Returns the number of thread buffers that currently exist, including those of
+        threads that have finished but whose events haven't been cleared yet.
+    */
+    static int getNumThreadBuffers() noexcept;
+
+    /** Writes all the recorded events as a Chrome trace event format JSON document.
+        This can be called while other threads are still recording.
+    */
+    static void writeChromeTrace (OutputStream& output);
+
+    /** Writes all the recorded events to a JSON file, replacing its previous contents.
+        @returns true if the file was written successfully
+    */
+    static bool writeChromeTrace (const File& file);
+
+    /** The category used when none is specified. */
+    static constexpr const char* defaultCategory = "juce";
+
+private:
+    //==============================================================================
+    struct Event;
+    struct ThreadBuffer;
+    struct Registry;
+
+    static void addEvent (const Event&) noexcept;
+    static ThreadBuffer* getBufferForCurrentThread (bool canAllocate);
+
+    Tracer() = delete;
+};
+
+//==============================================================================
+#if JUCE_ENABLE_TRACING || DOXYGEN
+ /** Records a span covering the rest of the current scope. */
+ #define JUCE_TRACE_SCOPE(name)                                 const juce::Tracer::ScopedSpan JUCE_JOIN_MACRO (juceTraceSpan_, __LINE__) (name)
+
+ /** Records a span covering the rest of the current scope, in the given category. */
+ #define JUCE_TRACE_SCOPE_IN_CATEGORY(category, name)           const juce::Tracer::ScopedSpan JUCE_JOIN_MACRO (juceTraceSpan_, __LINE__) (name, category)
+
+ /** Records a span covering the rest of the current scope on a real-time thread, which
+     is dropped rather than allocating the thread's buffer.
+     @see Tracer::ScopedSpan
+ */
+ #define JUCE_TRACE_REALTIME_SCOPE_IN_CATEGORY(category, name)  const juce::Tracer::ScopedSpan JUCE_JOIN_MACRO (juceTraceSpan_, __LINE__) (name, category, true)
+
+ /** Records an instant event. */
+ #define JUCE_TRACE_INSTANT(name)                               juce::Tracer::addInstantEvent (name)
+
+ /** Records the value of a counter. */
+ #define JUCE_TRACE_COUNTER(name, value)                        juce::Tracer::addCounter (name, (double) (value))
+
+ /** Records the start of a flow, whose id can be an integer or a pointer. */
+ #define JUCE_TRACE_FLOW_START(category, name, id)              juce::Tracer::addFlowStart (name, (juce::uint64) (juce::pointer_sized_uint) (id), category)
+
+ /** Records the end of a flow started with JUCE_TRACE_FLOW_START. */
+ #define JUCE_TRACE_FLOW_END(category, name, id)                juce::Tracer::addFlowEnd (name, (juce::uint64) (juce::pointer_sized_uint) (id), category)
+
+ /** Sets the name of the current thread in the trace. */
+ #define JUCE_TRACE_THREAD_NAME(name)                           juce::Tracer::setCurrentThreadName (name)
+
+ /** Makes a buffer in advance for the next thread to record an event. */
+ #define JUCE_TRACE_PREALLOCATE_BUFFER()                        juce::Tracer::preallocateBuffer()
+#else
+ #define JUCE_TRACE_SCOPE(name)                                 JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+ #define JUCE_TRACE_SCOPE_IN_CATEGORY(category, name)           JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+ #define JUCE_TRACE_REALTIME_SCOPE_IN_CATEGORY(category, name)  JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+ #define JUCE_TRACE_INSTANT(name)                               JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+ #define JUCE_TRACE_COUNTER(name, value)                        JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+ #define JUCE_TRACE_FLOW_START(category, name, id)              JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+ #define JUCE_TRACE_FLOW_END(category, name, id)                JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+ #define JUCE_TRACE_THREAD_NAME(name)                           JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+ #define JUCE_TRACE_PREALLOCATE_BUFFER()                        JUCE_BLOCK_WITH_FORCED_SEMICOLON (;)
+#endif
+
+} // namespace juce
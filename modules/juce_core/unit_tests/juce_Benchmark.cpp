@@ -0,0 +1,559 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+namespace BenchmarkHelpers
+{
+    static uint64 readCycleCounter() noexcept
+    {
+       #if JUCE_INTEL && JUCE_MSVC
+        return (uint64) __rdtsc();
+       #elif JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+        return (uint64) __builtin_ia32_rdtsc();
+       #else
+        return 0;
+       #endif
+    }
+
+   #if JUCE_ENABLE_ALLOCATION_HOOKS
+    struct AllocationCounter  : private AllocationHooks::Listener
+    {
+        AllocationCounter()            { getAllocationHooksForThread().addListener (this); }
+        ~AllocationCounter() override  { getAllocationHooksForThread().removeListener (this); }
+
+        void newOrDeleteCalled() noexcept override  { ++count; }
+
+        size_t count = 0;
+    };
+   #else
+    struct AllocationCounter
+    {
+        size_t count = 0;
+    };
+   #endif
+
+    static String escapeForCSV (const String& s)
+    {
+        if (s.containsAnyOf (",\"\r\n"))
+            return s.replace ("\"", "\"\"").quoted();
+
+        return s;
+    }
+}
+
+volatile const void* Benchmark::volatileSink = nullptr;
+
+//==============================================================================
+Benchmark::Benchmark (const String& nm, const String& ctg)
+    : name (nm), category (ctg)
+{
+    getAllBenchmarks().add (this);
+}
+
+Benchmark::~Benchmark()
+{
+    getAllBenchmarks().removeFirstMatchingValue (this);
+}
+
+Array<Benchmark*>& Benchmark::getAllBenchmarks()
+{
+    static Array<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+Array<Benchmark*> Benchmark::getBenchmarksInCategory (const String& category)
+{
+    if (category.isEmpty())
+        return getAllBenchmarks();
+
+    Array<Benchmark*> benchmarks;
+
+    for (auto* b : getAllBenchmarks())
+        if (b->getCategory() == category)
+            benchmarks.add (b);
+
+    return benchmarks;
+}
+
+StringArray Benchmark::getAllCategories()
+{
+    StringArray categories;
+
+    for (auto* b : getAllBenchmarks())
+        if (b->getCategory().isNotEmpty())
+            categories.addIfNotAlreadyThere (b->getCategory());
+
+    return categories;
+}
+
+void Benchmark::initialise()  {}
+void Benchmark::shutdown()    {}
+
+void Benchmark::performBenchmark (BenchmarkRunner* const newRunner)
+{
+    jassert (newRunner != nullptr);
+    runner = newRunner;
+
+    initialise();
+    runBenchmark();
+    shutdown();
+
+    runner = nullptr;
+}
+
+void Benchmark::logMessage (const String& message)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    runner->logMessage (message);
+}
+
+bool Benchmark::isCycleCounterAvailable() noexcept
+{
+   #if JUCE_INTEL && (JUCE_MSVC || JUCE_GCC || JUCE_CLANG)
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool Benchmark::isAllocationCountingAvailable() noexcept
+{
+    return JUCE_ENABLE_ALLOCATION_HOOKS != 0;
+}
+
+void Benchmark::measureIterations (const String& measurementName,
+                                   std::function<void (int)> runIterations,
+                                   int64 itemsPerIteration)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    if (runner->shouldAbortBenchmarks())
+        return;
+
+    auto timeIterations = [&runIterations] (int numIterations)
+    {
+        const auto start = Time::getHighResolutionTicks();
+        runIterations (numIterations);
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+    };
+
+    // Warm up, while doubling the number of iterations until a sample is long enough to time
+    int iterationsPerSample = 1;
+    double warmupElapsed = 0;
+
+    for (;;)
+    {
+        const auto elapsed = timeIterations (iterationsPerSample);
+        warmupElapsed += elapsed;
+
+        if (elapsed >= runner->minimumSampleSeconds && elapsed > 0)
+        {
+            if (warmupElapsed >= runner->warmupSeconds)
+                break;
+        }
+        else if (iterationsPerSample < std::numeric_limits<int>::max() / 2)
+        {
+            iterationsPerSample *= 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    const auto numSamples = jmax (1, runner->numSamples);
+    std::vector<double> sampleNanoseconds;
+    sampleNanoseconds.reserve ((size_t) numSamples);
+
+    uint64 totalCycles = 0;
+    size_t totalAllocations = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        BenchmarkHelpers::AllocationCounter allocations;
+
+        const auto startCycles = BenchmarkHelpers::readCycleCounter();
+        const auto elapsed = timeIterations (iterationsPerSample);
+        totalCycles += BenchmarkHelpers::readCycleCounter() - startCycles;
+        totalAllocations += allocations.count;
+
+        sampleNanoseconds.push_back (elapsed * 1.0e9 / iterationsPerSample);
+    }
+
+    BenchmarkRunner::Result result;
+    result.benchmarkName = name;
+    result.category = category;
+    result.measurementName = measurementName;
+    result.numSamples = numSamples;
+    result.iterationsPerSample = iterationsPerSample;
+
+    const auto totalIterations = (double) numSamples * iterationsPerSample;
+    const auto mean = std::accumulate (sampleNanoseconds.begin(), sampleNanoseconds.end(), 0.0) / numSamples;
+
+    double variance = 0;
+
+    for (auto ns : sampleNanoseconds)
+        variance += (ns - mean) * (ns - mean);
+
+    std::sort (sampleNanoseconds.begin(), sampleNanoseconds.end());
+    const auto middle = (size_t) numSamples / 2;
+
+    result.meanNanoseconds = mean;
+    result.medianNanoseconds = (numSamples % 2) != 0 ? sampleNanoseconds[middle]
+                                                     : (sampleNanoseconds[middle - 1] + sampleNanoseconds[middle]) * 0.5;
+    result.minNanoseconds = sampleNanoseconds.front();
+    result.maxNanoseconds = sampleNanoseconds.back();
+    result.standardDeviationNanoseconds = numSamples > 1 ? std::sqrt (variance / (numSamples - 1)) : 0.0;
+    result.meanCycles = (double) totalCycles / totalIterations;
+
+    if (isAllocationCountingAvailable())
+        result.meanAllocations = (double) totalAllocations / totalIterations;
+
+    result.itemsPerIteration = itemsPerIteration;
+
+    if (itemsPerIteration > 0 && mean > 0)
+        result.itemsPerSecond = (double) itemsPerIteration * 1.0e9 / mean;
+
+    runner->addResult (result);
+}
+
+//==============================================================================
+BenchmarkRunner::BenchmarkRunner() {}
+BenchmarkRunner::~BenchmarkRunner() {}
+
+void BenchmarkRunner::setWarmupTime (double seconds) noexcept
+{
+    jassert (seconds >= 0);
+    warmupSeconds = seconds;
+}
+
+void BenchmarkRunner::setNumSamples (int numSamplesToTake) noexcept
+{
+    jassert (numSamplesToTake > 0);
+    numSamples = numSamplesToTake;
+}
+
+void BenchmarkRunner::setMinimumSampleTime (double seconds) noexcept
+{
+    jassert (seconds >= 0);
+    minimumSampleSeconds = seconds;
+}
+
+int BenchmarkRunner::getNumResults() const noexcept
+{
+    return results.size();
+}
+
+const BenchmarkRunner::Result* BenchmarkRunner::getResult (int index) const noexcept
+{
+    return results [index];
+}
+
+void BenchmarkRunner::resultsUpdated()
+{
+}
+
+void BenchmarkRunner::runBenchmarks (const Array<Benchmark*>& benchmarks)
+{
+    results.clear();
+    resultsUpdated();
+
+    for (auto* b : benchmarks)
+    {
+        if (shouldAbortBenchmarks())
+            break;
+
+        logMessage ("-----------------------------------------------------------------");
+        logMessage ("Starting benchmark: " + b->getName() + "...");
+
+       #if JUCE_EXCEPTIONS_DISABLED
+        b->performBenchmark (this);
+       #else
+        try
+        {
+            b->performBenchmark (this);
+        }
+        catch (...)
+        {
+            logMessage ("!!! An unhandled exception was thrown!");
+        }
+       #endif
+    }
+}
+
+void BenchmarkRunner::runAllBenchmarks()
+{
+    runBenchmarks (Benchmark::getAllBenchmarks());
+}
+
+void BenchmarkRunner::runBenchmarksInCategory (const String& category)
+{
+    runBenchmarks (Benchmark::getBenchmarksInCategory (category));
+}
+
+void BenchmarkRunner::logMessage (const String& message)
+{
+    Logger::writeToLog (message);
+}
+
+bool BenchmarkRunner::shouldAbortBenchmarks()
+{
+    return false;
+}
+
+void BenchmarkRunner::addResult (const Result& result)
+{
+    results.add (new Result (result));
+
+    String message;
+    message << "    " << result.measurementName << ": "
+            << String (result.medianNanoseconds, 1) << " ns (mean " << String (result.meanNanoseconds, 1)
+            << ", sd " << String (result.standardDeviationNanoseconds, 1) << ")";
+
+    if (result.itemsPerSecond > 0)
+        message << ", " << String (result.itemsPerSecond / 1.0e6, 2) << "M items/s";
+
+    if (result.meanAllocations > 0)
+        message << ", " << String (result.meanAllocations, 2) << " allocations";
+
+    logMessage (message);
+    resultsUpdated();
+}
+
+void BenchmarkRunner::writeResultsAsJSON (OutputStream& out) const
+{
+    Array<var> resultList;
+
+    for (auto* r : results)
+    {
+        DynamicObject::Ptr obj (new DynamicObject());
+        obj->setProperty ("benchmark",           r->benchmarkName);
+        obj->setProperty ("category",            r->category);
+        obj->setProperty ("measurement",         r->measurementName);
+        obj->setProperty ("samples",             r->numSamples);
+        obj->setProperty ("iterationsPerSample", r->iterationsPerSample);
+        obj->setProperty ("meanNs",              r->meanNanoseconds);
+        obj->setProperty ("medianNs",            r->medianNanoseconds);
+        obj->setProperty ("minNs",               r->minNanoseconds);
+        obj->setProperty ("maxNs",               r->maxNanoseconds);
+        obj->setProperty ("stdDevNs",            r->standardDeviationNanoseconds);
+
+        if (Benchmark::isCycleCounterAvailable())
+            obj->setProperty ("meanCycles", r->meanCycles);
+
+        if (r->meanAllocations >= 0)
+            obj->setProperty ("meanAllocations", r->meanAllocations);
+
+        if (r->itemsPerIteration > 0)
+        {
+            obj->setProperty ("itemsPerIteration", r->itemsPerIteration);
+            obj->setProperty ("itemsPerSecond",    r->itemsPerSecond);
+        }
+
+        resultList.add (var (obj.get()));
+    }
+
+    DynamicObject::Ptr system (new DynamicObject());
+    system->setProperty ("juceVersion",     SystemStats::getJUCEVersion());
+    system->setProperty ("operatingSystem", SystemStats::getOperatingSystemName());
+    system->setProperty ("cpuModel",        SystemStats::getCpuModel());
+    system->setProperty ("numCpus",         SystemStats::getNumCpus());
+    system->setProperty ("time",            Time::getCurrentTime().toISO8601 (true));
+   #if JUCE_DEBUG
+    system->setProperty ("debugBuild",      true);
+   #else
+    system->setProperty ("debugBuild",      false);
+   #endif
+
+    DynamicObject::Ptr root (new DynamicObject());
+    root->setProperty ("system",  var (system.get()));
+    root->setProperty ("results", resultList);
+
+    JSON::writeToStream (out, var (root.get()));
+    out << newLine;
+}
+
+void BenchmarkRunner::writeResultsAsCSV (OutputStream& out) const
+{
+    out << "benchmark,category,measurement,samples,iterationsPerSample,meanNs,medianNs,minNs,maxNs,stdDevNs,meanCycles,meanAllocations,itemsPerIteration,itemsPerSecond" << newLine;
+
+    for (auto* r : results)
+    {
+        out << BenchmarkHelpers::escapeForCSV (r->benchmarkName) << ','
+            << BenchmarkHelpers::escapeForCSV (r->category) << ','
+            << BenchmarkHelpers::escapeForCSV (r->measurementName) << ','
+            << r->numSamples << ',' << r->iterationsPerSample << ','
+            << r->meanNanoseconds << ',' << r->medianNanoseconds << ','
+            << r->minNanoseconds << ',' << r->maxNanoseconds << ','
+            << r->standardDeviationNanoseconds << ',';
+
+        if (Benchmark::isCycleCounterAvailable())
+            out << r->meanCycles;
+
+        out << ',';
+
+        if (r->meanAllocations >= 0)
+            out << r->meanAllocations;
+
+        out << ',';
+
+        if (r->itemsPerIteration > 0)
+            out << r->itemsPerIteration << ',' << r->itemsPerSecond;
+        else
+            out << ',';
+
+        out << newLine;
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class BenchmarkTests  : public UnitTest
+{
+public:
+    BenchmarkTests()
+        : UnitTest ("Benchmark", UnitTestCategories::performance)
+    {}
+
+    void runTest() override
+    {
+        struct TestBenchmark  : public Benchmark
+        {
+            TestBenchmark()  : Benchmark ("BenchmarkTests benchmark", "BenchmarkTests") {}
+
+            void runBenchmark() override
+            {
+                measure ("sum", [this]
+                {
+                    int total = 0;
+
+                    for (int i = 0; i < 100; ++i)
+                        total += i * numCalls;
+
+                    doNotOptimise (total);
+                    ++numCalls;
+                }, 100);
+
+                measure ("sleep", [] { Thread::sleep (1); });
+            }
+
+            int numCalls = 0;
+        };
+
+        TestBenchmark benchmark;
+
+        BenchmarkRunner benchmarkRunner;
+        benchmarkRunner.setWarmupTime (0.005);
+        benchmarkRunner.setMinimumSampleTime (0.002);
+        benchmarkRunner.setNumSamples (5);
+
+        beginTest ("Benchmarks are registered in their category");
+        {
+            expect (Benchmark::getAllBenchmarks().contains (&benchmark));
+            expect (Benchmark::getAllCategories().contains ("BenchmarkTests"));
+            expectEquals (Benchmark::getBenchmarksInCategory ("BenchmarkTests").size(), 1);
+        }
+
+        benchmarkRunner.runBenchmarksInCategory ("BenchmarkTests");
+
+        beginTest ("Each measurement produces consistent statistics");
+        {
+            expectEquals (benchmarkRunner.getNumResults(), 2);
+
+            if (benchmarkRunner.getNumResults() == 2)
+            {
+                const auto& sum = *benchmarkRunner.getResult (0);
+                expectEquals (sum.measurementName, String ("sum"));
+                expectEquals (sum.numSamples, 5);
+                expectGreaterThan (sum.iterationsPerSample, (int64) 1);
+                expectGreaterOrEqual ((int64) benchmark.numCalls, sum.iterationsPerSample * 5);
+                expect (sum.minNanoseconds <= sum.medianNanoseconds && sum.medianNanoseconds <= sum.maxNanoseconds);
+                expect (sum.minNanoseconds <= sum.meanNanoseconds && sum.meanNanoseconds <= sum.maxNanoseconds);
+                expectWithinAbsoluteError (sum.itemsPerSecond, 100.0e9 / sum.meanNanoseconds, sum.itemsPerSecond * 1.0e-9);
+
+                const auto& sleep = *benchmarkRunner.getResult (1);
+                expectGreaterOrEqual (sleep.minNanoseconds, 0.9e6);
+                expectEquals (sleep.itemsPerSecond, 0.0);
+
+                if (Benchmark::isCycleCounterAvailable())
+                    expectGreaterThan (sleep.meanCycles, 0.0);
+
+               #if JUCE_ENABLE_ALLOCATION_HOOKS
+                expectEquals (sum.meanAllocations, 0.0);
+               #else
+                expectEquals (sum.meanAllocations, -1.0);
+               #endif
+            }
+        }
+
+        beginTest ("Results can be written as JSON");
+        {
+            MemoryOutputStream out;
+            benchmarkRunner.writeResultsAsJSON (out);
+
+            const auto json = JSON::parse (out.toString());
+            expect (json["system"]["juceVersion"].toString().isNotEmpty());
+
+            if (auto* results = json["results"].getArray())
+            {
+                expectEquals (results->size(), 2);
+                expectEquals ((*results)[0]["measurement"].toString(), String ("sum"));
+                expectEquals ((int64) (*results)[0]["itemsPerIteration"], (int64) 100);
+                expect (! (*results)[1].hasProperty ("itemsPerIteration"));
+            }
+            else
+            {
+                expect (false, "missing results array");
+            }
+        }
+
+        beginTest ("Results can be written as CSV");
+        {
+            MemoryOutputStream out;
+            benchmarkRunner.writeResultsAsCSV (out);
+
+            StringArray lines;
+            lines.addLines (out.toString().trim());
+
+            expectEquals (lines.size(), 3);
+            expect (lines[0].startsWith ("benchmark,category,measurement,"));
+            expect (lines[1].startsWith ("BenchmarkTests benchmark,BenchmarkTests,sum,5,"));
+
+            for (auto& line : lines)
+                expectEquals (StringArray::fromTokens (line, ",", "\"").size(), 14);
+        }
+    }
+};
+
+static BenchmarkTests benchmarkTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,307 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class BenchmarkRunner;
+
+//==============================================================================
+/**
+    This is a base class for classes that measure the performance of some code.
+
+    To write a benchmark, your code should look something like this:
+
+    @code
+    class MyBenchmark  : public Benchmark
+    {
+    public:
+        MyBenchmark()  : Benchmark ("Foobar", "Foo") {}
+
+        void runBenchmark() override
+        {
+            Foobar foobar;
+
+            measure ("doSomething", [&] { doNotOptimise (foobar.doSomething()); });
+            measure ("process 512 items", [&] { foobar.process (buffer, 512); }, 512);
+        }
+    };
+
+    // Creating a static instance will automatically add the instance to the array
+    // returned by Benchmark::getAllBenchmarks(), so it will be included when you call
+    // BenchmarkRunner::runAllBenchmarks()
+    static MyBenchmark benchmark;
+    @endcode
+
+    Each call to measure() runs its function until it's warmed up, then times a number
+    of samples of it, each of which is long enough to be measured accurately, and adds
+    the statistics to the runner's results.
+
+    The benchmarks that come with JUCE are only compiled when JUCE_BENCHMARKS is
+    enabled, and can be run with the BenchmarkRunner console app in the extras folder.
+
+    @see BenchmarkRunner
+
+    @tags{Core}
+*/
+class JUCE_API  Benchmark
+{
+public:
+    //==============================================================================
+    /** Creates a benchmark with the given name and optionally places it in a category. */
+    explicit Benchmark (const String& name, const String& category = String());
+
+    /** Destructor. */
+    virtual ~Benchmark();
+
+    /** Returns the name of the benchmark. */
+    const String& getName() const noexcept       { return name; }
+
+    /** Returns the category of the benchmark. */
+    const String& getCategory() const noexcept   { return category; }
+
+    /** Runs the benchmark, using the specified BenchmarkRunner.
+        You shouldn't need to call this method directly - use
+        BenchmarkRunner::runBenchmarks() instead.
+    */
+    void performBenchmark (BenchmarkRunner* runner);
+
+    /** Returns the set of all Benchmark objects that currently exist. */
+    static Array<Benchmark*>& getAllBenchmarks();
+
+    /** Returns the set of Benchmarks in a specified category. */
+    static Array<Benchmark*> getBenchmarksInCategory (const String& category);
+
+    /** Returns a StringArray containing all of the categories of Benchmarks that have been registered. */
+    static StringArray getAllCategories();
+
+    //==============================================================================
+    /** You can optionally implement this method to set up your benchmark.
+        This method will be called before runBenchmark().
+    */
+    virtual void initialise();
+
+    /** You can optionally implement this method to clear up after your benchmark has been run.
+        This method will be called after runBenchmark() has returned.
+    */
+    virtual void shutdown();
+
+    /** Implement this method in your subclass to call measure() for each piece of
+        code that you want to time.
+    */
+    virtual void runBenchmark() = 0;
+
+    //==============================================================================
+    /** Times a function, and adds its statistics to the runner's results.
+
+        This should be called from your runBenchmark() method. The function is called
+        many times, so it should do the same amount of work each time.
+
+        If itemsPerIteration is greater than zero, the result will also include the
+        number of items processed per second, e.g. you could pass the number of
+        samples that the function processes.
+    */
+    template <typename FunctionType>
+    void measure (const String& measurementName, FunctionType&& function, int64 itemsPerIteration = 0)
+    {
+        measureIterations (measurementName, [&function] (int numIterations)
+                                            {
+                                                for (int i = 0; i < numIterations; ++i)
+                                                    function();
+                                            },
+                           itemsPerIteration);
+    }
+
+    /** Stops the compiler from optimising away the calculation of a value that
+        a benchmark would otherwise ignore.
+    */
+    template <typename Type>
+    static void doNotOptimise (const Type& value) noexcept
+    {
+       #if JUCE_GCC || JUCE_CLANG
+        asm volatile ("" : : "r" (&value) : "memory");
+       #else
+        volatileSink = static_cast<const void*> (&value);
+       #endif
+    }
+
+    //==============================================================================
+    /** Writes a message to the benchmark log.
+        This can only be called from within your runBenchmark() method.
+    */
+    void logMessage (const String& message);
+
+    /** Returns true if the results include cycle counts on this platform. */
+    static bool isCycleCounterAvailable() noexcept;
+
+    /** Returns true if the results include the number of allocations, which requires
+        JUCE_ENABLE_ALLOCATION_HOOKS to be enabled.
+    */
+    static bool isAllocationCountingAvailable() noexcept;
+
+private:
+    //==============================================================================
+    void measureIterations (const String&, std::function<void (int)>, int64);
+
+    static volatile const void* volatileSink;
+
+    const String name, category;
+    BenchmarkRunner* runner = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (Benchmark)
+};
+
+
+//==============================================================================
+/**
+    Runs a set of Benchmarks, and collects their results.
+
+    When you instantiate a BenchmarkRunner you can choose how long to warm up each
+    measurement and how many samples of it to take, then call runAllBenchmarks()
+    or runBenchmarks(). The results can be written out as JSON or CSV, so that they
+    can be compared between builds to track performance regressions.
+
+    @see Benchmark
+
+    @tags{Core}
+*/
+class JUCE_API  BenchmarkRunner
+{
+public:
+    //==============================================================================
+    /** */
+    BenchmarkRunner();
+
+    /** Destructor. */
+    virtual ~BenchmarkRunner();
+
+    /** Runs a set of benchmarks.
+        The benchmarks are performed in order, and the results are logged.
+    */
+    void runBenchmarks (const Array<Benchmark*>& benchmarks);
+
+    /** Runs all the Benchmark objects that currently exist. */
+    void runAllBenchmarks();
+
+    /** Runs all the Benchmark objects within a specified category. */
+    void runBenchmarksInCategory (const String& category);
+
+    /** Sets how long each measurement's function is run before it's timed.
+        The default is 0.1 seconds.
+    */
+    void setWarmupTime (double seconds) noexcept;
+
+    /** Sets the number of samples that are timed for each measurement.
+        The default is 20.
+    */
+    void setNumSamples (int numSamplesToTake) noexcept;
+
+    /** Sets the shortest time that a single sample can take. Each sample runs as many
+        iterations of the function as are needed to take at least this long.
+        The default is 0.01 seconds.
+    */
+    void setMinimumSampleTime (double seconds) noexcept;
+
+    //==============================================================================
+    /** Contains the statistics for one call to Benchmark::measure().
+
+        All the times and counts are per iteration of the measured function.
+    */
+    struct Result
+    {
+        /** The name of the Benchmark object that was run. */
+        String benchmarkName;
+        /** The category of the Benchmark object that was run. */
+        String category;
+        /** The name that was passed to Benchmark::measure(). */
+        String measurementName;
+
+        /** The number of samples that were timed. */
+        int numSamples = 0;
+        /** The number of times the function was called in each sample. */
+        int64 iterationsPerSample = 0;
+
+        /** The time taken by each iteration, in nanoseconds. */
+        double meanNanoseconds = 0, medianNanoseconds = 0,
+               minNanoseconds = 0, maxNanoseconds = 0,
+               standardDeviationNanoseconds = 0;
+
+        /** The mean number of CPU cycles, or 0 if isCycleCounterAvailable() is false. */
+        double meanCycles = 0;
+
+        /** The mean number of calls to new and delete, or -1 if isAllocationCountingAvailable() is false. */
+        double meanAllocations = -1;
+
+        /** The number of items that the function processed, as passed to Benchmark::measure(). */
+        int64 itemsPerIteration = 0;
+        /** The number of items processed per second, or 0 if itemsPerIteration is 0. */
+        double itemsPerSecond = 0;
+    };
+
+    /** Returns the number of results that have been collected. */
+    int getNumResults() const noexcept;
+
+    /** Returns one of the results that have been collected.
+        @see getNumResults
+    */
+    const Result* getResult (int index) const noexcept;
+
+    /** Writes the results as a JSON object, which also describes the system that
+        the benchmarks were run on.
+    */
+    void writeResultsAsJSON (OutputStream& output) const;
+
+    /** Writes the results as comma-separated values, with a header line. */
+    void writeResultsAsCSV (OutputStream& output) const;
+
+protected:
+    /** Called when the list of results changes.
+        You can override this to perform some sort of behaviour when results are added.
+    */
+    virtual void resultsUpdated();
+
+    /** Logs a message about the current benchmark progress.
+        By default this just writes the message to the Logger class, but you could override
+        this to do something else with the data.
+    */
+    virtual void logMessage (const String& message);
+
+    /** This can be overridden to let the runner know that it should abort the benchmarks
+        as soon as possible, e.g. because the thread needs to stop.
+    */
+    virtual bool shouldAbortBenchmarks();
+
+private:
+    //==============================================================================
+    friend class Benchmark;
+
+    void addResult (const Result&);
+
+    OwnedArray<Result> results;
+    double warmupSeconds = 0.1, minimumSampleSeconds = 0.01;
+    int numSamples = 20;
+
+    JUCE_DECLARE_NON_COPYABLE (BenchmarkRunner)
+};
+
+} // namespace juce
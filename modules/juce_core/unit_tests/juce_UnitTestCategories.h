@@ -42,6 +42,7 @@ namespace UnitTestCategories
     static const String midi                       { "MIDI" };
     static const String networking                 { "Networking" };
     static const String osc                        { "OSC" };
+    static const String performance                { "Performance" };
     static const String smoothedValues             { "SmoothedValues" };
     static const String streams                    { "Streams" };
     static const String text                       { "Text" };
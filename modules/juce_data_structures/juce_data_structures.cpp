@@ -45,3 +45,7 @@
 #if JUCE_UNIT_TESTS
  #include "values/juce_ValueTreePropertyWithDefault_test.cpp"
 #endif
+
+#if JUCE_BENCHMARKS
+ #include "values/juce_ValueTree_benchmark.cpp"
+#endif
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ValueTreeBenchmark  : public Benchmark
+{
+public:
+    ValueTreeBenchmark()
+        : Benchmark ("ValueTree", UnitTestCategories::values)
+    {}
+
+    void runBenchmark() override
+    {
+        constexpr int numChildren = 1000;
+
+        const Identifier rootType ("root"), childType ("child"),
+                         idProperty ("id"), nameProperty ("name"), gainProperty ("gain"), enabledProperty ("enabled");
+
+        ValueTree root (rootType);
+
+        for (int i = 0; i < numChildren; ++i)
+            root.appendChild (ValueTree (childType, { { idProperty,      i },
+                                                      { nameProperty,    "Child " + String (i) },
+                                                      { gainProperty,    i * 0.001 },
+                                                      { enabledProperty, (i & 1) != 0 } }),
+                              nullptr);
+
+        auto child = root.getChild (numChildren / 2);
+        int counter = 0;
+
+        measure ("setProperty", [&]
+        {
+            child.setProperty (gainProperty, ++counter, nullptr);
+        });
+
+        measure ("getProperty", [&]
+        {
+            doNotOptimise (child.getProperty (nameProperty));
+        });
+
+        measure ("getChildWithProperty (" + String (numChildren) + " children)", [&]
+        {
+            doNotOptimise (root.getChildWithProperty (idProperty, numChildren - 1));
+        }, numChildren);
+
+        measure ("appendChild and removeChild", [&]
+        {
+            ValueTree newChild (childType);
+            root.appendChild (newChild, nullptr);
+            root.removeChild (newChild, nullptr);
+        });
+
+        measure ("createCopy (" + String (numChildren) + " children)", [&]
+        {
+            doNotOptimise (root.createCopy());
+        }, numChildren);
+
+        measure ("writeToStream (" + String (numChildren) + " children)", [&]
+        {
+            MemoryOutputStream out;
+            root.writeToStream (out);
+            doNotOptimise (out.getDataSize());
+        }, numChildren);
+
+        MemoryOutputStream data;
+        root.writeToStream (data);
+
+        measure ("readFromData (" + String (numChildren) + " children)", [&]
+        {
+            doNotOptimise (ValueTree::readFromData (data.getData(), data.getDataSize()));
+        }, numChildren);
+
+        measure ("toXmlString (" + String (numChildren) + " children)", [&]
+        {
+            doNotOptimise (root.toXmlString());
+        }, numChildren);
+    }
+};
+
+static ValueTreeBenchmark valueTreeBenchmark;
+
+} // namespace juce
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct ConvolutionBenchmark  : public Benchmark
+{
+    ConvolutionBenchmark()
+        : Benchmark ("Convolution", UnitTestCategories::dsp)
+    {}
+
+    void runBenchmark() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 512;
+        const ProcessSpec spec { sampleRate, (uint32) blockSize, 2 };
+
+        for (auto irLength : { 1024, 16384 })
+        {
+            for (auto isNonUniform : { false, true })
+            {
+                auto convolution = isNonUniform ? std::make_unique<Convolution> (Convolution::NonUniform { 256 })
+                                                : std::make_unique<Convolution>();
+                convolution->loadImpulseResponse (makeImpulseResponse (irLength, sampleRate), sampleRate,
+                                                  Convolution::Stereo::yes, Convolution::Trim::no,
+                                                  Convolution::Normalise::yes);
+                convolution->prepare (spec);
+
+                AudioBuffer<float> buffer ((int) spec.numChannels, blockSize);
+                AudioBlock<float> block (buffer);
+                const ProcessContextReplacing<float> context (block);
+
+                fillWithNoise (buffer);
+
+                // the impulse response may still be loading in the background
+                for (auto start = Time::getMillisecondCounter();
+                     convolution->getCurrentIRSize() != irLength && Time::getMillisecondCounter() - start < 10000;)
+                {
+                    convolution->process (context);
+                    Thread::sleep (1);
+                }
+
+                if (convolution->getCurrentIRSize() != irLength)
+                {
+                    logMessage ("!!! The impulse response wasn't loaded");
+                    continue;
+                }
+
+                measure (String (isNonUniform ? "process non-uniform" : "process uniform") + " (" + String (irLength) + " sample IR, "
+                           + String (blockSize) + " sample blocks)",
+                         [&]
+                         {
+                             convolution->process (context);
+                             doNotOptimise (buffer);
+                         },
+                         blockSize);
+            }
+        }
+    }
+
+    static void fillWithNoise (AudioBuffer<float>& buffer)
+    {
+        Random random (1);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    static AudioBuffer<float> makeImpulseResponse (int length, double sampleRate)
+    {
+        AudioBuffer<float> ir (2, length);
+        fillWithNoise (ir);
+
+        // a decaying noise tail, like a reverb
+        for (int i = 0; i < length; ++i)
+        {
+            const auto gain = (float) std::exp (-6.0 * i / sampleRate);
+
+            for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+                ir.setSample (ch, i, ir.getSample (ch, i) * gain);
+        }
+
+        return ir;
+    }
+};
+
+static ConvolutionBenchmark convolutionBenchmark;
+
+} // namespace dsp
+} // namespace juce
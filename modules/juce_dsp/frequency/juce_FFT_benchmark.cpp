@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct FFTBenchmark  : public Benchmark
+{
+    FFTBenchmark()
+        : Benchmark ("FFT", UnitTestCategories::dsp)
+    {}
+
+    void runBenchmark() override
+    {
+        for (auto order : { 8, 10, 12 })
+        {
+            FFT fft (order);
+            const auto size = fft.getSize();
+            const auto suffix = " (" + String (size) + " points)";
+
+            Random random (order);
+            HeapBlock<Complex<float>> complexInput ((size_t) size), complexOutput ((size_t) size);
+
+            for (int i = 0; i < size; ++i)
+                complexInput[i] = { random.nextFloat() * 2.0f - 1.0f, random.nextFloat() * 2.0f - 1.0f };
+
+            std::vector<float> realData ((size_t) size * 2);
+
+            measure ("perform" + suffix, [&]
+            {
+                fft.perform (complexInput, complexOutput, false);
+                doNotOptimise (complexOutput);
+            }, size);
+
+            measure ("performRealOnlyForwardTransform" + suffix, [&]
+            {
+                for (int i = 0; i < size; ++i)
+                    realData[(size_t) i] = complexInput[i].real();
+
+                fft.performRealOnlyForwardTransform (realData.data());
+                doNotOptimise (realData);
+            }, size);
+
+            measure ("performRealOnlyInverseTransform" + suffix, [&]
+            {
+                for (int i = 0; i < size; ++i)
+                    reinterpret_cast<Complex<float>*> (realData.data())[i] = complexInput[i];
+
+                fft.performRealOnlyInverseTransform (realData.data());
+                doNotOptimise (realData);
+            }, size);
+
+            measure ("performFrequencyOnlyForwardTransform" + suffix, [&]
+            {
+                for (int i = 0; i < size; ++i)
+                    realData[(size_t) i] = complexInput[i].real();
+
+                fft.performFrequencyOnlyForwardTransform (realData.data());
+                doNotOptimise (realData);
+            }, size);
+        }
+    }
+};
+
+static FFTBenchmark fftBenchmark;
+
+} // namespace dsp
+} // namespace juce
@@ -77,6 +77,7 @@
 #include "widgets/juce_Limiter.cpp"
 #include "widgets/juce_Phaser.cpp"
 #include "widgets/juce_Chorus.cpp"
+#include "widgets/juce_WavetableOscillator.cpp"
 
 #if JUCE_USE_SIMD
  #if defined(__i386__) || defined(__amd64__) || defined(_M_X64) || defined(_X86_) || defined(_M_IX86)
@@ -104,6 +105,14 @@
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "processors/juce_DelayLine_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_Oversampling_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "widgets/juce_WavetableOscillator_test.cpp"
+#endif
+
+#if JUCE_BENCHMARKS
+ #include "frequency/juce_Convolution_benchmark.cpp"
+ #include "frequency/juce_FFT_benchmark.cpp"
 #endif
@@ -245,6 +245,7 @@ namespace juce
 #include "maths/juce_LogRampedValue.h"
 #include "containers/juce_AudioBlock.h"
 #include "containers/juce_FixedSizeFunction.h"
+#include "frequency/juce_FFT.h"
 #include "processors/juce_ProcessContext.h"
 #include "processors/juce_ProcessorWrapper.h"
 #include "processors/juce_ProcessorChain.h"
@@ -260,7 +261,6 @@ namespace juce
 #include "processors/juce_LinkwitzRileyFilter.h"
 #include "processors/juce_DryWetMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
-#include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
 #include "filter_design/juce_FilterDesign.h"
@@ -269,6 +269,7 @@ namespace juce
 #include "widgets/juce_Gain.h"
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
+#include "widgets/juce_WavetableOscillator.h"
 #include "widgets/juce_LadderFilter.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
@@ -71,6 +71,11 @@ void DelayLine<SampleType, InterpolationType>::prepare (const ProcessSpec& spec)
 {
     jassert (spec.numChannels > 0);
 
+    // leave enough room in the buffer to push a whole block before reading any of it
+    auto maximumDelay = getMaximumDelayInSamples();
+    blockHeadroom = (int) spec.maximumBlockSize;
+    totalSize = jmax (4, maximumDelay + 1) + blockHeadroom;
+
     bufferData.setSize ((int) spec.numChannels, totalSize, false, false, true);
 
     writePos.resize (spec.numChannels);
@@ -86,7 +91,7 @@ template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::setMaximumDelayInSamples (int maxDelayInSamples)
 {
     jassert (maxDelayInSamples >= 0);
-    totalSize = jmax (4, maxDelayInSamples + 1);
+    totalSize = jmax (4, maxDelayInSamples + 1) + blockHeadroom;
     bufferData.setSize ((int) bufferData.getNumChannels(), totalSize, false, false, true);
     reset();
 }
@@ -116,7 +121,7 @@ SampleType DelayLine<SampleType, InterpolationType>::popSample (int channel, Sam
     if (delayInSamples >= 0)
         setDelay(delayInSamples);
 
-    auto result = interpolateSample (channel);
+    auto result = interpolateSample (channel, readPos[(size_t) channel] + delayInt);
 
     if (updateReadPointer)
         readPos[(size_t) channel] = (readPos[(size_t) channel] + totalSize - 1) % totalSize;
@@ -124,6 +129,128 @@ SampleType DelayLine<SampleType, InterpolationType>::popSample (int channel, Sam
     return result;
 }
 
+//==============================================================================
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::pushBlock (int channel, const SampleType* samples, int numSamples)
+{
+    // The block is bigger than the maximumBlockSize that was passed to prepare()!
+    jassert (numSamples <= jmax (1, blockHeadroom));
+
+    auto* buffer = bufferData.getWritePointer (channel);
+    auto& position = writePos[(size_t) channel];
+
+    while (numSamples > 0)
+    {
+        // the buffer is filled backwards, so copy as much as will fit below the write position
+        auto num = jmin (numSamples, position + 1);
+        std::reverse_copy (samples, samples + num, buffer + position + 1 - num);
+
+        samples += num;
+        numSamples -= num;
+        position = (position - num + totalSize) % totalSize;
+    }
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popBlock (int channel, SampleType* destination, int numSamples, bool updateReadPointer)
+{
+    auto& position = readPos[(size_t) channel];
+    auto index = (position + delayInt) % totalSize;
+
+    for (int i = 0; i < numSamples;)
+    {
+        if (index <= totalSize - (int) numInterpolationPoints)
+        {
+            auto num = jmin (numSamples - i, index + 1);
+            interpolateBlock (channel, index, destination + i, num);
+            i += num;
+            index -= num;
+        }
+        else
+        {
+            // this one's taps straddle the end of the buffer
+            destination[i++] = interpolateSample (channel, index--);
+        }
+
+        if (index < 0)
+            index += totalSize;
+    }
+
+    if (updateReadPointer)
+        position = ((position - numSamples) % totalSize + totalSize) % totalSize;
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popBlock (int channel, SampleType* destination, const SampleType* delaysInSamples,
+                                                         int numSamples, bool updateReadPointer)
+{
+    if (numSamples <= 0)
+        return;
+
+    auto& position = readPos[(size_t) channel];
+    auto* samples = bufferData.getReadPointer (channel);
+    auto upperLimit = (SampleType) getMaximumDelayInSamples();
+
+    ModulatedChunk chunk;
+
+    for (int start = 0; start < numSamples; start += (int) modulatedChunkSize)
+    {
+        auto num = jmin ((int) modulatedChunkSize, numSamples - start);
+
+        // first split the delays into whole and fractional parts..
+        for (int i = 0; i < num; ++i)
+        {
+            auto delayValue = jlimit ((SampleType) 0, upperLimit, delaysInSamples[start + i]);
+            auto wholeDelay = static_cast<int> (delayValue);
+            auto fraction = delayValue - (SampleType) wholeDelay;
+
+            adjustChunkDelay (wholeDelay, fraction, chunk.alphas[i], InterpolationType{});
+
+            chunk.indices[i] = position - (start + i) + wholeDelay;
+            chunk.fractions[i] = fraction;
+        }
+
+        // ..then gather the samples for each tap..
+        for (int i = 0; i < num; ++i)
+        {
+            auto index = chunk.indices[i];
+
+            if (index < 0)           index += totalSize;
+            if (index >= totalSize)  index -= totalSize;
+
+            for (int tap = 0; tap < (int) numInterpolationPoints; ++tap)
+                chunk.taps[tap][i] = samples[index + tap < totalSize ? index + tap : index + tap - totalSize];
+        }
+
+        // ..and then interpolate them all in one go
+        interpolateChunk (channel, chunk, destination + start, num);
+    }
+
+    setDelay (jlimit ((SampleType) 0, upperLimit, delaysInSamples[numSamples - 1]));
+
+    if (updateReadPointer)
+        position = ((position - numSamples) % totalSize + totalSize) % totalSize;
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popMultiTapBlock (int channel, SampleType* const* destinations,
+                                                                 const SampleType* tapDelaysInSamples,
+                                                                 int numTaps, int numSamples)
+{
+    auto originalDelay = delay;
+
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        setDelay (tapDelaysInSamples[tap]);
+        popBlock (channel, destinations[tap], numSamples, false);
+    }
+
+    setDelay (originalDelay);
+
+    auto& position = readPos[(size_t) channel];
+    position = ((position - numSamples) % totalSize + totalSize) % totalSize;
+}
+
 //==============================================================================
 template class DelayLine<float,  DelayLineInterpolationTypes::None>;
 template class DelayLine<double, DelayLineInterpolationTypes::None>;
@@ -125,7 +125,7 @@ public:
         For very short delay times, the result of getMaximumDelayInSamples() may
         differ from the last value passed to setMaximumDelayInSamples().
     */
-    int getMaximumDelayInSamples() const noexcept       { return totalSize - 1; }
+    int getMaximumDelayInSamples() const noexcept       { return totalSize - 1 - blockHeadroom; }
 
     /** Resets the internal state variables of the processor. */
     void reset();
@@ -160,6 +160,73 @@ public:
     */
     SampleType popSample (int channel, SampleType delayInSamples = -1, bool updateReadPointer = true);
 
+    //==============================================================================
+    /** Pushes a block of samples into one channel of the delay line.
+
+        This does the same thing as calling pushSample for each sample, but copies
+        the data in as few contiguous runs as possible. Follow it with a call to
+        popBlock with the same number of samples.
+
+        The number of samples mustn't be more than the maximumBlockSize of the
+        ProcessSpec that was passed to prepare(), as the extra space needed to hold
+        a whole block is reserved there.
+
+        @see popBlock, pushSample
+    */
+    void pushBlock (int channel, const SampleType* samples, int numSamples);
+
+    /** Pops a block of samples from one channel of the delay line, using the delay
+        that was set with setDelay.
+
+        @param channel              the target channel for the delay line.
+        @param destination          the buffer to write the samples to.
+        @param numSamples           the number of samples to read.
+        @param updateReadPointer    should be set to true if this is the only read of
+                                    this block, or false if you need to read several taps
+                                    from the same block.
+
+        @see pushBlock, popSample
+    */
+    void popBlock (int channel, SampleType* destination, int numSamples, bool updateReadPointer = true);
+
+    /** Pops a block of samples from one channel of the delay line, with a different
+        delay for each sample.
+
+        This is the block equivalent of calling popSample with a delay for each sample,
+        and is useful for modulation effects like chorus and flanging. Afterwards, the
+        delay will be set to the last value in the array.
+
+        @param channel              the target channel for the delay line.
+        @param destination          the buffer to write the samples to.
+        @param delaysInSamples      the fractional delay to use for each sample.
+        @param numSamples           the number of samples to read.
+        @param updateReadPointer    should be set to true if this is the only read of
+                                    this block, or false if you need to read several taps
+                                    from the same block.
+
+        @see pushBlock, popSample
+    */
+    void popBlock (int channel, SampleType* destination, const SampleType* delaysInSamples,
+                   int numSamples, bool updateReadPointer = true);
+
+    /** Reads several taps from the most recently pushed block of one channel, each
+        with its own fixed delay, and then moves the read position on to the next block.
+
+        The delay that was set with setDelay isn't changed by this. As the Thiran
+        interpolator keeps some state for each channel, you shouldn't use it for
+        multi-tap reads.
+
+        @param channel              the target channel for the delay line.
+        @param destinations         an array of numTaps buffers to write the taps to.
+        @param tapDelaysInSamples   an array of numTaps fractional delays.
+        @param numTaps              the number of taps to read.
+        @param numSamples           the number of samples to read for each tap.
+
+        @see pushBlock, popBlock
+    */
+    void popMultiTapBlock (int channel, SampleType* const* destinations, const SampleType* tapDelaysInSamples,
+                           int numTaps, int numSamples);
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context.
 
@@ -186,6 +253,17 @@ public:
             return;
         }
 
+        if (numSamples <= (size_t) jmax (1, blockHeadroom))
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                pushBlock ((int) channel, inputBlock.getChannelPointer (channel), (int) numSamples);
+                popBlock ((int) channel, outputBlock.getChannelPointer (channel), (int) numSamples);
+            }
+
+            return;
+        }
+
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
             auto* inputSamples = inputBlock.getChannelPointer (channel);
@@ -203,17 +281,15 @@ private:
     //==============================================================================
     template <typename T = InterpolationType>
     typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::None>::value, SampleType>::type
-    interpolateSample (int channel) const
+    interpolateSample (int channel, int index) const
     {
-        auto index = (readPos[(size_t) channel] + delayInt) % totalSize;
-        return bufferData.getSample (channel, index);
+        return bufferData.getSample (channel, index % totalSize);
     }
 
     template <typename T = InterpolationType>
     typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Linear>::value, SampleType>::type
-    interpolateSample (int channel) const
+    interpolateSample (int channel, int index1) const
     {
-        auto index1 = readPos[(size_t) channel] + delayInt;
         auto index2 = index1 + 1;
 
         if (index2 >= totalSize)
@@ -230,9 +306,8 @@ private:
 
     template <typename T = InterpolationType>
     typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Lagrange3rd>::value, SampleType>::type
-    interpolateSample (int channel) const
+    interpolateSample (int channel, int index1) const
     {
-        auto index1 = readPos[(size_t) channel] + delayInt;
         auto index2 = index1 + 1;
         auto index3 = index2 + 1;
         auto index4 = index3 + 1;
@@ -266,9 +341,8 @@ private:
 
     template <typename T = InterpolationType>
     typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Thiran>::value, SampleType>::type
-    interpolateSample (int channel)
+    interpolateSample (int channel, int index1)
     {
-        auto index1 = readPos[(size_t) channel] + delayInt;
         auto index2 = index1 + 1;
 
         if (index2 >= totalSize)
@@ -286,6 +360,166 @@ private:
         return output;
     }
 
+    //==============================================================================
+    /*  These read a run of samples whose taps are all far enough from the end of the
+        buffer that they don't need to wrap around. The buffer is filled backwards, so
+        each output sample comes from one index lower than the one before it.
+    */
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::None>::value, void>::type
+    interpolateBlock (int channel, int index, SampleType* dest, int numSamples) const
+    {
+        auto* samples = bufferData.getReadPointer (channel) + index;
+
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = samples[-i];
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Linear>::value, void>::type
+    interpolateBlock (int channel, int index, SampleType* dest, int numSamples) const
+    {
+        auto* samples = bufferData.getReadPointer (channel) + index;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto value1 = samples[-i];
+            auto value2 = samples[1 - i];
+
+            dest[i] = value1 + delayFrac * (value2 - value1);
+        }
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Lagrange3rd>::value, void>::type
+    interpolateBlock (int channel, int index, SampleType* dest, int numSamples) const
+    {
+        auto* samples = bufferData.getReadPointer (channel) + index;
+
+        auto d1 = delayFrac - 1.f;
+        auto d2 = delayFrac - 2.f;
+        auto d3 = delayFrac - 3.f;
+
+        auto c1 = -d1 * d2 * d3 / 6.f;
+        auto c2 = d2 * d3 * 0.5f;
+        auto c3 = -d1 * d3 * 0.5f;
+        auto c4 = d1 * d2 / 6.f;
+
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = samples[-i] * c1 + delayFrac * (samples[1 - i] * c2 + samples[2 - i] * c3 + samples[3 - i] * c4);
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Thiran>::value, void>::type
+    interpolateBlock (int channel, int index, SampleType* dest, int numSamples)
+    {
+        auto* samples = bufferData.getReadPointer (channel) + index;
+        auto state = v[(size_t) channel];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto value1 = samples[-i];
+            auto value2 = samples[1 - i];
+
+            state = delayFrac == 0 ? value1 : value2 + alpha * (value1 - state);
+            dest[i] = state;
+        }
+
+        v[(size_t) channel] = state;
+    }
+
+    //==============================================================================
+    static constexpr size_t numInterpolationPoints = std::is_same<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>::value ? 4
+                                                  : (std::is_same<InterpolationType, DelayLineInterpolationTypes::None>::value ? 1 : 2);
+
+    static constexpr size_t modulatedChunkSize = 64;
+
+    /*  Holds the values of the taps that have been gathered for a chunk of modulated
+        reads, so that the interpolation can be done as a separate pass.
+    */
+    struct ModulatedChunk
+    {
+        int indices[modulatedChunkSize];
+        SampleType fractions[modulatedChunkSize], alphas[modulatedChunkSize];
+        SampleType taps[numInterpolationPoints][modulatedChunkSize];
+    };
+
+    // The equivalents of updateInternalVariables for a single modulated read
+    template <typename OtherType>
+    static void adjustChunkDelay (int&, SampleType&, SampleType&, OtherType) {}
+
+    static void adjustChunkDelay (int& wholeDelay, SampleType& fraction, SampleType&, DelayLineInterpolationTypes::Lagrange3rd)
+    {
+        if (wholeDelay >= 1)
+        {
+            fraction++;
+            wholeDelay--;
+        }
+    }
+
+    static void adjustChunkDelay (int& wholeDelay, SampleType& fraction, SampleType& alphaValue, DelayLineInterpolationTypes::Thiran)
+    {
+        if (fraction < (SampleType) 0.618 && wholeDelay >= 1)
+        {
+            fraction++;
+            wholeDelay--;
+        }
+
+        alphaValue = (1 - fraction) / (1 + fraction);
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::None>::value, void>::type
+    interpolateChunk (int, const ModulatedChunk& chunk, SampleType* dest, int numSamples) const
+    {
+        std::copy (chunk.taps[0], chunk.taps[0] + numSamples, dest);
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Linear>::value, void>::type
+    interpolateChunk (int, const ModulatedChunk& chunk, SampleType* dest, int numSamples) const
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = chunk.taps[0][i] + chunk.fractions[i] * (chunk.taps[1][i] - chunk.taps[0][i]);
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Lagrange3rd>::value, void>::type
+    interpolateChunk (int, const ModulatedChunk& chunk, SampleType* dest, int numSamples) const
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto fraction = chunk.fractions[i];
+
+            auto d1 = fraction - 1.f;
+            auto d2 = fraction - 2.f;
+            auto d3 = fraction - 3.f;
+
+            auto c1 = -d1 * d2 * d3 / 6.f;
+            auto c2 = d2 * d3 * 0.5f;
+            auto c3 = -d1 * d3 * 0.5f;
+            auto c4 = d1 * d2 / 6.f;
+
+            dest[i] = chunk.taps[0][i] * c1 + fraction * (chunk.taps[1][i] * c2 + chunk.taps[2][i] * c3 + chunk.taps[3][i] * c4);
+        }
+    }
+
+    template <typename T = InterpolationType>
+    typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::Thiran>::value, void>::type
+    interpolateChunk (int channel, const ModulatedChunk& chunk, SampleType* dest, int numSamples)
+    {
+        auto state = v[(size_t) channel];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            state = chunk.fractions[i] == 0 ? chunk.taps[0][i]
+                                            : chunk.taps[1][i] + chunk.alphas[i] * (chunk.taps[0][i] - state);
+            dest[i] = state;
+        }
+
+        v[(size_t) channel] = state;
+    }
+
     //==============================================================================
     template <typename T = InterpolationType>
     typename std::enable_if <std::is_same <T, DelayLineInterpolationTypes::None>::value, void>::type
@@ -331,7 +565,7 @@ private:
     std::vector<SampleType> v;
     std::vector<int> writePos, readPos;
     SampleType delay = 0.0, delayFrac = 0.0;
-    int delayInt = 0, totalSize = 4;
+    int delayInt = 0, totalSize = 4, blockHeadroom = 0;
     SampleType alpha = 0.0;
 };
 
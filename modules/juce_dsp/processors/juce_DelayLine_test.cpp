@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class DelayLineTests  : public UnitTest
+{
+public:
+    DelayLineTests()
+        : UnitTest ("DelayLine", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        runTestsForInterpolation<DelayLineInterpolationTypes::None>        ("no interpolation");
+        runTestsForInterpolation<DelayLineInterpolationTypes::Linear>      ("linear interpolation");
+        runTestsForInterpolation<DelayLineInterpolationTypes::Lagrange3rd> ("Lagrange interpolation");
+        runTestsForInterpolation<DelayLineInterpolationTypes::Thiran>      ("Thiran interpolation");
+    }
+
+private:
+    static constexpr int maxDelay = 300, blockSize = 128, numBlocks = 20;
+
+    template <typename InterpolationType>
+    void runTestsForInterpolation (const String& interpolationName)
+    {
+        const ProcessSpec spec { 44100.0, (uint32) blockSize, 2 };
+        auto random = getRandom();
+
+        AudioBuffer<float> input (2, blockSize * numBlocks);
+
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+            for (int i = 0; i < input.getNumSamples(); ++i)
+                input.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        beginTest ("Block processing matches sample processing, with " + interpolationName);
+        {
+            DelayLine<float, InterpolationType> blockDelay (maxDelay), sampleDelay (maxDelay);
+
+            for (auto* d : { &blockDelay, &sampleDelay })
+            {
+                d->prepare (spec);
+                d->setDelay (123.4f);
+            }
+
+            AudioBuffer<float> output (input.getNumChannels(), blockSize);
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                // (use a short block now and then, so that the positions wrap around at odd places)
+                auto num = block % 3 == 2 ? blockSize / 3 : blockSize;
+                auto offset = block * blockSize;
+
+                AudioBlock<const float> inBlock (input.getArrayOfReadPointers(), 2, (size_t) offset, (size_t) num);
+                AudioBlock<float> outBlock (output.getArrayOfWritePointers(), 2, 0, (size_t) num);
+                blockDelay.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    for (int i = 0; i < num; ++i)
+                    {
+                        sampleDelay.pushSample (ch, input.getSample (ch, offset + i));
+                        expectWithinAbsoluteError (output.getSample (ch, i), sampleDelay.popSample (ch), 1.0e-6f);
+                    }
+                }
+            }
+        }
+
+        beginTest ("Modulated block reads match modulated sample reads, with " + interpolationName);
+        {
+            DelayLine<float, InterpolationType> blockDelay (maxDelay), sampleDelay (maxDelay);
+
+            for (auto* d : { &blockDelay, &sampleDelay })
+                d->prepare (spec);
+
+            std::vector<float> delays ((size_t) blockSize), output ((size_t) blockSize);
+            auto phase = 0.0f;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                auto num = block % 3 == 2 ? blockSize / 3 : blockSize;
+                auto offset = block * blockSize;
+
+                for (auto& delay : delays)
+                {
+                    delay = 150.0f + 140.0f * std::sin (phase);
+                    phase += 0.01f;
+                }
+
+                blockDelay.pushBlock (0, input.getReadPointer (0, offset), num);
+                blockDelay.popBlock (0, output.data(), delays.data(), num);
+
+                for (int i = 0; i < num; ++i)
+                {
+                    sampleDelay.pushSample (0, input.getSample (0, offset + i));
+                    expectWithinAbsoluteError (output[(size_t) i], sampleDelay.popSample (0, delays[(size_t) i]), 1.0e-6f);
+                }
+
+                expectEquals (blockDelay.getDelay(), sampleDelay.getDelay());
+            }
+        }
+
+        if (! std::is_same<InterpolationType, DelayLineInterpolationTypes::Thiran>::value)
+        {
+            beginTest ("Multi-tap block reads match multi-tap sample reads, with " + interpolationName);
+
+            DelayLine<float, InterpolationType> blockDelay (maxDelay), sampleDelay (maxDelay);
+
+            for (auto* d : { &blockDelay, &sampleDelay })
+            {
+                d->prepare (spec);
+                d->setDelay (10.0f);
+            }
+
+            const float tapDelays[] = { 0.0f, 17.25f, 64.5f, 299.0f };
+            constexpr int numTaps = numElementsInArray (tapDelays);
+
+            AudioBuffer<float> taps (numTaps, blockSize);
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                auto offset = block * blockSize;
+
+                blockDelay.pushBlock (0, input.getReadPointer (0, offset), blockSize);
+                blockDelay.popMultiTapBlock (0, taps.getArrayOfWritePointers(), tapDelays, numTaps, blockSize);
+
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    sampleDelay.pushSample (0, input.getSample (0, offset + i));
+
+                    for (int tap = 0; tap < numTaps; ++tap)
+                        expectWithinAbsoluteError (taps.getSample (tap, i), sampleDelay.popSample (0, tapDelays[tap], false), 1.0e-6f);
+
+                    sampleDelay.popSample (0, 10.0f);
+                }
+
+                expectEquals (blockDelay.getDelay(), 10.0f);
+            }
+        }
+    }
+};
+
+static DelayLineTests delayLineTests;
+
+} // namespace dsp
+} // namespace juce
@@ -153,6 +153,217 @@ void FIR::Coefficients<NumericType>::Coefficients::normalise() noexcept
     FloatVectorOperations::multiply (coefs, magnitudeInv, static_cast<int> (n));
 }
 
+//==============================================================================
+struct FIR::PartitionedConvolutionEngine::KernelUpdateThread  : public TimeSliceThread
+{
+    KernelUpdateThread()   : TimeSliceThread ("FIR kernel updates")   { startThread (3); }
+    ~KernelUpdateThread() override                                     { stopThread (-1); }
+};
+
+FIR::PartitionedConvolutionEngine::PartitionedConvolutionEngine (const float* coefficients, size_t numCoefficientsToUse,
+                                                                size_t partitionSize)
+    : numCoefficients (numCoefficientsToUse),
+      blockSize ((size_t) nextPowerOfTwo ((int) jmax ((size_t) 16, partitionSize))),
+      numPartitions ((numCoefficients + blockSize - 1) / blockSize),
+      numBins (blockSize + 1),
+      fft (roundToInt (std::log2 (2 * blockSize))),
+      currentCoefficients (coefficients, coefficients + numCoefficients),
+      spectraReal (numPartitions * numBins), spectraImag (numPartitions * numBins),
+      historyReal (numPartitions * numBins), historyImag (numPartitions * numBins),
+      sumReal (numBins), sumImag (numBins),
+      scratch (4 * blockSize),
+      inputBuffer (2 * blockSize),
+      outputBuffer (blockSize),
+      pendingReal (numPartitions * numBins), pendingImag (numPartitions * numBins),
+      kernelScratch (4 * blockSize)
+{
+    jassert (numCoefficients > 0);
+
+    calculateSpectra (spectraReal, spectraImag, scratch);
+    reset (coefficients);
+
+    kernelUpdateThread->addTimeSliceClient (this);
+}
+
+FIR::PartitionedConvolutionEngine::~PartitionedConvolutionEngine()
+{
+    kernelUpdateThread->removeTimeSliceClient (this);
+}
+
+void FIR::PartitionedConvolutionEngine::reset (const float* coefficients) noexcept
+{
+    auto wasUpdating = cancelKernelUpdate();
+
+    if (wasUpdating || ! std::equal (currentCoefficients.begin(), currentCoefficients.end(), coefficients))
+    {
+        std::copy (coefficients, coefficients + numCoefficients, currentCoefficients.begin());
+        calculateSpectra (spectraReal, spectraImag, scratch);
+    }
+
+    std::fill (historyReal.begin(), historyReal.end(), 0.0f);
+    std::fill (historyImag.begin(), historyImag.end(), 0.0f);
+    std::fill (inputBuffer.begin(), inputBuffer.end(), 0.0f);
+    std::fill (outputBuffer.begin(), outputBuffer.end(), 0.0f);
+
+    historyPosition = 0;
+    fill = 0;
+}
+
+bool FIR::PartitionedConvolutionEngine::cancelKernelUpdate() noexcept
+{
+    // waits for the background thread if it's in the middle of working out a kernel
+    for (;;)
+    {
+        auto state = kernelState.load();
+
+        if (state == computing)
+            Thread::yield();
+        else if (kernelState.compare_exchange_weak (state, idle))
+            return state != idle;
+    }
+}
+
+int FIR::PartitionedConvolutionEngine::useTimeSlice()
+{
+    auto expected = (int) requested;
+
+    if (! kernelState.compare_exchange_strong (expected, computing))
+        return 10;
+
+    calculateSpectra (pendingReal, pendingImag, kernelScratch);
+    kernelState = ready;
+    return 0;
+}
+
+void FIR::PartitionedConvolutionEngine::calculateSpectra (std::vector<float>& real, std::vector<float>& imag,
+                                                          std::vector<float>& workspace) const noexcept
+{
+    // Each partition of the kernel is zero-padded to twice the block size, so that
+    // the circular convolution of the FFT gives the linear one in its second half
+    for (size_t p = 0; p < numPartitions; ++p)
+    {
+        auto start = p * blockSize;
+        auto num = jmin (blockSize, numCoefficients - start);
+
+        std::fill (workspace.begin(), workspace.end(), 0.0f);
+        std::copy (currentCoefficients.begin() + (int) start, currentCoefficients.begin() + (int) (start + num), workspace.begin());
+
+        fft.performRealOnlyForwardTransform (workspace.data(), true);
+
+        for (size_t bin = 0; bin < numBins; ++bin)
+        {
+            real[p * numBins + bin] = workspace[2 * bin];
+            imag[p * numBins + bin] = workspace[2 * bin + 1];
+        }
+    }
+}
+
+void FIR::PartitionedConvolutionEngine::processBlock (const float* coefficients) noexcept
+{
+    // A kernel that the background thread has finished with replaces the old one..
+    if (kernelState.load() == ready)
+    {
+        std::swap (spectraReal, pendingReal);
+        std::swap (spectraImag, pendingImag);
+        kernelState = idle;
+    }
+
+    // ..and if the coefficients have been changed since the last block, the background
+    // thread is asked to work out the new one, while this block still uses the old kernel
+    if (kernelState.load() == idle
+         && ! std::equal (currentCoefficients.begin(), currentCoefficients.end(), coefficients))
+    {
+        std::copy (coefficients, coefficients + numCoefficients, currentCoefficients.begin());
+        kernelState = requested;
+    }
+
+    // The last two blocks of input go into the frequency-domain delay line..
+    std::copy (inputBuffer.begin(), inputBuffer.end(), scratch.begin());
+    std::fill (scratch.begin() + (int) (2 * blockSize), scratch.end(), 0.0f);
+    fft.performRealOnlyForwardTransform (scratch.data(), true);
+
+    historyPosition = (historyPosition == 0 ? numPartitions : historyPosition) - 1;
+    auto* newReal = historyReal.data() + historyPosition * numBins;
+    auto* newImag = historyImag.data() + historyPosition * numBins;
+
+    for (size_t bin = 0; bin < numBins; ++bin)
+    {
+        newReal[bin] = scratch[2 * bin];
+        newImag[bin] = scratch[2 * bin + 1];
+    }
+
+    // ..where each older spectrum is multiplied by the matching kernel partition
+    std::fill (sumReal.begin(), sumReal.end(), 0.0f);
+    std::fill (sumImag.begin(), sumImag.end(), 0.0f);
+
+    auto* sr = sumReal.data();
+    auto* si = sumImag.data();
+
+    for (size_t p = 0; p < numPartitions; ++p)
+    {
+        auto slot = (historyPosition + p) % numPartitions;
+        auto* xr = historyReal.data() + slot * numBins;
+        auto* xi = historyImag.data() + slot * numBins;
+        auto* hr = spectraReal.data() + p * numBins;
+        auto* hi = spectraImag.data() + p * numBins;
+
+        for (size_t bin = 0; bin < numBins; ++bin)
+        {
+            sr[bin] += xr[bin] * hr[bin] - xi[bin] * hi[bin];
+            si[bin] += xr[bin] * hi[bin] + xi[bin] * hr[bin];
+        }
+    }
+
+    for (size_t bin = 0; bin < numBins; ++bin)
+    {
+        scratch[2 * bin] = sr[bin];
+        scratch[2 * bin + 1] = si[bin];
+    }
+
+    fft.performRealOnlyInverseTransform (scratch.data());
+
+    std::copy (scratch.begin() + (int) blockSize, scratch.begin() + (int) (2 * blockSize), outputBuffer.begin());
+    std::copy (inputBuffer.begin() + (int) blockSize, inputBuffer.end(), inputBuffer.begin());
+}
+
+float FIR::PartitionedConvolutionEngine::processSample (float input, const float* coefficients) noexcept
+{
+    inputBuffer[blockSize + fill] = input;
+    auto output = outputBuffer[fill];
+
+    if (++fill == blockSize)
+    {
+        processBlock (coefficients);
+        fill = 0;
+    }
+
+    return output;
+}
+
+void FIR::PartitionedConvolutionEngine::process (const float* input, float* output, size_t numSamples,
+                                                 const float* coefficients) noexcept
+{
+    for (size_t done = 0; done < numSamples;)
+    {
+        auto num = jmin (numSamples - done, blockSize - fill);
+
+        // the input is read before the output is written, so they can be the same buffer
+        std::copy (input + done, input + done + num, inputBuffer.begin() + (int) (blockSize + fill));
+
+        if (output != nullptr)
+            std::copy (outputBuffer.begin() + (int) fill, outputBuffer.begin() + (int) (fill + num), output + done);
+
+        fill += num;
+        done += num;
+
+        if (fill == blockSize)
+        {
+            processBlock (coefficients);
+            fill = 0;
+        }
+    }
+}
+
 //==============================================================================
 template struct FIR::Coefficients<float>;
 template struct FIR::Coefficients<double>;
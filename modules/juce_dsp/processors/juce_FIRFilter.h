@@ -36,6 +36,55 @@ namespace FIR
     template <typename NumericType>
     struct Coefficients;
 
+   #ifndef DOXYGEN
+    /*  The uniformly-partitioned FFT convolution that a Filter<float> uses for long
+        kernels. This is an internal class - use Filter::setFFTConvolutionThreshold().
+
+        When the coefficients change during processing, the spectra of the new kernel
+        are worked out on a shared background thread, and swapped in at the start of
+        the first partition after they're ready.
+    */
+    class PartitionedConvolutionEngine  : private TimeSliceClient
+    {
+    public:
+        PartitionedConvolutionEngine (const float* coefficients, size_t numCoefficients, size_t partitionSize);
+        ~PartitionedConvolutionEngine() override;
+
+        /** Clears the filter's history, and brings the kernel up to date with the given
+            coefficients. This may block, so don't call it from the audio thread.
+        */
+        void reset (const float* coefficients) noexcept;
+
+        /** Filters a block of samples. If the output is null, the input is added to the
+            filter's history without producing any output.
+        */
+        void process (const float* input, float* output, size_t numSamples, const float* coefficients) noexcept;
+        float processSample (float input, const float* coefficients) noexcept;
+
+        size_t getNumCoefficients() const noexcept     { return numCoefficients; }
+        size_t getLatencyInSamples() const noexcept    { return blockSize; }
+
+    private:
+        struct KernelUpdateThread;
+        enum KernelState { idle, requested, computing, ready };
+
+        int useTimeSlice() override;
+        bool cancelKernelUpdate() noexcept;
+        void calculateSpectra (std::vector<float>& real, std::vector<float>& imag, std::vector<float>& workspace) const noexcept;
+        void processBlock (const float* coefficients) noexcept;
+
+        size_t numCoefficients, blockSize, numPartitions, numBins, historyPosition = 0, fill = 0;
+        FFT fft;
+        std::vector<float> currentCoefficients, spectraReal, spectraImag, historyReal, historyImag,
+                           sumReal, sumImag, scratch, inputBuffer, outputBuffer,
+                           pendingReal, pendingImag, kernelScratch;
+        std::atomic<int> kernelState { idle };
+        SharedResourcePointer<KernelUpdateThread> kernelUpdateThread;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolutionEngine)
+    };
+   #endif
+
     //==============================================================================
     /**
         A processing class that can perform FIR filtering on an audio signal, in the
@@ -44,7 +93,8 @@ namespace FIR
         Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
         samples. For longer filters, it might be more efficient to use the class
         Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        thanks to FFT, or to call setFFTConvolutionThreshold() so that a Filter<float>
+        switches to an FFT convolution itself when its coefficients are long enough.
 
         @see FIRFilter::Coefficients, Convolution, FFT
 
@@ -105,9 +155,47 @@ namespace FIR
 
                 for (size_t i = 0; i < size; ++i)
                     fifo[i] = SampleType {0};
+
+                updateConvolutionEngine();
             }
         }
 
+        //==============================================================================
+        /** Makes the filter switch to a partitioned FFT convolution whenever its
+            coefficients have more than a given number of taps.
+
+            For long filters, convolving in the frequency domain is far cheaper than the
+            direct method, but it works on blocks of partitionSize samples, so it delays
+            the output by that many samples (see getLatencyInSamples()). The partition size
+            will be rounded up to a power of two.
+
+            Pass 0 as the number of taps to always use the direct method, which is the
+            default. This only has an effect on a Filter<float>, and may allocate memory,
+            so call it before prepare() rather than from the audio thread.
+
+            If the coefficients change while the FFT convolution is running, the new kernel
+            is prepared on a background thread, so the old one carries on being used for a
+            few blocks. Calling reset() brings it up to date straight away.
+        */
+        void setFFTConvolutionThreshold (size_t minimumNumTaps, size_t partitionSize = 256)
+        {
+            fftThreshold = minimumNumTaps;
+            fftPartitionSize = partitionSize;
+            engine.reset();
+            reset();
+        }
+
+        /** Returns the number of samples of latency that the filter is adding on top of
+            the delay of the FIR kernel itself. This will be zero unless the filter is
+            using an FFT convolution.
+
+            @see setFFTConvolutionThreshold
+        */
+        size_t getLatencyInSamples() const noexcept
+        {
+            return engine != nullptr ? engine->getLatencyInSamples() : 0;
+        }
+
         //==============================================================================
         /** The coefficients of the FIR filter. It's up to the caller to ensure that
             these coefficients are modified in a thread-safe way.
@@ -139,6 +227,25 @@ namespace FIR
             auto* dst = outputBlock.getChannelPointer (0);
 
             auto* fir = coefficients->getRawCoefficients();
+
+            if (engine != nullptr)
+            {
+                if (context.isBypassed)
+                {
+                    // keep the filter's history up to date, so that it doesn't click when un-bypassed
+                    processWithEngine (*engine, src, static_cast<SampleType*> (nullptr), numSamples, fir);
+
+                    if (src != dst)
+                        std::copy (src, src + numSamples, dst);
+                }
+                else
+                {
+                    processWithEngine (*engine, src, dst, numSamples, fir);
+                }
+
+                return;
+            }
+
             size_t p = pos;
 
             if (context.isBypassed)
@@ -165,6 +272,10 @@ namespace FIR
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             check();
+
+            if (engine != nullptr)
+                return processSampleWithEngine (*engine, sample, coefficients->getRawCoefficients());
+
             return processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
         }
 
@@ -172,7 +283,8 @@ namespace FIR
         //==============================================================================
         HeapBlock<SampleType> memory;
         SampleType* fifo = nullptr;
-        size_t pos = 0, size = 0;
+        size_t pos = 0, size = 0, fftThreshold = 0, fftPartitionSize = 256;
+        std::unique_ptr<PartitionedConvolutionEngine> engine;
 
         //==============================================================================
         void check()
@@ -202,6 +314,65 @@ namespace FIR
             return out;
         }
 
+        //==============================================================================
+        // The FFT convolution is only available for single-precision, non-vector filters
+        void updateConvolutionEngine()
+        {
+            if (! std::is_same<SampleType, float>::value || fftThreshold == 0 || size <= fftThreshold)
+                engine.reset();
+            else if (engine != nullptr && engine->getNumCoefficients() == size)
+                resetEngine (*engine, coefficients->getRawCoefficients());
+            else
+                engine = createEngine (coefficients->getRawCoefficients(), size, fftPartitionSize);
+        }
+
+        static std::unique_ptr<PartitionedConvolutionEngine> createEngine (const float* fir, size_t numTaps, size_t partitionSize)
+        {
+            return std::make_unique<PartitionedConvolutionEngine> (fir, numTaps, partitionSize);
+        }
+
+        template <typename OtherType>
+        static std::unique_ptr<PartitionedConvolutionEngine> createEngine (const OtherType*, size_t, size_t)
+        {
+            return {};
+        }
+
+        static void resetEngine (PartitionedConvolutionEngine& e, const float* fir) noexcept
+        {
+            e.reset (fir);
+        }
+
+        template <typename OtherType>
+        static void resetEngine (PartitionedConvolutionEngine&, const OtherType*) noexcept
+        {
+            jassertfalse;
+        }
+
+        static void processWithEngine (PartitionedConvolutionEngine& e, const float* src, float* dst,
+                                       size_t numSamples, const float* fir) noexcept
+        {
+            e.process (src, dst, numSamples, fir);
+        }
+
+        template <typename OtherType, typename OtherNumericType>
+        static void processWithEngine (PartitionedConvolutionEngine&, const OtherType*, OtherType*,
+                                       size_t, const OtherNumericType*) noexcept
+        {
+            jassertfalse;
+        }
+
+        static float processSampleWithEngine (PartitionedConvolutionEngine& e, float sample, const float* fir) noexcept
+        {
+            return e.processSample (sample, fir);
+        }
+
+        template <typename OtherType, typename OtherNumericType>
+        static OtherType processSampleWithEngine (PartitionedConvolutionEngine&, OtherType sample, const OtherNumericType*) noexcept
+        {
+            jassertfalse;
+            return sample;
+        }
+
 
         JUCE_LEAK_DETECTOR (Filter)
     };
@@ -202,6 +202,116 @@ class FIRFilterTest : public UnitTest
        #endif
     }
 
+    //==============================================================================
+    template <typename TheTest>
+    void runFFTConvolutionTest()
+    {
+        Random random (8392829);
+
+        for (auto size : {700, 1537})
+        {
+            constexpr size_t n = 3001, partitionSize = 128;
+
+            std::vector<float> input (n), output (n), ref (n), fir ((size_t) size);
+            fillRandom (random, input.data(), n);
+            fillRandom (random, fir.data(), fir.size());
+
+            FIR::Filter<float> filter (*new FIR::Coefficients<float> (fir.data(), fir.size()));
+            filter.setFFTConvolutionThreshold (512, partitionSize);
+            filter.prepare ({ 0.0, n, 1 });
+
+            expectEquals ((int) filter.getLatencyInSamples(), (int) partitionSize);
+
+            reference<float, float> (fir.data(), fir.size(), input.data(), ref.data(), n);
+            TheTest::template run<float> (filter, input.data(), output.data(), n);
+
+            float maxError = 0.0f;
+
+            for (size_t i = 0; i < partitionSize; ++i)
+                maxError = jmax (maxError, std::abs (output[i]));
+
+            for (size_t i = partitionSize; i < n; ++i)
+                maxError = jmax (maxError, std::abs (output[i] - ref[i - partitionSize]));
+
+            expectLessThan (maxError, 1e-3f);
+        }
+    }
+
+    //==============================================================================
+    void runFFTCoefficientChangeTest()
+    {
+        Random random (8392829);
+
+        constexpr size_t numTaps = 700, partitionSize = 128, numBlocks = 100, n = numBlocks * partitionSize;
+
+        std::vector<float> input (n), output (partitionSize), firA (numTaps), firB (numTaps), refA (n), refB (n);
+        fillRandom (random, input.data(), n);
+        fillRandom (random, firA.data(), numTaps);
+        fillRandom (random, firB.data(), numTaps);
+
+        reference<float, float> (firA.data(), numTaps, input.data(), refA.data(), n);
+        reference<float, float> (firB.data(), numTaps, input.data(), refB.data(), n);
+
+        FIR::Filter<float> filter (*new FIR::Coefficients<float> (firA.data(), numTaps));
+        filter.setFFTConvolutionThreshold (512, partitionSize);
+        filter.prepare ({ 0.0, partitionSize, 1 });
+
+        // the output of each block is the convolution of the previous one
+        auto blockMatches = [&] (const std::vector<float>& ref, size_t block)
+        {
+            for (size_t i = 0; i < partitionSize; ++i)
+                if (std::abs (output[i] - ref[(block - 1) * partitionSize + i]) > 1e-3f)
+                    return false;
+
+            return true;
+        };
+
+        constexpr size_t changeBlock = 10;
+        size_t firstNewBlock = 0;
+        bool allMatch = true;
+
+        for (size_t block = 0; block < numBlocks; ++block)
+        {
+            if (block == changeBlock)
+                std::copy (firB.begin(), firB.end(), filter.coefficients->getRawCoefficients());
+
+            auto* src = input.data() + block * partitionSize;
+            auto* dst = output.data();
+            AudioBlock<const float> inBlock (&src, 1, partitionSize);
+            AudioBlock<float> outBlock (&dst, 1, partitionSize);
+            filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+            if (block == 0)
+                continue;
+
+            if (firstNewBlock == 0 && block > changeBlock + 1 && blockMatches (refB, block))
+                firstNewBlock = block;
+
+            // the kernel is switched over between two blocks, and never recomputed on this thread
+            allMatch = allMatch && blockMatches (firstNewBlock == 0 ? refA : refB, block);
+
+            if (block > changeBlock)
+                Thread::sleep (10);
+        }
+
+        expect (firstNewBlock != 0);
+        expect (allMatch);
+
+        // a reset picks up the new kernel without waiting
+        std::copy (firA.begin(), firA.end(), filter.coefficients->getRawCoefficients());
+        filter.reset();
+
+        for (size_t block = 0; block < 2; ++block)
+        {
+            auto* src = input.data() + block * partitionSize;
+            auto* dst = output.data();
+            AudioBlock<const float> inBlock (&src, 1, partitionSize);
+            AudioBlock<float> outBlock (&dst, 1, partitionSize);
+            filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+        }
+
+        expect (blockMatches (refA, 1));
+    }
 
 public:
     FIRFilterTest()
@@ -213,6 +323,64 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+
+        beginTest ("FFT convolution");
+        runFFTConvolutionTest<LargeBlockTest>();
+        runFFTConvolutionTest<SampleBySampleTest>();
+        runFFTConvolutionTest<SplitBlockTest>();
+
+        beginTest ("FFT convolution is only used above the threshold");
+        {
+            std::vector<float> fir (300, 0.5f);
+            FIR::Filter<float> filter (*new FIR::Coefficients<float> (fir.data(), fir.size()));
+            filter.setFFTConvolutionThreshold (512);
+            filter.prepare ({ 44100.0, 512, 1 });
+            expectEquals ((int) filter.getLatencyInSamples(), 0);
+
+            FIR::Filter<double> doubleFilter;
+            doubleFilter.setFFTConvolutionThreshold (1);
+            doubleFilter.coefficients = *new FIR::Coefficients<double> (1024);
+            doubleFilter.prepare ({ 44100.0, 512, 1 });
+            expectEquals ((int) doubleFilter.getLatencyInSamples(), 0);
+        }
+
+       #if JUCE_USE_SIMD
+        beginTest ("FFT convolution isn't used by vector filters");
+        {
+            constexpr size_t numTaps = 700, n = 1000;
+
+            HeapBlock<char> inputBuffer, outputBuffer, refBuffer, firBuffer;
+            AudioBlock<SIMDRegister<float>> input (inputBuffer, 1, n), output (outputBuffer, 1, n), ref (refBuffer, 1, n);
+            AudioBlock<float> fir (firBuffer, 1, numTaps);
+
+            Random random (8392829);
+            fillRandom (random, input.getChannelPointer (0), n);
+            fillRandom (random, fir.getChannelPointer (0), numTaps);
+
+            FIR::Filter<SIMDRegister<float>> filter (*new FIR::Coefficients<float> (fir.getChannelPointer (0), numTaps));
+            filter.setFFTConvolutionThreshold (512, 128);
+            filter.prepare ({ 44100.0, (uint32) n, 1 });
+
+            expectEquals ((int) filter.getLatencyInSamples(), 0);
+
+            reference<SIMDRegister<float>, float> (fir.getChannelPointer (0), numTaps,
+                                                   input.getChannelPointer (0), ref.getChannelPointer (0), n);
+
+            LargeBlockTest::run<SIMDRegister<float>> (filter, input.getChannelPointer (0), output.getChannelPointer (0), n);
+
+            float maxError = 0.0f;
+            auto* out = reinterpret_cast<float*> (output.getChannelPointer (0));
+            auto* expected = reinterpret_cast<float*> (ref.getChannelPointer (0));
+
+            for (size_t i = 0; i < n * SIMDRegister<float>::size(); ++i)
+                maxError = jmax (maxError, std::abs (out[i] - expected[i]));
+
+            expectLessThan (maxError, 1e-3f);
+        }
+       #endif
+
+        beginTest ("FFT convolution prepares new coefficients in the background");
+        runFFTCoefficientChangeTest();
     }
 };
 
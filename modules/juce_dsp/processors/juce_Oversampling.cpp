@@ -104,152 +104,282 @@ struct OversamplingDummy   : public Oversampling<SampleType>::OversamplingStage
 };
 
 //==============================================================================
-/** Oversampling stage class performing 2 times oversampling using the Filter
-    Design FIR Equiripple method. The resulting filter is linear phase,
-    symmetric, and has every two samples but the middle one equal to zero,
-    leading to specific processing optimizations.
+/** The polyphase kernel used by Oversampling2TimesEquirippleFIR.
+
+    Only every other coefficient of a half-band filter is nonzero (apart from the
+    middle one), and the kernel is symmetric, so each output only needs one multiply
+    for every four taps. The kernel keeps a copy of just those coefficients, and the
+    history of the input for each channel is kept in a circular buffer that's stored
+    twice over, so that the most recent samples can always be read as one contiguous
+    run without having to shift the buffer along for every sample.
+
+    The channels are processed in groups which are interleaved in memory, so that
+    when SIMD is available, each element of a SIMDRegister handles one channel. This
+    does exactly the same arithmetic for each channel as processing it on its own.
 */
 template <typename SampleType>
-struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::OversamplingStage
+struct HalfBandPolyphaseFIR
 {
-    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    HalfBandPolyphaseFIR (const FIR::Coefficients<SampleType>& coefficients, size_t numChannels)
+    {
+        auto* fir = coefficients.getRawCoefficients();
+        auto N = coefficients.getFilterOrder() + 1;
+        auto Ndiv2 = N / 2;
 
-    Oversampling2TimesEquirippleFIR (size_t numChans,
-                                     SampleType normalisedTransitionWidthUp,
-                                     SampleType stopbandAmplitudedBUp,
-                                     SampleType normalisedTransitionWidthDown,
-                                     SampleType stopbandAmplitudedBDown)
-        : ParentType (numChans, 2)
+        for (size_t k = 0; k < Ndiv2; k += 2)
+            taps.push_back (fir[k]);
+
+        centreTap = fir[Ndiv2];
+        filterOrder = coefficients.getFilterOrder();
+        historyLength = Ndiv2 + 1;
+        centreDelay = (Ndiv2 + 1) / 2;
+
+       #if JUCE_USE_SIMD
+        constexpr auto lanesPerRegister = SIMDRegister<SampleType>::size();
+       #else
+        constexpr size_t lanesPerRegister = 1;
+       #endif
+
+        for (size_t channel = 0; channel < numChannels;)
+        {
+            auto numLanes = numChannels - channel >= lanesPerRegister ? lanesPerRegister : (size_t) 1;
+            groups.push_back ({ channel, numLanes, history.size(), delayed.size(), 0, 0 });
+
+            history.resize (history.size() + historyLength * 2 * numLanes);
+            delayed.resize (delayed.size() + centreDelay * numLanes);
+            channel += numLanes;
+        }
+    }
+
+    size_t getFilterOrder() const noexcept     { return filterOrder; }
+
+    void reset()
     {
-        coefficientsUp   = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
-        coefficientsDown = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+        std::fill (history.begin(), history.end(), SampleType());
+        std::fill (delayed.begin(), delayed.end(), SampleType());
 
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (this->numChannels), static_cast<int> (N));
+        for (auto& group : groups)
+            group.historyPosition = group.delayPosition = 0;
+    }
 
-        N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
+    /** Filters the input, and writes pairs of output samples for each one. */
+    void processUp (const AudioBlock<const SampleType>& input, AudioBuffer<SampleType>& output)
+    {
+        for (auto& group : groups)
+        {
+           #if JUCE_USE_SIMD
+            if (group.numLanes > 1)
+            {
+                processUp<SIMDRegister<SampleType>> (group, input, output);
+                continue;
+            }
+           #endif
+
+            processUp<SampleType> (group, input, output);
+        }
+    }
 
-        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (N));
-        stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
+    /** Filters pairs of input samples, and writes one output sample for each pair. */
+    void processDown (const AudioBuffer<SampleType>& input, AudioBlock<SampleType>& output)
+    {
+        for (auto& group : groups)
+        {
+           #if JUCE_USE_SIMD
+            if (group.numLanes > 1)
+            {
+                processDown<SIMDRegister<SampleType>> (group, input, output);
+                continue;
+            }
+           #endif
 
-        position.resize (static_cast<int> (this->numChannels));
+            processDown<SampleType> (group, input, output);
+        }
     }
 
+private:
     //==============================================================================
-    SampleType getLatencyInSamples() const override
+    struct Group
     {
-        return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
+        size_t firstChannel, numLanes, historyOffset, delayOffset, historyPosition, delayPosition;
+    };
+
+    template <typename Vec>
+    static Vec load (const SampleType* source) noexcept          { return readUnaligned<Vec> (source); }
+
+    template <typename Vec>
+    static void store (SampleType* dest, Vec value) noexcept     { writeUnaligned (dest, value); }
+
+    // Adds a new sample for each lane to the front of the group's history
+    template <typename Vec>
+    SampleType* pushHistory (Group& group, Vec value) noexcept
+    {
+        constexpr auto numLanes = sizeof (Vec) / sizeof (SampleType);
+        auto* groupHistory = history.data() + group.historyOffset;
+
+        group.historyPosition = (group.historyPosition == 0 ? historyLength : group.historyPosition) - 1;
+        store (groupHistory + group.historyPosition * numLanes, value);
+        store (groupHistory + (group.historyPosition + historyLength) * numLanes, value);
+
+        return groupHistory + group.historyPosition * numLanes;
     }
 
-    void reset() override
+    // Convolves the kernel with a window of the history, where window[0] is the newest sample
+    template <typename Vec>
+    Vec convolve (const SampleType* window) const noexcept
     {
-        ParentType::reset();
+        constexpr auto numLanes = sizeof (Vec) / sizeof (SampleType);
+        auto last = historyLength - 1;
 
-        stateUp.clear();
-        stateDown.clear();
-        stateDown2.clear();
+        auto out = (load<Vec> (window + last * numLanes) + load<Vec> (window)) * taps[0];
 
-        position.fill (0);
+        for (size_t t = 1; t < taps.size(); ++t)
+            out = out + (load<Vec> (window + (last - t) * numLanes) + load<Vec> (window + t * numLanes)) * taps[t];
+
+        return out;
     }
 
-    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    template <typename Vec>
+    void processUp (Group& group, const AudioBlock<const SampleType>& input, AudioBuffer<SampleType>& output)
     {
-        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
-        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+        constexpr auto numLanes = sizeof (Vec) / sizeof (SampleType);
+        auto numChannels = jmin (numLanes, input.getNumChannels() - jmin (input.getNumChannels(), group.firstChannel));
 
-        // Initialization
-        auto fir = coefficientsUp.getRawCoefficients();
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto numSamples = inputBlock.getNumSamples();
+        if (numChannels == 0)
+            return;
 
-        // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        const SampleType* in[numLanes] = {};
+        SampleType* out[numLanes] = {};
+
+        for (size_t lane = 0; lane < numChannels; ++lane)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            in[lane]  = input.getChannelPointer (group.firstChannel + lane);
+            out[lane] = output.getWritePointer ((int) (group.firstChannel + lane));
+        }
 
-            for (size_t i = 0; i < numSamples; ++i)
-            {
-                // Input
-                buf[N - 1] = 2 * samples[i];
+        SampleType lanes[numLanes] = {}, evenLanes[numLanes], oddLanes[numLanes];
 
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
+        for (size_t i = 0; i < input.getNumSamples(); ++i)
+        {
+            for (size_t lane = 0; lane < numChannels; ++lane)
+                lanes[lane] = 2 * in[lane][i];
 
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+            auto* window = pushHistory (group, load<Vec> (lanes));
 
-                // Outputs
-                bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
+            store (evenLanes, convolve<Vec> (window));
+            store (oddLanes,  load<Vec> (window + ((historyLength - 2) / 2) * numLanes) * centreTap);
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+            for (size_t lane = 0; lane < numChannels; ++lane)
+            {
+                out[lane][i << 1]       = evenLanes[lane];
+                out[lane][(i << 1) + 1] = oddLanes[lane];
             }
         }
     }
 
-    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    template <typename Vec>
+    void processDown (Group& group, const AudioBuffer<SampleType>& input, AudioBlock<SampleType>& output)
     {
-        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
-        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+        constexpr auto numLanes = sizeof (Vec) / sizeof (SampleType);
+        auto numChannels = jmin (numLanes, output.getNumChannels() - jmin (output.getNumChannels(), group.firstChannel));
 
-        // Initialization
-        auto fir = coefficientsDown.getRawCoefficients();
-        auto N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
-        auto numSamples = outputBlock.getNumSamples();
+        if (numChannels == 0)
+            return;
 
-        // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        const SampleType* in[numLanes] = {};
+        SampleType* out[numLanes] = {};
+
+        for (size_t lane = 0; lane < numChannels; ++lane)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
-            auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto pos = position.getUnchecked (static_cast<int> (channel));
+            in[lane]  = input.getReadPointer ((int) (group.firstChannel + lane));
+            out[lane] = output.getChannelPointer (group.firstChannel + lane);
+        }
 
-            for (size_t i = 0; i < numSamples; ++i)
+        SampleType evenLanes[numLanes] = {}, oddLanes[numLanes] = {}, outLanes[numLanes];
+        auto* groupDelay = delayed.data() + group.delayOffset;
+
+        for (size_t i = 0; i < output.getNumSamples(); ++i)
+        {
+            for (size_t lane = 0; lane < numChannels; ++lane)
             {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
+                evenLanes[lane] = in[lane][i << 1];
+                oddLanes[lane]  = in[lane][(i << 1) + 1];
+            }
 
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
+            auto* window = pushHistory (group, load<Vec> (evenLanes));
+            auto* delayedOdd = groupDelay + group.delayPosition * numLanes;
 
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+            store (outLanes, convolve<Vec> (window) + load<Vec> (delayedOdd) * centreTap);
+            store (delayedOdd, load<Vec> (oddLanes));
 
-                // Output
-                out += buf2[pos] * fir[Ndiv2];
-                buf2[pos] = bufferSamples[(i << 1) + 1];
+            group.delayPosition = (group.delayPosition == 0 ? centreDelay : group.delayPosition) - 1;
 
-                samples[i] = out;
+            for (size_t lane = 0; lane < numChannels; ++lane)
+                out[lane][i] = outLanes[lane];
+        }
+    }
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; ++k)
-                    buf[k] = buf[k + 2];
+    //==============================================================================
+    std::vector<SampleType> taps, history, delayed;
+    std::vector<Group> groups;
+    SampleType centreTap = 0;
+    size_t filterOrder = 0, historyLength = 0, centreDelay = 0;
+};
 
-                // Circular buffer
-                pos = (pos == 0 ? Ndiv4 : pos - 1);
-            }
+//==============================================================================
+/** Oversampling stage class performing 2 times oversampling using the Filter
+    Design FIR Equiripple method. The resulting filter is linear phase,
+    symmetric, and has every two samples but the middle one equal to zero,
+    leading to specific processing optimizations.
+*/
+template <typename SampleType>
+struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::OversamplingStage
+{
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
 
-            position.setUnchecked (static_cast<int> (channel), pos);
-        }
+    Oversampling2TimesEquirippleFIR (size_t numChans,
+                                     SampleType normalisedTransitionWidthUp,
+                                     SampleType stopbandAmplitudedBUp,
+                                     SampleType normalisedTransitionWidthDown,
+                                     SampleType stopbandAmplitudedBDown)
+        : ParentType (numChans, 2),
+          filterUp   (*FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp),   numChans),
+          filterDown (*FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown), numChans)
+    {
+    }
+
+    //==============================================================================
+    SampleType getLatencyInSamples() const override
+    {
+        return static_cast<SampleType> (filterUp.getFilterOrder() + filterDown.getFilterOrder()) * 0.5f;
+    }
+
+    void reset() override
+    {
+        ParentType::reset();
+
+        filterUp.reset();
+        filterDown.reset();
+    }
+
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        filterUp.processUp (inputBlock, ParentType::buffer);
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
+        filterDown.processDown (ParentType::buffer, outputBlock);
     }
 
 private:
     //==============================================================================
-    FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
-    AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
-    Array<size_t> position;
+    HalfBandPolyphaseFIR<SampleType> filterUp, filterDown;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
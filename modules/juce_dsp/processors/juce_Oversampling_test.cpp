@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+template <typename SampleType>
+class OversamplingTests  : public UnitTest
+{
+public:
+    OversamplingTests()
+        : UnitTest ("Oversampling " + String (std::is_same<SampleType, float>::value ? "float" : "double"),
+                    UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The half-band FIR stage matches a direct convolution");
+
+        // (enough channels to use both the SIMD and scalar paths)
+        constexpr size_t numChannels = 7;
+        constexpr int blockSize = 100, numBlocks = 5;
+
+        const SampleType twUp = (SampleType) 0.05, dBUp = -90, twDown = (SampleType) 0.06, dBDown = -75;
+
+        Oversampling<SampleType> oversampling (numChannels);
+        oversampling.addOversamplingStage (Oversampling<SampleType>::filterHalfBandFIREquiripple,
+                                           (float) twUp, (float) dBUp, (float) twDown, (float) dBDown);
+        oversampling.initProcessing (blockSize);
+
+        auto up   = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (twUp, dBUp);
+        auto down = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (twDown, dBDown);
+
+        std::vector<std::vector<SampleType>> upStates, downStates;
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            upStates.emplace_back (up.getFilterOrder() + 1);
+            downStates.emplace_back (down.getFilterOrder() + 1);
+        }
+
+        AudioBuffer<SampleType> input ((int) numChannels, blockSize), output ((int) numChannels, blockSize);
+        std::vector<SampleType> expectedUp (blockSize * 2);
+        auto random = getRandom();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int ch = 0; ch < (int) numChannels; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    input.setSample (ch, i, (SampleType) (random.nextFloat() * 2.0f - 1.0f));
+
+            auto upBlock = oversampling.processSamplesUp (AudioBlock<const SampleType> (input));
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                auto* samples = input.getReadPointer ((int) ch);
+
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    auto x = (SampleType) 2 * samples[i];
+
+                    expectedUp[(size_t) i * 2]     = convolve (up, upStates[ch], x);
+                    expectedUp[(size_t) i * 2 + 1] = convolve (up, upStates[ch], (SampleType) 0);
+                }
+
+                for (size_t i = 0; i < expectedUp.size(); ++i)
+                    expectWithinAbsoluteError (upBlock.getSample ((int) ch, (int) i), expectedUp[i], (SampleType) 1.0e-6);
+            }
+
+            AudioBlock<SampleType> outBlock (output);
+            oversampling.processSamplesDown (outBlock);
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    auto expected = convolve (down, downStates[ch], upBlock.getSample ((int) ch, i * 2));
+                    convolve (down, downStates[ch], upBlock.getSample ((int) ch, i * 2 + 1));
+
+                    expectWithinAbsoluteError (output.getSample ((int) ch, i), expected, (SampleType) 1.0e-6);
+                }
+            }
+        }
+    }
+
+private:
+    // A plain FIR filter, which runs at the oversampled rate
+    static SampleType convolve (const FIR::Coefficients<SampleType>& coefficients, std::vector<SampleType>& state, SampleType input)
+    {
+        std::rotate (state.rbegin(), state.rbegin() + 1, state.rend());
+        state[0] = input;
+
+        auto* fir = coefficients.getRawCoefficients();
+        SampleType result = 0;
+
+        for (size_t i = 0; i < state.size(); ++i)
+            result += state[i] * fir[i];
+
+        return result;
+    }
+};
+
+static OversamplingTests<float>  oversamplingFloatTests;
+static OversamplingTests<double> oversamplingDoubleTests;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+template <typename FloatType>
+Wavetable<FloatType>::Wavetable (const std::function<FloatType (FloatType)>& function, size_t size)
+{
+    std::vector<FloatType> cycle (size);
+
+    for (size_t i = 0; i < size; ++i)
+        cycle[i] = function (MathConstants<FloatType>::twoPi * (FloatType) i / (FloatType) size
+                               - MathConstants<FloatType>::pi);
+
+    build (cycle.data(), size);
+}
+
+template <typename FloatType>
+Wavetable<FloatType>::Wavetable (const FloatType* singleCycle, size_t numSamples)
+{
+    build (singleCycle, numSamples);
+}
+
+template <typename FloatType>
+void Wavetable<FloatType>::build (const FloatType* singleCycle, size_t numSamples)
+{
+    // The table size must be a power of two!
+    jassert (isPowerOfTwo (numSamples) && numSamples >= 2);
+
+    auto order = (int) std::log2 ((double) numSamples);
+    tableSize = numSamples;
+    numLevels = (size_t) jmax (1, order);
+    data.resize (numLevels * (tableSize + 1));
+
+    FFT fft (order);
+    std::vector<float> spectrum (tableSize * 2), levelData (tableSize * 2);
+
+    for (size_t i = 0; i < tableSize; ++i)
+        spectrum[i] = (float) singleCycle[i];
+
+    fft.performRealOnlyForwardTransform (spectrum.data());
+
+    for (size_t level = 0; level < numLevels; ++level)
+    {
+        auto numHarmonics = getNumHarmonics (level);
+        std::copy (spectrum.begin(), spectrum.end(), levelData.begin());
+
+        // clear all the bins above the highest harmonic that this level can hold, along
+        // with their negative-frequency mirror images
+        for (auto bin = numHarmonics + 1; bin <= tableSize / 2; ++bin)
+        {
+            levelData[bin * 2] = levelData[bin * 2 + 1] = 0.0f;
+            levelData[(tableSize - bin) * 2] = levelData[(tableSize - bin) * 2 + 1] = 0.0f;
+        }
+
+        fft.performRealOnlyInverseTransform (levelData.data());
+
+        auto* dest = data.data() + level * (tableSize + 1);
+
+        for (size_t i = 0; i < tableSize; ++i)
+            dest[i] = (FloatType) levelData[i];
+
+        dest[tableSize] = dest[0];
+    }
+}
+
+//==============================================================================
+template class Wavetable<float>;
+template class Wavetable<double>;
+
+} // namespace dsp
+} // namespace juce
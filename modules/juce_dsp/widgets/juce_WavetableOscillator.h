@@ -0,0 +1,357 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A set of band-limited copies of a single-cycle waveform, for use with a
+    WavetableOscillator.
+
+    The waveform is stored as a series of mip levels, each containing half as many
+    harmonics as the one before it, which are built by removing the upper harmonics
+    with an FFT. An oscillator picks the level with the most harmonics that will
+    still fit below the Nyquist frequency at the pitch it's playing, so that it
+    won't alias.
+
+    Building a table is fairly expensive, but once built, it's read-only, so it can
+    be shared between any number of oscillators (e.g. all the voices of a Synthesiser)
+    using a std::shared_ptr.
+
+    @see WavetableOscillator
+
+    @tags{DSP}
+*/
+template <typename FloatType>
+class Wavetable
+{
+public:
+    //==============================================================================
+    /** Creates a wavetable by sampling a periodic function over the range -pi..pi
+        (the same convention as dsp::Oscillator uses).
+
+        The table size must be a power of two, and determines the highest harmonic
+        that can be represented (tableSize / 2).
+    */
+    Wavetable (const std::function<FloatType (FloatType)>& function, size_t tableSize = 2048);
+
+    /** Creates a wavetable from a single cycle of a waveform.
+
+        The number of samples must be a power of two.
+    */
+    Wavetable (const FloatType* singleCycle, size_t numSamples);
+
+    //==============================================================================
+    /** Returns the number of samples in each level of the table. */
+    size_t getTableSize() const noexcept                    { return tableSize; }
+
+    /** Returns the number of mip levels in the table. */
+    size_t getNumLevels() const noexcept                    { return numLevels; }
+
+    /** Returns the highest harmonic that's present in one of the mip levels. */
+    size_t getNumHarmonics (size_t level) const noexcept    { return (tableSize / 2) >> level; }
+
+    /** Returns the samples for one of the mip levels.
+
+        This contains getTableSize() + 1 samples, where the last one is a copy of the
+        first, so that it's safe to interpolate past the end of the cycle.
+    */
+    const FloatType* getLevel (size_t level) const noexcept
+    {
+        jassert (level < numLevels);
+        return data.data() + level * (tableSize + 1);
+    }
+
+    /** Returns the mip level that should be used to play the waveform at a given
+        frequency, expressed as the number of cycles per sample (i.e. frequency / sampleRate).
+    */
+    size_t getLevelForIncrement (FloatType cyclesPerSample) const noexcept
+    {
+        auto maxHarmonics = FloatType (0.5) / std::abs (cyclesPerSample);
+        size_t level = 0;
+
+        while (level < numLevels - 1 && (FloatType) getNumHarmonics (level) > maxHarmonics)
+            ++level;
+
+        return level;
+    }
+
+private:
+    //==============================================================================
+    void build (const FloatType* singleCycle, size_t numSamples);
+
+    size_t tableSize = 0, numLevels = 0;
+    std::vector<FloatType> data;
+
+    JUCE_LEAK_DETECTOR (Wavetable)
+};
+
+//==============================================================================
+/**
+    An oscillator which plays a band-limited Wavetable.
+
+    Unlike dsp::Oscillator, which calls a std::function for each sample, this just
+    reads from a precomputed table, picking the mip level that won't alias at the
+    current frequency and interpolating between its samples.
+
+    The SampleType can be a SIMDRegister, in which case each element of the register
+    is a separate oscillator with its own frequency and phase. That's handy for
+    things like unison voices, where several detuned copies of the same waveform are
+    mixed together. All of the elements read from the same table, and the
+    interpolation is done for all of them at once.
+
+    To use it in a polyphonic Synthesiser, build one Wavetable and give a pointer to
+    it to the oscillator in each voice:
+
+    @code
+    auto table = std::make_shared<dsp::Wavetable<float>> ([] (float x) { return x / MathConstants<float>::pi; });
+
+    for (auto* voice : voices)
+        voice->oscillator.setWavetable (table);
+    @endcode
+
+    @see Wavetable, Oscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class WavetableOscillator
+{
+public:
+    /** The NumericType is the underlying primitive type used by the SampleType (which
+        could be either a primitive or vector)
+    */
+    using NumericType = typename SampleTypeHelpers::ElementType<SampleType>::Type;
+
+    //==============================================================================
+    /** Creates an oscillator with no table. Call setWavetable before first use. */
+    WavetableOscillator() = default;
+
+    /** Creates an oscillator which plays the given table. */
+    explicit WavetableOscillator (std::shared_ptr<const Wavetable<NumericType>> tableToUse)
+    {
+        setWavetable (std::move (tableToUse));
+    }
+
+    /** Changes the table that the oscillator plays.
+        This doesn't reset the phase, so it can be called between blocks to switch waveforms.
+    */
+    void setWavetable (std::shared_ptr<const Wavetable<NumericType>> tableToUse)
+    {
+        auto phase = getPhase();
+        table = std::move (tableToUse);
+        updateIncrements();
+        setPhase (phase);
+    }
+
+    /** Returns the table that the oscillator is playing. */
+    const Wavetable<NumericType>* getWavetable() const noexcept     { return table.get(); }
+
+    /** Returns true if the oscillator has been given a table. */
+    bool isInitialised() const noexcept                             { return table != nullptr; }
+
+    //==============================================================================
+    /** Sets the frequency of the oscillator.
+        If the SampleType is a SIMDRegister, each element sets the frequency of one of the oscillators.
+    */
+    void setFrequency (SampleType newFrequency) noexcept
+    {
+        frequencies = toArray (newFrequency);
+        updateIncrements();
+    }
+
+    /** Returns the current frequency of the oscillator. */
+    SampleType getFrequency() const noexcept        { return fromArray (frequencies); }
+
+    /** Sets the phase of the oscillator, as a proportion of a cycle (0 to 1). */
+    void setPhase (SampleType newPhase) noexcept
+    {
+        auto newPhases = toArray (newPhase);
+
+        for (size_t i = 0; i < numLanes; ++i)
+            positions[i] = wrap ((newPhases[i] - std::floor (newPhases[i])) * (NumericType) getTableSize());
+    }
+
+    /** Returns the current phase of the oscillator, as a proportion of a cycle (0 to 1). */
+    SampleType getPhase() const noexcept
+    {
+        Lanes phases;
+
+        for (size_t i = 0; i < numLanes; ++i)
+            phases[i] = positions[i] / (NumericType) jmax ((size_t) 1, getTableSize());
+
+        return fromArray (phases);
+    }
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec) noexcept
+    {
+        sampleRate = static_cast<NumericType> (spec.sampleRate);
+        updateIncrements();
+        reset();
+    }
+
+    /** Resets the phase of the oscillator. */
+    void reset() noexcept
+    {
+        positions.fill (0);
+    }
+
+    //==============================================================================
+    /** Returns the result of processing a single sample. */
+    SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType input) noexcept
+    {
+        return input + getNextSample();
+    }
+
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        jassert (isInitialised());
+        auto&& outBlock = context.getOutputBlock();
+        auto&& inBlock  = context.getInputBlock();
+
+        auto len           = outBlock.getNumSamples();
+        auto numChannels   = outBlock.getNumChannels();
+        auto inputChannels = jmin (numChannels, inBlock.getNumChannels());
+
+        if (context.isBypassed)
+        {
+            skip (len);
+            outBlock.clear();
+            return;
+        }
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outBlock.copyFrom (inBlock);
+
+        for (size_t i = 0; i < len; ++i)
+        {
+            auto sample = getNextSample();
+            size_t ch = 0;
+
+            for (; ch < inputChannels; ++ch)
+                outBlock.getChannelPointer (ch)[i] += sample;
+
+            for (; ch < numChannels; ++ch)
+                outBlock.getChannelPointer (ch)[i] = sample;
+        }
+    }
+
+    /** Advances the oscillator by a number of samples without producing any output. */
+    void skip (size_t numSamples) noexcept
+    {
+        auto size = (NumericType) getTableSize();
+
+        for (size_t i = 0; i < numLanes; ++i)
+        {
+            auto newPosition = std::fmod (positions[i] + increments[i] * (NumericType) numSamples, size);
+            positions[i] = wrap (newPosition);
+        }
+    }
+
+private:
+    //==============================================================================
+    static constexpr size_t numLanes = sizeof (SampleType) / sizeof (NumericType);
+    using Lanes = std::array<NumericType, numLanes>;
+
+    static Lanes toArray (SampleType value) noexcept            { return readUnaligned<Lanes> (&value); }
+    static SampleType fromArray (const Lanes& lanes) noexcept   { return readUnaligned<SampleType> (lanes.data()); }
+
+    size_t getTableSize() const noexcept        { return table != nullptr ? table->getTableSize() : 0; }
+
+    NumericType wrap (NumericType position) const noexcept
+    {
+        auto size = (NumericType) getTableSize();
+
+        if (position >= size)
+            return position - size;
+
+        if (position < 0)
+        {
+            // (adding the size to a tiny negative number can round up to the size itself)
+            position += size;
+            return position < size ? position : 0;
+        }
+
+        return position;
+    }
+
+    SampleType getNextSample() noexcept
+    {
+        jassert (isInitialised());
+        Lanes first, second, fraction;
+
+        for (size_t i = 0; i < numLanes; ++i)
+        {
+            auto index = (size_t) positions[i];
+            fraction[i] = positions[i] - (NumericType) index;
+            first[i]  = levels[i][index];
+            second[i] = levels[i][index + 1];
+
+            positions[i] = wrap (positions[i] + increments[i]);
+        }
+
+        auto a = fromArray (first);
+        return a + fromArray (fraction) * (fromArray (second) - a);
+    }
+
+    void updateIncrements() noexcept
+    {
+        if (table == nullptr)
+            return;
+
+        auto size = (NumericType) table->getTableSize();
+
+        for (size_t i = 0; i < numLanes; ++i)
+        {
+            // (anything above the Nyquist frequency would alias whichever level it used)
+            auto cyclesPerSample = jlimit ((NumericType) -0.5, (NumericType) 0.5, frequencies[i] / sampleRate);
+
+            increments[i] = cyclesPerSample * size;
+            levels[i] = table->getLevel (table->getLevelForIncrement (cyclesPerSample));
+        }
+    }
+
+    //==============================================================================
+    std::shared_ptr<const Wavetable<NumericType>> table;
+    std::array<const NumericType*, numLanes> levels {};
+    Lanes frequencies = makeFilledLanes ((NumericType) 440), positions {}, increments {};
+    NumericType sampleRate = 48000.0;
+
+    static Lanes makeFilledLanes (NumericType value) noexcept
+    {
+        Lanes lanes;
+        lanes.fill (value);
+        return lanes;
+    }
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class WavetableOscillatorTests  : public UnitTest
+{
+public:
+    WavetableOscillatorTests()
+        : UnitTest ("WavetableOscillator", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        auto saw = std::make_shared<Wavetable<float>> ([] (float x) { return x / MathConstants<float>::pi; }, 256);
+
+        beginTest ("Mip levels are band-limited");
+        {
+            expectEquals ((int) saw->getNumLevels(), 8);
+
+            FFT fft (8);
+            std::vector<float> original (512), level (512);
+
+            for (size_t i = 0; i < 256; ++i)
+                original[i] = saw->getLevel (0)[i];
+
+            fft.performFrequencyOnlyForwardTransform (original.data(), true);
+
+            for (size_t l = 0; l < saw->getNumLevels(); ++l)
+            {
+                std::copy (saw->getLevel (l), saw->getLevel (l) + 256, level.begin());
+                fft.performFrequencyOnlyForwardTransform (level.data(), true);
+
+                for (size_t bin = 1; bin <= 128; ++bin)
+                {
+                    if (bin <= saw->getNumHarmonics (l))
+                        expectWithinAbsoluteError (level[bin], original[bin], 1.0e-3f);
+                    else
+                        expectWithinAbsoluteError (level[bin], 0.0f, 1.0e-3f);
+                }
+
+                expectEquals (saw->getLevel (l)[256], saw->getLevel (l)[0]);
+            }
+        }
+
+        beginTest ("Higher frequencies use levels with fewer harmonics");
+        {
+            for (auto frequency : { 20.0f, 440.0f, 2000.0f, 10000.0f, 23000.0f })
+            {
+                auto increment = frequency / 48000.0f;
+                auto level = saw->getLevelForIncrement (increment);
+
+                expect ((float) saw->getNumHarmonics (level) * increment <= 0.5f || level == saw->getNumLevels() - 1);
+                expect (level == 0 || (float) saw->getNumHarmonics (level - 1) * increment > 0.5f);
+            }
+        }
+
+        beginTest ("A sine table produces a sine wave");
+        {
+            WavetableOscillator<float> osc (std::make_shared<Wavetable<float>> ([] (float x) { return std::sin (x); }));
+            osc.prepare ({ 48000.0, 512, 1 });
+            osc.setFrequency (1000.0f);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto expected = std::sin (MathConstants<double>::twoPi * std::fmod (i * 1000.0 / 48000.0, 1.0) - MathConstants<double>::pi);
+                expectWithinAbsoluteError (osc.processSample (0.0f), (float) expected, 1.0e-4f);
+            }
+        }
+
+        beginTest ("Processing a block matches processing single samples");
+        {
+            WavetableOscillator<float> a (saw), b (saw);
+
+            for (auto* osc : { &a, &b })
+            {
+                osc->prepare ({ 44100.0, 256, 2 });
+                osc->setFrequency (3000.0f);
+                osc->setPhase (0.25f);
+            }
+
+            AudioBuffer<float> buffer (2, 256);
+            auto random = getRandom();
+
+            for (int i = 0; i < 256; ++i)
+                buffer.setSample (0, i, random.nextFloat());
+
+            buffer.copyFrom (1, 0, buffer, 0, 0, 256);
+
+            AudioBuffer<float> input (1, 256);
+            input.copyFrom (0, 0, buffer, 0, 0, 256);
+
+            AudioBlock<float> block (buffer);
+            a.process (ProcessContextReplacing<float> (block));
+
+            for (int i = 0; i < 256; ++i)
+            {
+                auto inputSample = input.getSample (0, i);
+                auto expected = b.processSample (inputSample);
+
+                expectEquals (buffer.getSample (0, i), expected);
+                expectEquals (buffer.getSample (1, i), expected);
+            }
+
+            expectWithinAbsoluteError (a.getPhase(), b.getPhase(), 1.0e-6f);
+        }
+
+       #if JUCE_USE_SIMD
+        beginTest ("Each element of a SIMDRegister is a separate oscillator");
+        {
+            using Register = SIMDRegister<float>;
+            constexpr auto numLanes = Register::size();
+
+            WavetableOscillator<Register> vectorOsc (saw);
+            std::vector<WavetableOscillator<float>> scalarOscs (numLanes, WavetableOscillator<float> (saw));
+
+            vectorOsc.prepare ({ 48000.0, 512, 1 });
+            alignas (sizeof (Register)) float frequencies[numLanes];
+            alignas (sizeof (Register)) float output[numLanes];
+
+            for (size_t i = 0; i < numLanes; ++i)
+            {
+                frequencies[i] = 100.0f + 1500.0f * (float) i;
+                scalarOscs[i].prepare ({ 48000.0, 512, 1 });
+                scalarOscs[i].setFrequency (frequencies[i]);
+            }
+
+            vectorOsc.setFrequency (Register::fromRawArray (frequencies));
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                vectorOsc.processSample (Register (0.0f)).copyToRawArray (output);
+
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                    expectEquals (output[lane], scalarOscs[lane].processSample (0.0f));
+            }
+        }
+       #endif
+    }
+};
+
+static WavetableOscillatorTests wavetableOscillatorTests;
+
+} // namespace dsp
+} // namespace juce
@@ -28,6 +28,8 @@ MessageManager::MessageManager() noexcept
 {
     if (JUCEApplicationBase::isStandaloneApp())
         Thread::setCurrentThreadName ("JUCE Message Thread");
+
+    JUCE_TRACE_THREAD_NAME ("JUCE Message Thread");
 }
 
 MessageManager::~MessageManager() noexcept
@@ -68,6 +70,8 @@ bool MessageManager::MessageBase::post()
 {
     auto* mm = MessageManager::instance;
 
+    JUCE_TRACE_FLOW_START ("messages", "Message", this);
+
     if (mm == nullptr || mm->quitMessagePosted.get() != 0 || ! postMessageToSystemQueue (this))
     {
         Ptr deleter (this); // (this will delete messages that were just created with a 0 ref count)
@@ -101,6 +101,9 @@ private:
             if (message == nullptr)
                 break;
 
+            JUCE_TRACE_SCOPE_IN_CATEGORY ("messages", "MessageManager dispatch");
+            JUCE_TRACE_FLOW_END ("messages", "Message", message.get());
+
             message->messageCallback();
         }
     }
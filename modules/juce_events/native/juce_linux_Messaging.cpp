@@ -37,6 +37,9 @@ public:
                                             {
                                                 while (auto msg = popNextMessage (fd))
                                                 {
+                                                    JUCE_TRACE_SCOPE_IN_CATEGORY ("messages", "MessageManager dispatch");
+                                                    JUCE_TRACE_FLOW_END ("messages", "Message", msg.get());
+
                                                     JUCE_TRY
                                                     {
                                                         msg->messageCallback();
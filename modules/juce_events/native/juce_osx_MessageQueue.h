@@ -74,6 +74,9 @@ private:
         if (nextMessage == nullptr)
             return false;
 
+        JUCE_TRACE_SCOPE_IN_CATEGORY ("messages", "MessageManager dispatch");
+        JUCE_TRACE_FLOW_END ("messages", "Message", nextMessage.get());
+
         JUCE_AUTORELEASEPOOL
         {
             JUCE_TRY
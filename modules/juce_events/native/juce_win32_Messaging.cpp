@@ -193,6 +193,9 @@ private:
 
     static void dispatchMessage (MessageManager::MessageBase* message)
     {
+        JUCE_TRACE_SCOPE_IN_CATEGORY ("messages", "MessageManager dispatch");
+        JUCE_TRACE_FLOW_END ("messages", "Message", message);
+
         JUCE_TRY
         {
             message->messageCallback();
@@ -110,6 +110,8 @@ public:
 
             const LockType::ScopedUnlockType ul (lock);
 
+            JUCE_TRACE_SCOPE_IN_CATEGORY ("timers", "Timer::timerCallback");
+
             JUCE_TRY
             {
                 timer->timerCallback();
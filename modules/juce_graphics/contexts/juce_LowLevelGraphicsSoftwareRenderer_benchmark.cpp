@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SoftwareRendererBenchmark  : public Benchmark
+{
+public:
+    SoftwareRendererBenchmark()
+        : Benchmark ("LowLevelGraphicsSoftwareRenderer", UnitTestCategories::graphics)
+    {}
+
+    void runBenchmark() override
+    {
+        constexpr int size = 512;
+        constexpr int numPixels = size * size;
+
+        Image image (Image::ARGB, size, size, true, SoftwareImageType());
+        LowLevelGraphicsSoftwareRenderer renderer (image);
+        Graphics g (renderer);
+
+        const auto bounds = image.getBounds().toFloat();
+
+        measure ("fill opaque rectangle", [&]
+        {
+            g.setColour (Colours::darkgrey);
+            g.fillRect (image.getBounds());
+        }, numPixels);
+
+        measure ("fill translucent rectangle", [&]
+        {
+            g.setColour (Colours::orange.withAlpha (0.5f));
+            g.fillRect (image.getBounds());
+        }, numPixels);
+
+        measure ("fill rectangle with linear gradient", [&]
+        {
+            g.setGradientFill (ColourGradient (Colours::red, {}, Colours::blue, bounds.getBottomRight(), false));
+            g.fillRect (image.getBounds());
+        }, numPixels);
+
+        measure ("fill rectangle with radial gradient", [&]
+        {
+            g.setGradientFill (ColourGradient (Colours::white, bounds.getCentre(), Colours::black, {}, true));
+            g.fillRect (image.getBounds());
+        }, numPixels);
+
+        measure ("fill ellipse", [&]
+        {
+            g.setColour (Colours::green);
+            g.fillEllipse (bounds.reduced (10.0f));
+        });
+
+        Path star;
+        star.addStar (bounds.getCentre(), 24, size * 0.2f, size * 0.45f, 0.3f);
+
+        measure ("fill path", [&]
+        {
+            g.setColour (Colours::yellow);
+            g.fillPath (star);
+        });
+
+        measure ("stroke path", [&]
+        {
+            g.setColour (Colours::cyan);
+            g.strokePath (star, PathStrokeType (4.0f, PathStrokeType::curved, PathStrokeType::rounded));
+        });
+
+        Image source (Image::ARGB, size / 2, size / 2, true, SoftwareImageType());
+
+        {
+            Graphics sg (source);
+            sg.setGradientFill (ColourGradient (Colours::transparentBlack, {}, Colours::magenta, { size / 2.0f, size / 2.0f }, false));
+            sg.fillAll();
+        }
+
+        measure ("draw image", [&]
+        {
+            g.drawImageAt (source, size / 4, size / 4);
+        }, numPixels / 4);
+
+        measure ("draw image with rotation and high quality resampling", [&]
+        {
+            const Graphics::ScopedSaveState state (g);
+            g.setImageResamplingQuality (Graphics::highResamplingQuality);
+            g.drawImageTransformed (source, AffineTransform::rotation (0.3f, size / 4.0f, size / 4.0f)
+                                                             .translated (size / 4.0f, size / 4.0f));
+        }, numPixels / 4);
+
+        doNotOptimise (image);
+    }
+};
+
+static SoftwareRendererBenchmark softwareRendererBenchmark;
+
+} // namespace juce
@@ -138,6 +138,10 @@
  #include "geometry/juce_Rectangle_test.cpp"
 #endif
 
+#if JUCE_BENCHMARKS
+ #include "contexts/juce_LowLevelGraphicsSoftwareRenderer_benchmark.cpp"
+#endif
+
 #if JUCE_USE_FREETYPE
  #include "native/juce_freetype_Fonts.cpp"
 #endif
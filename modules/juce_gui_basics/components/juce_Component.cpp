@@ -2060,6 +2060,8 @@ void Component::paintComponentAndChildren (Graphics& g)
 
 void Component::paintEntireComponent (Graphics& g, bool ignoreAlphaLevel)
 {
+    JUCE_TRACE_SCOPE_IN_CATEGORY ("gui", "Component::paintEntireComponent");
+
     // If sizing a top-level-window and the OS paint message is delivered synchronously
     // before resized() is called, then we'll invoke the callback here, to make sure
     // the components inside have had a chance to sort their sizes out..
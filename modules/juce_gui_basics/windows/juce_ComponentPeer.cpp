@@ -102,6 +102,8 @@ void ComponentPeer::handleMagnifyGesture (MouseInputSource::InputSourceType type
 //==============================================================================
 void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
 {
+    JUCE_TRACE_SCOPE_IN_CATEGORY ("gui", "ComponentPeer::handlePaint");
+
     Graphics g (contextToPaintTo);
 
     if (component.isTransformed())